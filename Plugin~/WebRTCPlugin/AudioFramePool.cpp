@@ -0,0 +1,51 @@
+#include "pch.h"
+
+#include "AudioFramePool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    AudioFramePool::AudioFramePool(size_t initialSize)
+    {
+        frames_.reserve(initialSize);
+        available_.reserve(initialSize);
+        for (size_t i = 0; i < initialSize; i++)
+            available_.push_back(Allocate());
+
+        // Frames allocated up front are not counted.
+        allocationCount_ = 0;
+    }
+
+    AudioFramePool::~AudioFramePool() { RTC_DCHECK_EQ(frames_.size(), available_.size()); }
+
+    AudioFrame* AudioFramePool::Acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (available_.empty())
+        {
+            AudioFrame* frame = Allocate();
+            available_.reserve(frames_.size());
+            return frame;
+        }
+        AudioFrame* frame = available_.back();
+        available_.pop_back();
+        return frame;
+    }
+
+    void AudioFramePool::Release(AudioFrame* frame)
+    {
+        RTC_DCHECK(frame);
+        std::lock_guard<std::mutex> lock(mutex_);
+        available_.push_back(frame);
+    }
+
+    AudioFrame* AudioFramePool::Allocate()
+    {
+        frames_.push_back(std::make_unique<AudioFrame>());
+        allocationCount_++;
+        return frames_.back().get();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
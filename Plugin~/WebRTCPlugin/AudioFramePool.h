@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <api/audio/audio_frame.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Keeps AudioFrame instances to reuse them on the audio thread. The pool
+    // grows when all frames are in use, which is counted as an allocation so
+    // that the steady state can be confirmed to be allocation-free.
+    class AudioFramePool
+    {
+    public:
+        explicit AudioFramePool(size_t initialSize);
+        AudioFramePool(const AudioFramePool&) = delete;
+        AudioFramePool& operator=(const AudioFramePool&) = delete;
+        ~AudioFramePool();
+
+        AudioFrame* Acquire();
+        void Release(AudioFrame* frame);
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return frames_.size();
+        }
+        size_t availableCount() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return available_.size();
+        }
+        uint64_t allocationCount() const { return allocationCount_; }
+
+    private:
+        AudioFrame* Allocate();
+
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<AudioFrame>> frames_;
+        std::vector<AudioFrame*> available_;
+        std::atomic<uint64_t> allocationCount_ { 0 };
+    };
+
+} // end namespace webrtc
+} // end namespace unity
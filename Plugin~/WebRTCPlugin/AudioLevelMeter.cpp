@@ -0,0 +1,67 @@
+#include "pch.h"
+
+#include <cmath>
+
+#include "AudioLevelMeter.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        constexpr float kS16FullScale = 32768.f;
+
+        float ToDbfs(float amplitude)
+        {
+            if (amplitude <= 0.f)
+                return AudioLevelMeter::kMinLevelDbfs;
+            return std::max(20.f * std::log10(amplitude / kS16FullScale), AudioLevelMeter::kMinLevelDbfs);
+        }
+    } // namespace
+
+    AudioLevelMeter::AudioLevelMeter()
+        : level_ { kMinLevelDbfs, kMinLevelDbfs, false }
+    {
+    }
+
+    void AudioLevelMeter::Process(const int16_t* data, size_t samplesPerChannel, size_t channels, int sampleRate)
+    {
+        RTC_DCHECK(data);
+        RTC_DCHECK(sampleRate);
+
+        const size_t length = samplesPerChannel * channels;
+        if (length == 0)
+            return;
+
+        int64_t sumSquares = 0;
+        int32_t peak = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            const int32_t sample = data[i];
+            sumSquares += sample * sample;
+            peak = std::max(peak, std::abs(sample));
+        }
+        const float rms = static_cast<float>(std::sqrt(static_cast<double>(sumSquares) / length));
+
+        AudioLevel level;
+        level.rmsDbfs = ToDbfs(rms);
+        level.peakDbfs = ToDbfs(static_cast<float>(peak));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (level.rmsDbfs >= kVoiceThresholdDbfs)
+            hangoverFrames_ = static_cast<size_t>(sampleRate) * kVoiceHangoverMs / 1000;
+        else
+            hangoverFrames_ -= std::min(hangoverFrames_, samplesPerChannel);
+        level.voiceActive = level.rmsDbfs >= kVoiceThresholdDbfs || hangoverFrames_ > 0;
+        level_ = level;
+    }
+
+    AudioLevel AudioLevelMeter::GetLevel() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return level_;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
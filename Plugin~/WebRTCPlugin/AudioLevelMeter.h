@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mutex>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Data format used by the managed code.
+    struct AudioLevel
+    {
+        float rmsDbfs;
+        float peakDbfs;
+        bool voiceActive;
+    };
+
+    // Measures the level of audio passing through a track, so that the managed
+    // code does not need to copy samples only to show a speaking indicator.
+    // Voice activity is estimated from the energy of the signal, and kept for
+    // a while after the level drops to avoid flickering between words.
+    class AudioLevelMeter
+    {
+    public:
+        // Same range as the audio level of RFC 6464.
+        static constexpr float kMinLevelDbfs = -127.f;
+        static constexpr float kVoiceThresholdDbfs = -45.f;
+        static constexpr int kVoiceHangoverMs = 200;
+
+        AudioLevelMeter();
+
+        void Process(const int16_t* data, size_t samplesPerChannel, size_t channels, int sampleRate);
+        AudioLevel GetLevel() const;
+
+    private:
+        mutable std::mutex mutex_;
+        AudioLevel level_;
+        size_t hangoverFrames_ = 0;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,266 @@
+#include "pch.h"
+
+#include <common_audio/include/audio_util.h>
+#include <system_wrappers/include/cpu_features_wrapper.h>
+
+#include "AudioSampleConverter.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AUDIO_CONVERTER_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AUDIO_CONVERTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+// AVX2 kernels are compiled for the target without changing the compile
+// options of the whole library, and only called after a runtime check.
+#if defined(__clang__) || defined(__GNUC__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        constexpr float kS16Scale = 32768.f;
+        constexpr float kS16Max = 32767.f;
+        constexpr float kS16Min = -32768.f;
+        constexpr float kS16ToFloatScale = 1.f / 32768.f;
+
+        void FloatToS16Scalar(const float* src, size_t size, int16_t* dst)
+        {
+            for (size_t i = 0; i < size; i++)
+                dst[i] = ::webrtc::FloatToS16(src[i]);
+        }
+
+        void S16ToFloatScalar(const int16_t* src, size_t size, float* dst)
+        {
+            for (size_t i = 0; i < size; i++)
+                dst[i] = ::webrtc::S16ToFloat(src[i]);
+        }
+
+#if defined(AUDIO_CONVERTER_X86)
+        // Scales and clamps like the scalar version, then rounds half away from
+        // zero by adding 0.5 with the sign of the sample before truncating.
+        inline __m128i FloatToS32SSE2(__m128 v)
+        {
+            const __m128 signMask = _mm_set1_ps(-0.f);
+            v = _mm_mul_ps(v, _mm_set1_ps(kS16Scale));
+            v = _mm_min_ps(v, _mm_set1_ps(kS16Max));
+            v = _mm_max_ps(v, _mm_set1_ps(kS16Min));
+            const __m128 half = _mm_or_ps(_mm_and_ps(v, signMask), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(_mm_add_ps(v, half));
+        }
+
+        void FloatToS16SSE2(const float* src, size_t size, int16_t* dst)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                const __m128i lo = FloatToS32SSE2(_mm_loadu_ps(src + i));
+                const __m128i hi = FloatToS32SSE2(_mm_loadu_ps(src + i + 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+            }
+            FloatToS16Scalar(src + i, size - i, dst + i);
+        }
+
+        void S16ToFloatSSE2(const int16_t* src, size_t size, float* dst)
+        {
+            const __m128 scale = _mm_set1_ps(kS16ToFloatScale);
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                // Sign-extend by moving each sample to the upper half and shifting back.
+                const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+                _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+            }
+            S16ToFloatScalar(src + i, size - i, dst + i);
+        }
+
+        TARGET_AVX2 inline __m256i FloatToS32AVX2(__m256 v)
+        {
+            const __m256 signMask = _mm256_set1_ps(-0.f);
+            v = _mm256_mul_ps(v, _mm256_set1_ps(kS16Scale));
+            v = _mm256_min_ps(v, _mm256_set1_ps(kS16Max));
+            v = _mm256_max_ps(v, _mm256_set1_ps(kS16Min));
+            const __m256 half = _mm256_or_ps(_mm256_and_ps(v, signMask), _mm256_set1_ps(0.5f));
+            return _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+        }
+
+        TARGET_AVX2 void FloatToS16AVX2(const float* src, size_t size, int16_t* dst)
+        {
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m256i lo = FloatToS32AVX2(_mm256_loadu_ps(src + i));
+                const __m256i hi = FloatToS32AVX2(_mm256_loadu_ps(src + i + 8));
+                // `packs` works per 128-bit lane, so restore the sample order afterwards.
+                const __m256i packed = _mm256_packs_epi32(lo, hi);
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            FloatToS16SSE2(src + i, size - i, dst + i);
+        }
+
+        TARGET_AVX2 void S16ToFloatAVX2(const int16_t* src, size_t size, float* dst)
+        {
+            const __m256 scale = _mm256_set1_ps(kS16ToFloatScale);
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v));
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(f, scale));
+            }
+            S16ToFloatScalar(src + i, size - i, dst + i);
+        }
+#endif
+
+#if defined(AUDIO_CONVERTER_NEON)
+        inline int32x4_t FloatToS32NEON(float32x4_t v)
+        {
+            const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+            v = vmulq_n_f32(v, kS16Scale);
+            v = vminq_f32(v, vdupq_n_f32(kS16Max));
+            v = vmaxq_f32(v, vdupq_n_f32(kS16Min));
+            const uint32x4_t half = vorrq_u32(
+                vandq_u32(vreinterpretq_u32_f32(v), signMask), vreinterpretq_u32_f32(vdupq_n_f32(0.5f)));
+            // vcvtq_s32_f32 truncates toward zero like the scalar cast.
+            return vcvtq_s32_f32(vaddq_f32(v, vreinterpretq_f32_u32(half)));
+        }
+
+        void FloatToS16NEON(const float* src, size_t size, int16_t* dst)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                const int16x4_t lo = vqmovn_s32(FloatToS32NEON(vld1q_f32(src + i)));
+                const int16x4_t hi = vqmovn_s32(FloatToS32NEON(vld1q_f32(src + i + 4)));
+                vst1q_s16(dst + i, vcombine_s16(lo, hi));
+            }
+            FloatToS16Scalar(src + i, size - i, dst + i);
+        }
+
+        void S16ToFloatNEON(const int16_t* src, size_t size, float* dst)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                const int16x8_t v = vld1q_s16(src + i);
+                const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+                const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+                vst1q_f32(dst + i, vmulq_n_f32(lo, kS16ToFloatScale));
+                vst1q_f32(dst + i + 4, vmulq_n_f32(hi, kS16ToFloatScale));
+            }
+            S16ToFloatScalar(src + i, size - i, dst + i);
+        }
+#endif
+
+        AudioSampleConverterKernel DetectKernel()
+        {
+#if defined(AUDIO_CONVERTER_X86)
+            if (::webrtc::GetCPUInfo(::webrtc::kAVX2))
+                return AudioSampleConverterKernel::AVX2;
+            if (::webrtc::GetCPUInfo(::webrtc::kSSE2))
+                return AudioSampleConverterKernel::SSE2;
+#elif defined(AUDIO_CONVERTER_NEON)
+            return AudioSampleConverterKernel::NEON;
+#endif
+            return AudioSampleConverterKernel::Scalar;
+        }
+    } // namespace
+
+    AudioSampleConverterKernel GetAudioSampleConverterKernel()
+    {
+        static const AudioSampleConverterKernel kernel = DetectKernel();
+        return kernel;
+    }
+
+    bool IsAudioSampleConverterKernelSupported(AudioSampleConverterKernel kernel)
+    {
+        switch (kernel)
+        {
+        case AudioSampleConverterKernel::Scalar:
+            return true;
+#if defined(AUDIO_CONVERTER_X86)
+        case AudioSampleConverterKernel::SSE2:
+            return ::webrtc::GetCPUInfo(::webrtc::kSSE2) != 0;
+        case AudioSampleConverterKernel::AVX2:
+            return ::webrtc::GetCPUInfo(::webrtc::kAVX2) != 0;
+#elif defined(AUDIO_CONVERTER_NEON)
+        case AudioSampleConverterKernel::NEON:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    void ConvertFloatToS16(const float* src, size_t size, int16_t* dst)
+    {
+        ConvertFloatToS16(GetAudioSampleConverterKernel(), src, size, dst);
+    }
+
+    void ConvertFloatToS16(AudioSampleConverterKernel kernel, const float* src, size_t size, int16_t* dst)
+    {
+        RTC_DCHECK(IsAudioSampleConverterKernelSupported(kernel));
+
+        switch (kernel)
+        {
+#if defined(AUDIO_CONVERTER_X86)
+        case AudioSampleConverterKernel::SSE2:
+            FloatToS16SSE2(src, size, dst);
+            return;
+        case AudioSampleConverterKernel::AVX2:
+            FloatToS16AVX2(src, size, dst);
+            return;
+#elif defined(AUDIO_CONVERTER_NEON)
+        case AudioSampleConverterKernel::NEON:
+            FloatToS16NEON(src, size, dst);
+            return;
+#endif
+        default:
+            FloatToS16Scalar(src, size, dst);
+            return;
+        }
+    }
+
+    void ConvertS16ToFloat(const int16_t* src, size_t size, float* dst)
+    {
+        ConvertS16ToFloat(GetAudioSampleConverterKernel(), src, size, dst);
+    }
+
+    void ConvertS16ToFloat(AudioSampleConverterKernel kernel, const int16_t* src, size_t size, float* dst)
+    {
+        RTC_DCHECK(IsAudioSampleConverterKernelSupported(kernel));
+
+        switch (kernel)
+        {
+#if defined(AUDIO_CONVERTER_X86)
+        case AudioSampleConverterKernel::SSE2:
+            S16ToFloatSSE2(src, size, dst);
+            return;
+        case AudioSampleConverterKernel::AVX2:
+            S16ToFloatAVX2(src, size, dst);
+            return;
+#elif defined(AUDIO_CONVERTER_NEON)
+        case AudioSampleConverterKernel::NEON:
+            S16ToFloatNEON(src, size, dst);
+            return;
+#endif
+        default:
+            S16ToFloatScalar(src, size, dst);
+            return;
+        }
+    }
+
+} // end namespace webrtc
+} // end namespace unity
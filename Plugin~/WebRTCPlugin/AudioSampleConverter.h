@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace unity
+{
+namespace webrtc
+{
+    enum class AudioSampleConverterKernel
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        NEON
+    };
+
+    // Returns the fastest kernel supported by the running CPU. The result is
+    // detected once and cached.
+    AudioSampleConverterKernel GetAudioSampleConverterKernel();
+    bool IsAudioSampleConverterKernelSupported(AudioSampleConverterKernel kernel);
+
+    // Converts float samples in [-1, 1] to S16 with saturation. Each sample is
+    // rounded exactly as `webrtc::FloatToS16` does.
+    void ConvertFloatToS16(const float* src, size_t size, int16_t* dst);
+    void ConvertFloatToS16(AudioSampleConverterKernel kernel, const float* src, size_t size, int16_t* dst);
+
+    // Converts S16 samples to float samples in [-1, 1) exactly as
+    // `webrtc::S16ToFloat` does.
+    void ConvertS16ToFloat(const int16_t* src, size_t size, float* dst);
+    void ConvertS16ToFloat(AudioSampleConverterKernel kernel, const int16_t* src, size_t size, float* dst);
+
+} // end namespace webrtc
+} // end namespace unity
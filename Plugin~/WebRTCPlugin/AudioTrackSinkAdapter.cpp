@@ -1,8 +1,9 @@
 #include "pch.h"
 
 #include <audio/remix_resample.h>
-#include <common_audio/include/audio_util.h>
+#include <rtc_base/event.h>
 
+#include "AudioSampleConverter.h"
 #include "AudioTrackSinkAdapter.h"
 
 namespace unity
@@ -11,10 +12,35 @@ namespace webrtc
 {
     AudioTrackSinkAdapter::AudioTrackSinkAdapter()
         : _buffer(nullptr)
+        , _pool(0)
     {
     }
 
-    AudioTrackSinkAdapter::~AudioTrackSinkAdapter() { WebRtc_FreeBuffer(_buffer); }
+    AudioTrackSinkAdapter::AudioTrackSinkAdapter(TaskQueueFactory* factory, const AudioTrackSinkOptions& options)
+        : _buffer(nullptr)
+        , _batchFrames(static_cast<size_t>(std::max(options.batchFrames, 1)))
+        , _pool(options.backgroundResample ? std::max(kPoolSize, _batchFrames * 2) : 0)
+    {
+        if (!options.backgroundResample)
+            return;
+        RTC_DCHECK(factory);
+        _pendingFrames.reserve(_pool.size());
+        _processingFrames.reserve(_pool.size());
+        _taskQueue = std::make_unique<rtc::TaskQueue>(
+            factory->CreateTaskQueue("AudioTrackSink", TaskQueueFactory::Priority::HIGH));
+    }
+
+    AudioTrackSinkAdapter::~AudioTrackSinkAdapter()
+    {
+        // Stop the task queue first so that no task touches the members below.
+        _taskQueue = nullptr;
+
+        for (AudioFrame* frame : _pendingFrames)
+            _pool.Release(frame);
+        for (AudioFrame* frame : _processingFrames)
+            _pool.Release(frame);
+        WebRtc_FreeBuffer(_buffer);
+    }
 
     void AudioTrackSinkAdapter::OnData(
         const void* audio_data,
@@ -23,11 +49,52 @@ namespace webrtc
         size_t number_of_channels,
         size_t number_of_frames)
     {
+        // Meter the received audio before converting it to Unity's format.
+        if (bits_per_sample == 16)
+            _levelMeter.Process(
+                static_cast<const int16_t*>(audio_data), number_of_frames, number_of_channels, sample_rate);
+
         std::lock_guard<std::mutex> lock(_mutex);
 
         if (_buffer == nullptr)
             return;
 
+        // The sink receives the audio in the format of the decoder, such as 48 kHz
+        // for Opus, which does not depend on the format of the audio device. When
+        // it matches the format of Unity's output, the data is passed through
+        // without any conversion. Frames still queued for the task queue are
+        // written first, so the data is queued behind them.
+        const bool bypass = bits_per_sample == 16 && sample_rate == _frame.sample_rate_hz_ &&
+            number_of_channels == _frame.num_channels_;
+        if (bypass && _queuedFrames == 0)
+        {
+            size_t length = number_of_channels * number_of_frames;
+            WebRtc_WriteBuffer(_buffer, audio_data, length);
+            _bypassedSamples += length;
+            return;
+        }
+
+        // Copy the data into a pooled frame and leave remixing and resampling to
+        // the task queue so that the decoding thread is not blocked.
+        if (_taskQueue)
+        {
+            AudioFrame* frame = _pool.Acquire();
+            frame->UpdateFrame(
+                0,
+                static_cast<const int16_t*>(audio_data),
+                number_of_frames,
+                sample_rate,
+                AudioFrame::kNormalSpeech,
+                AudioFrame::kVadUnknown,
+                number_of_channels);
+            _frameCopies++;
+            _pendingFrames.push_back(frame);
+            _queuedFrames++;
+            if (_pendingFrames.size() >= _batchFrames)
+                FlushLocked();
+            return;
+        }
+
         // note: AudioTrackSinkInterface::OnData method is passed audio data from
         // audio decoder directly, so we need to resample for expected format.
         // For example, when we use encoder/decoder which has monoural channel,
@@ -45,6 +112,83 @@ namespace webrtc
         size_t length = _frame.num_channels() * _frame.samples_per_channel();
 
         WebRtc_WriteBuffer(_buffer, _frame.data(), length);
+        _resampledSamples += length;
+    }
+
+    void AudioTrackSinkAdapter::ProcessPendingFrames()
+    {
+        RTC_DCHECK(_taskQueue->IsCurrent());
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // The frames may have been processed by the previous task.
+            if (_pendingFrames.empty())
+                return;
+            std::swap(_pendingFrames, _processingFrames);
+            _resampledFrame.num_channels_ = _frame.num_channels_;
+            _resampledFrame.sample_rate_hz_ = _frame.sample_rate_hz_;
+        }
+
+        for (AudioFrame* frame : _processingFrames)
+        {
+            // Frames in the format of Unity's output were queued only to keep
+            // the order, and are written as they are.
+            const bool bypass = frame->num_channels_ == _resampledFrame.num_channels_ &&
+                frame->sample_rate_hz_ == _resampledFrame.sample_rate_hz_;
+            const AudioFrame& output = bypass ? *frame : _resampledFrame;
+            if (!bypass)
+                webrtc::voe::RemixAndResample(*frame, &_resampler, &_resampledFrame);
+            size_t length = output.num_channels() * output.samples_per_channel();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queuedFrames--;
+            // Drop the frame when Unity changed the format while resampling.
+            if (_buffer != nullptr && output.num_channels_ == _frame.num_channels_ &&
+                output.sample_rate_hz_ == _frame.sample_rate_hz_)
+            {
+                WebRtc_WriteBuffer(_buffer, output.data(), length);
+                if (bypass)
+                    _bypassedSamples += length;
+                else
+                    _resampledSamples += length;
+            }
+        }
+
+        for (AudioFrame* frame : _processingFrames)
+            _pool.Release(frame);
+        _processingFrames.clear();
+    }
+
+    void AudioTrackSinkAdapter::Flush()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        FlushLocked();
+    }
+
+    void AudioTrackSinkAdapter::WaitForTaskQueue()
+    {
+        if (!_taskQueue)
+            return;
+        rtc::Event done;
+        _taskQueue->PostTask([&done] { done.Set(); });
+        done.Wait(rtc::Event::kForever);
+    }
+
+    void AudioTrackSinkAdapter::FlushLocked()
+    {
+        if (_taskQueue && !_pendingFrames.empty())
+            _taskQueue->PostTask([this] { ProcessPendingFrames(); });
+    }
+
+    AudioTrackSinkCounters AudioTrackSinkAdapter::GetCounters() const
+    {
+        AudioTrackSinkCounters counters;
+        counters.bypassedSamples = _bypassedSamples;
+        counters.resampledSamples = _resampledSamples;
+        counters.frameAllocations = _pool.allocationCount();
+        counters.frameCopies = _frameCopies;
+        counters.pooledFrames = _pool.size();
+        return counters;
     }
 
     void AudioTrackSinkAdapter::ResizeBuffer(size_t channels, int32_t sampleRate, size_t length)
@@ -86,9 +230,11 @@ namespace webrtc
         }
 
         size_t readLength = WebRtc_ReadBuffer(_buffer, nullptr, _bufferIn.data(), length);
+        // No more audio arrives once the track has stopped.
+        if (readLength < length)
+            FlushLocked();
 
-        for (size_t i = 0; i < readLength; i++)
-            data[i] = webrtc::S16ToFloat(_bufferIn[i]);
+        ConvertS16ToFloat(_bufferIn.data(), readLength, data);
     }
 } // end namespace webrtc
 } // end namespace unity
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include <api/audio/audio_frame.h>
 #include <api/media_stream_interface.h>
+#include <api/task_queue/task_queue_factory.h>
 #include <common_audio/resampler/include/push_resampler.h>
 #include <common_audio/ring_buffer.h>
+#include <rtc_base/task_queue.h>
+
+#include "AudioFramePool.h"
+#include "AudioLevelMeter.h"
 
 namespace unity
 {
@@ -13,10 +19,31 @@ namespace webrtc
 {
     using namespace ::webrtc;
 
+    // Data format used by the managed code.
+    struct AudioTrackSinkOptions
+    {
+        // Remix and resample received audio on a dedicated task queue instead of
+        // the thread which decodes audio.
+        bool backgroundResample = false;
+        // Number of 10 ms frames passed to the task queue at once.
+        int32_t batchFrames = 1;
+    };
+
+    // Read by the managed code to check that the steady state does not allocate.
+    struct AudioTrackSinkCounters
+    {
+        uint64_t bypassedSamples;
+        uint64_t resampledSamples;
+        uint64_t frameAllocations;
+        uint64_t frameCopies;
+        uint64_t pooledFrames;
+    };
+
     class AudioTrackSinkAdapter : public webrtc::AudioTrackSinkInterface
     {
     public:
         AudioTrackSinkAdapter();
+        AudioTrackSinkAdapter(TaskQueueFactory* factory, const AudioTrackSinkOptions& options);
         ~AudioTrackSinkAdapter() override;
 
         void OnData(
@@ -26,10 +53,30 @@ namespace webrtc
             size_t number_of_channels,
             size_t number_of_frames) override;
 
+        // Frames waiting for a full batch are passed to the task queue when
+        // the buffer runs short, so that the tail of the audio is played.
         void ProcessAudio(float* data, size_t length, size_t channels, int32_t sampleRate);
+        // Passes the frames waiting for a full batch to the task queue. Called
+        // when the sink is removed from the track.
+        void Flush();
+        // Blocks until the tasks already posted to the task queue have run.
+        void WaitForTaskQueue();
+
+        // Count of samples written to the buffer without remixing and resampling
+        // because the received format matched the format requested by Unity.
+        uint64_t bypassedSamples() const { return _bypassedSamples; }
+        uint64_t resampledSamples() const { return _resampledSamples; }
+        AudioTrackSinkCounters GetCounters() const;
+        AudioLevelMeter* levelMeter() { return &_levelMeter; }
 
     private:
         void ResizeBuffer(size_t channels, int32_t sampleRate, size_t length);
+        void ProcessPendingFrames();
+        // Requires _mutex.
+        void FlushLocked();
+
+        // 80 ms of audio is enough to absorb jitter of the task queue.
+        static constexpr size_t kPoolSize = 8;
 
         AudioFrame _frame;
         std::mutex _mutex;
@@ -37,6 +84,20 @@ namespace webrtc
         std::vector<int16_t> _bufferIn;
 
         PushResampler<int16_t> _resampler;
+        AudioLevelMeter _levelMeter;
+        std::atomic<uint64_t> _bypassedSamples { 0 };
+        std::atomic<uint64_t> _resampledSamples { 0 };
+        std::atomic<uint64_t> _frameCopies { 0 };
+
+        // Used only when the background resample stage is enabled.
+        size_t _batchFrames = 1;
+        AudioFramePool _pool;
+        AudioFrame _resampledFrame;
+        // Frames passed to OnData which have not been written to the buffer.
+        size_t _queuedFrames = 0;
+        std::vector<AudioFrame*> _pendingFrames;
+        std::vector<AudioFrame*> _processingFrames;
+        std::unique_ptr<rtc::TaskQueue> _taskQueue;
     };
 } // end namespace webrtc
 } // end namespace unity
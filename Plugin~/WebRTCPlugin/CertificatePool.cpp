@@ -0,0 +1,86 @@
+#include "pch.h"
+
+#include <rtc_base/rtc_certificate_generator.h>
+#include <rtc_base/time_utils.h>
+
+#include "CertificatePool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    CertificatePool::CertificatePool(TaskQueueBase* queue)
+        : queue_(queue)
+    {
+    }
+
+    void CertificatePool::SetCapacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        if (certificates_.size() > capacity_)
+            certificates_.resize(capacity_);
+        ScheduleRefill();
+    }
+
+    rtc::scoped_refptr<rtc::RTCCertificate> CertificatePool::Take()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t now = static_cast<uint64_t>(rtc::TimeUTCMillis());
+        rtc::scoped_refptr<rtc::RTCCertificate> certificate;
+        while (!certificate && !certificates_.empty())
+        {
+            certificate = std::move(certificates_.back());
+            certificates_.pop_back();
+            if (certificate->HasExpired(now))
+                certificate = nullptr;
+        }
+        ScheduleRefill();
+        return certificate;
+    }
+
+    size_t CertificatePool::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return certificates_.size();
+    }
+
+    void CertificatePool::ScheduleRefill()
+    {
+        if (refillPending_ || certificates_.size() >= capacity_)
+            return;
+        refillPending_ = true;
+        queue_->PostTask([this]() { Refill(); });
+    }
+
+    void CertificatePool::Refill()
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (certificates_.size() >= capacity_)
+                {
+                    refillPending_ = false;
+                    return;
+                }
+            }
+            // The same key type as the certificates peer connections generate
+            // for themselves.
+            rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+                rtc::RTCCertificateGenerator::GenerateCertificate(rtc::KeyParams::ECDSA(), absl::nullopt);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!certificate)
+            {
+                RTC_LOG(LS_ERROR) << "Failed to generate a certificate for the pool.";
+                refillPending_ = false;
+                return;
+            }
+            if (certificates_.size() < capacity_)
+                certificates_.push_back(std::move(certificate));
+        }
+    }
+
+} // end namespace webrtc
+} // end namespace unity
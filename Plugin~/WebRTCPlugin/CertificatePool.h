@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <api/scoped_refptr.h>
+#include <api/task_queue/task_queue_base.h>
+#include <rtc_base/rtc_certificate.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Generates DTLS certificates ahead of time, so that a new peer connection
+    // neither waits for its certificate before gathering candidates nor before
+    // creating its first offer. The certificates are generated on `queue`,
+    // which must not run the tasks of the pool after the pool is destroyed.
+    class CertificatePool
+    {
+    public:
+        explicit CertificatePool(TaskQueueBase* queue);
+        CertificatePool(const CertificatePool&) = delete;
+        CertificatePool& operator=(const CertificatePool&) = delete;
+
+        // Certificates beyond the capacity are released.
+        void SetCapacity(size_t capacity);
+        // Returns null when no certificate is ready. The certificate taken is
+        // replaced in the background.
+        rtc::scoped_refptr<rtc::RTCCertificate> Take();
+        size_t size() const;
+
+    private:
+        // Requires mutex_.
+        void ScheduleRefill();
+        void Refill();
+
+        TaskQueueBase* const queue_;
+        mutable std::mutex mutex_;
+        std::vector<rtc::scoped_refptr<rtc::RTCCertificate>> certificates_;
+        size_t capacity_ = 0;
+        bool refillPending_ = false;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
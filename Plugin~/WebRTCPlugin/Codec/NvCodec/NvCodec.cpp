@@ -5,6 +5,7 @@
 #include <modules/video_coding/codecs/h264/include/h264.h>
 
 #include "Codec/CreateVideoCodecFactory.h"
+#include "Codec/VideoCodecCapabilityCache.h"
 #include "NvCodec.h"
 #include "NvDecoder/NvDecoder.h"
 #include "NvDecoderImpl.h"
@@ -146,7 +147,7 @@ namespace webrtc
         return std::make_unique<NvEncoderImpl>(codec, context, memoryType, format, profiler);
     }
 
-    bool NvEncoder::IsSupported(CUcontext context)
+    static bool ProbeNvEncoder(CUcontext context)
     {
         uint32_t version = 0;
         uint32_t currentVersion = (NVENCAPI_MAJOR_VERSION << 4) | NVENCAPI_MINOR_VERSION;
@@ -183,6 +184,61 @@ namespace webrtc
         return true;
     }
 
+    // Identifies the capabilities of the device, which change with the GPU and
+    // the driver. The UUID distinguishes GPUs of the same model.
+    static std::string GetNvCodecDeviceKey(CUcontext context)
+    {
+        // The context is pushed instead of set, so that the context current
+        // on the calling thread is kept.
+        CUdevice device = 0;
+        cuCtxPushCurrent(context);
+        cuCtxGetDevice(&device);
+        cuCtxPopCurrent(nullptr);
+
+        char name[256] = {};
+        cuDeviceGetName(name, sizeof(name), device);
+        int driverVersion = 0;
+        cuDriverGetVersion(&driverVersion);
+        CUuuid uuid = {};
+        cuDeviceGetUuid(&uuid, device);
+
+        std::string key = name;
+        key += " driver " + std::to_string(driverVersion) + " ";
+        constexpr char kHexDigits[] = "0123456789abcdef";
+        for (char byte : uuid.bytes)
+        {
+            key += kHexDigits[static_cast<uint8_t>(byte) >> 4];
+            key += kHexDigits[static_cast<uint8_t>(byte) & 0xf];
+        }
+        return key;
+    }
+
+    // Every context and factory shard creates an encoder factory, and each probe
+    // opens an NvEnc session, so the results are kept for the process and
+    // persisted for later launches.
+    std::vector<SdpVideoFormat> CachedNvEncoderCodecs(CUcontext context)
+    {
+        return VideoCodecCapabilityCache::GetInstance().GetOrProbe(
+            "NvEnc " + GetNvCodecDeviceKey(context),
+            true,
+            [context]()
+            {
+                if (!ProbeNvEncoder(context))
+                    return std::vector<SdpVideoFormat>();
+                return SupportedNvEncoderCodecs(context);
+            });
+    }
+
+    std::vector<SdpVideoFormat> CachedNvDecoderCodecs(CUcontext context)
+    {
+        return VideoCodecCapabilityCache::GetInstance().GetOrProbe(
+            "NvDec " + GetNvCodecDeviceKey(context),
+            true,
+            [context]() { return SupportedNvDecoderCodecs(context); });
+    }
+
+    bool NvEncoder::IsSupported(CUcontext context) { return !CachedNvEncoderCodecs(context).empty(); }
+
     std::unique_ptr<NvDecoder>
     NvDecoder::Create(const cricket::VideoCodec& codec, CUcontext context, ProfilerMarkerFactory* profiler)
     {
@@ -197,23 +253,21 @@ namespace webrtc
         // Some NVIDIA GPUs have a limited Encode Session count.
         // refer: https://developer.nvidia.com/video-encode-and-decode-gpu-support-matrix-new
         // It consumes a session to check the encoder capability.
-        // Therefore, we check encoder capability only once in the constructor and cache it.
-        m_cachedSupportedFormats = SupportedNvEncoderCodecs(context_);
+        // Therefore, we check encoder capability only once for the process and cache it.
+        if (!CachedNvEncoderCodecs(context_).empty())
+            m_cachedSupportedFormats = CachedNvDecoderCodecs(context_);
     }
     NvEncoderFactory::~NvEncoderFactory() = default;
 
     std::vector<SdpVideoFormat> NvEncoderFactory::GetSupportedFormats() const
     {
-        // If NvCodec Encoder is not supported, return empty vector.
-        if (m_cachedSupportedFormats.empty())
-            return std::vector<SdpVideoFormat>();
-
+        // If NvCodec Encoder is not supported, the cache is empty.
         // In RTCRtpTransceiver.SetCodecPreferences, the codec passed must be supported by both encoder and decoder.
         // https://source.chromium.org/chromium/chromium/src/+/main:third_party/webrtc/pc/rtp_transceiver.cc;l=36
         // About H264, Profile and its Level must also match in this implementation.
         // NvEncoder supports a higher level of H264 Profile than NvDecoder.
         // Therefore, return the support codec of NvDecoder as Workaround.
-        return SupportedNvDecoderCodecs(context_);
+        return m_cachedSupportedFormats;
     }
 
     std::unique_ptr<VideoEncoder> NvEncoderFactory::CreateVideoEncoder(const SdpVideoFormat& format)
@@ -225,14 +279,12 @@ namespace webrtc
     NvDecoderFactory::NvDecoderFactory(CUcontext context, ProfilerMarkerFactory* profiler)
         : context_(context)
         , profiler_(profiler)
+        , m_cachedSupportedFormats(CachedNvDecoderCodecs(context))
     {
     }
     NvDecoderFactory::~NvDecoderFactory() = default;
 
-    std::vector<SdpVideoFormat> NvDecoderFactory::GetSupportedFormats() const
-    {
-        return SupportedNvDecoderCodecs(context_);
-    }
+    std::vector<SdpVideoFormat> NvDecoderFactory::GetSupportedFormats() const { return m_cachedSupportedFormats; }
 
     std::unique_ptr<VideoDecoder> NvDecoderFactory::CreateVideoDecoder(const SdpVideoFormat& format)
     {
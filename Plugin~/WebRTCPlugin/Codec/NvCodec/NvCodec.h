@@ -24,6 +24,12 @@ namespace webrtc
     std::vector<SdpVideoFormat> SupportedNvEncoderCodecs(CUcontext context);
     std::vector<SdpVideoFormat> SupportedNvDecoderCodecs(CUcontext context);
 
+    // Results of SupportedNvEncoderCodecs and SupportedNvDecoderCodecs kept in
+    // VideoCodecCapabilityCache for the device and the driver. The encoder
+    // formats are empty when the device cannot open an NvEnc session.
+    std::vector<SdpVideoFormat> CachedNvEncoderCodecs(CUcontext context);
+    std::vector<SdpVideoFormat> CachedNvDecoderCodecs(CUcontext context);
+
     class ProfilerMarkerFactory;
 
     class NvEncoder : public VideoEncoder
@@ -79,6 +85,7 @@ namespace webrtc
     private:
         CUcontext context_;
         ProfilerMarkerFactory* profiler_;
+        std::vector<SdpVideoFormat> m_cachedSupportedFormats;
     };
 
 #ifndef _WIN32
@@ -173,11 +173,21 @@ namespace webrtc
                 "NvEncoderImpl.CopyResource", kUnityProfilerCategoryOther, kUnityProfilerMarkerFlagDefault, 0);
 
         // SupportedNvEncoderCodecs and SupportedMaxH264Level function consume the session of NvEnc and the number of
-        // the sessions is limited by NVIDIA device. So it caches the return value here.
+        // the sessions is limited by NVIDIA device. So it caches the return value here. All formats have the max
+        // level, so it is read from the cached formats instead of opening another session.
         if (s_formats.empty())
-            s_formats = SupportedNvEncoderCodecs(m_context);
+            s_formats = CachedNvEncoderCodecs(m_context);
         if (!s_maxSupportedH264Level.has_value())
-            s_maxSupportedH264Level = SupportedMaxH264Level(m_context);
+        {
+            for (const auto& format : s_formats)
+            {
+                absl::optional<H264ProfileLevelId> id = ParseSdpForH264ProfileLevelId(format.parameters);
+                if (id.has_value() && (!s_maxSupportedH264Level.has_value() || id->level > *s_maxSupportedH264Level))
+                    s_maxSupportedH264Level = id->level;
+            }
+            if (!s_maxSupportedH264Level.has_value())
+                s_maxSupportedH264Level = SupportedMaxH264Level(m_context);
+        }
     }
 
     NvEncoderImpl::~NvEncoderImpl() { Release(); }
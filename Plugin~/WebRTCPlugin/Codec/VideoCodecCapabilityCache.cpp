@@ -0,0 +1,196 @@
+#include "pch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "SdpFmtp.h"
+#include "VideoCodecCapabilityCache.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // The file has a version line followed by an "entry" line for each key,
+    // and a "format" line for each format of the entry. Fields are separated
+    // by tabs, which appear neither in the keys nor in the formats.
+    static constexpr std::string_view kVersionTag = "version";
+    static constexpr std::string_view kEntryTag = "entry";
+    static constexpr std::string_view kFormatTag = "format";
+
+    static std::vector<std::string_view> SplitFields(std::string_view line)
+    {
+        std::vector<std::string_view> fields;
+        while (true)
+        {
+            const size_t end = line.find('\t');
+            fields.push_back(line.substr(0, end));
+            if (end == std::string_view::npos)
+                return fields;
+            line = line.substr(end + 1);
+        }
+    }
+
+    VideoCodecCapabilityCache& VideoCodecCapabilityCache::GetInstance()
+    {
+        static VideoCodecCapabilityCache instance(WEBRTC_PLUGIN_VERSION);
+        return instance;
+    }
+
+    VideoCodecCapabilityCache::VideoCodecCapabilityCache(std::string version)
+        : version_(std::move(version))
+    {
+    }
+
+    std::vector<SdpVideoFormat>
+    VideoCodecCapabilityCache::GetOrProbe(const std::string& key, bool persistent, const Probe& probe)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+            return it->second.formats;
+
+        probeCount_++;
+        std::vector<SdpVideoFormat> formats = probe();
+        // A probe also fails while the sessions are held by others, so an
+        // empty result is probed again by the next call.
+        if (formats.empty())
+            return formats;
+        entries_.emplace(key, Entry { formats, persistent });
+        if (persistent)
+            SaveLocked();
+        return formats;
+    }
+
+    void VideoCodecCapabilityCache::SetPersistentPath(const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            path_ = path;
+        }
+        if (path.empty())
+            return;
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return;
+        std::stringstream data;
+        data << file.rdbuf();
+        if (!Deserialize(data.str()))
+            RTC_LOG(LS_INFO) << "Codec capabilities are probed again because the cache is outdated: " << path;
+    }
+
+    std::string VideoCodecCapabilityCache::Serialize() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return SerializeLocked();
+    }
+
+    std::string VideoCodecCapabilityCache::SerializeLocked() const
+    {
+        std::string data;
+        data.append(kVersionTag).append("\t").append(version_).append("\n");
+        for (const auto& pair : entries_)
+        {
+            if (!pair.second.persistent)
+                continue;
+            data.append(kEntryTag).append("\t").append(pair.first).append("\n");
+            for (const auto& format : pair.second.formats)
+            {
+                RTC_DCHECK(format.scalability_modes.empty());
+                data.append(kFormatTag)
+                    .append("\t")
+                    .append(format.name)
+                    .append("\t")
+                    .append(SerializeSdpFmtp(format.parameters))
+                    .append("\n");
+            }
+        }
+        return data;
+    }
+
+    bool VideoCodecCapabilityCache::Deserialize(std::string_view data)
+    {
+        std::map<std::string, Entry> entries;
+        Entry* current = nullptr;
+        bool versionMatched = false;
+        while (!data.empty())
+        {
+            const size_t end = data.find('\n');
+            const std::string_view line = data.substr(0, end);
+            data = end == std::string_view::npos ? std::string_view() : data.substr(end + 1);
+            if (line.empty())
+                continue;
+
+            const std::vector<std::string_view> fields = SplitFields(line);
+            if (!versionMatched)
+            {
+                if (fields.size() != 2 || fields[0] != kVersionTag || fields[1] != version_)
+                    return false;
+                versionMatched = true;
+            }
+            else if (fields.size() == 2 && fields[0] == kEntryTag)
+            {
+                current = &entries[std::string(fields[1])];
+                current->persistent = true;
+            }
+            else if (fields.size() == 3 && fields[0] == kFormatTag && current)
+            {
+                SdpVideoFormat::Parameters parameters;
+                ParseSdpFmtp(fields[2], &parameters);
+                current->formats.emplace_back(std::string(fields[1]), parameters);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (!versionMatched)
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Entries probed in this process are newer than the file.
+        for (auto& pair : entries)
+        {
+            if (!pair.second.formats.empty())
+                entries_.emplace(pair.first, std::move(pair.second));
+        }
+        return true;
+    }
+
+    void VideoCodecCapabilityCache::SaveLocked() const
+    {
+        if (path_.empty())
+            return;
+
+        // Writes to a temporary file first, so that a process which exits in
+        // the middle of writing does not leave a truncated cache.
+        const std::string temporaryPath = path_ + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return;
+            file << SerializeLocked();
+            if (!file)
+                return;
+        }
+        std::remove(path_.c_str());
+        if (std::rename(temporaryPath.c_str(), path_.c_str()) != 0)
+            RTC_LOG(LS_WARNING) << "Failed to write codec capabilities to " << path_;
+    }
+
+    size_t VideoCodecCapabilityCache::probeCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return probeCount_;
+    }
+
+    void VideoCodecCapabilityCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        probeCount_ = 0;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <api/video_codecs/sdp_video_format.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Supported formats of the video codec implementations, probed once for
+    // the process and shared by all contexts. Probing hardware codecs opens
+    // encode sessions, whose number is limited by the driver, so the entries
+    // marked persistent are also written to a file which later launches read
+    // instead of probing. The key of an entry identifies the device and the
+    // driver version, and the file is ignored when it was written by another
+    // version of the library. Empty results are neither kept nor written,
+    // because a probe also fails while other processes hold all the sessions.
+    // Scalability modes are not written, so formats of persistent entries
+    // must not have them.
+    class VideoCodecCapabilityCache
+    {
+    public:
+        using Probe = std::function<std::vector<SdpVideoFormat>()>;
+
+        static VideoCodecCapabilityCache& GetInstance();
+
+        explicit VideoCodecCapabilityCache(std::string version);
+        VideoCodecCapabilityCache(const VideoCodecCapabilityCache&) = delete;
+        VideoCodecCapabilityCache& operator=(const VideoCodecCapabilityCache&) = delete;
+
+        // Calls `probe` only when the key is not cached. Concurrent calls wait
+        // for the probe, so that a device is probed only once until it
+        // succeeds.
+        std::vector<SdpVideoFormat> GetOrProbe(const std::string& key, bool persistent, const Probe& probe);
+
+        // Reads the entries of the file, and writes the persistent entries to
+        // it whenever one is added. An empty path disables persistence.
+        void SetPersistentPath(const std::string& path);
+
+        // Persistent entries in the format of the file.
+        std::string Serialize() const;
+        // Returns false when the data was written by another version or is
+        // malformed, in which case no entry is added.
+        bool Deserialize(std::string_view data);
+
+        size_t probeCount() const;
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            std::vector<SdpVideoFormat> formats;
+            bool persistent;
+        };
+
+        std::string SerializeLocked() const;
+        void SaveLocked() const;
+
+        const std::string version_;
+        mutable std::mutex mutex_;
+        std::map<std::string, Entry> entries_;
+        std::string path_;
+        size_t probeCount_ = 0;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
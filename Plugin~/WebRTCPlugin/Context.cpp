@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include <thread>
+
 #include <api/create_peerconnection_factory.h>
 #include <api/task_queue/default_task_queue_factory.h>
 #include <rtc_base/ssl_adapter.h>
@@ -11,6 +13,8 @@
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "GraphicsDevice/IGraphicsDevice.h"
 #include "MediaStreamObserver.h"
+#include "ProfilerMarkerFactory.h"
+#include "ScopedProfiler.h"
 #include "UnityAudioDecoderFactory.h"
 #include "UnityAudioEncoderFactory.h"
 #include "UnityAudioTrackSource.h"
@@ -43,6 +47,7 @@ namespace webrtc
 
     Context* ContextManager::GetContext(int uid) const
     {
+        std::lock_guard<std::mutex> lock(s_instance->mutex);
         auto it = s_instance->m_contexts.find(uid);
         if (it != s_instance->m_contexts.end())
         {
@@ -53,39 +58,133 @@ namespace webrtc
 
     Context* ContextManager::CreateContext(int uid, ContextDependencies& dependencies)
     {
-        auto it = s_instance->m_contexts.find(uid);
-        if (it != s_instance->m_contexts.end())
+        if (GetContext(uid))
         {
             DebugLog("Using already created context with ID %d", uid);
             return nullptr;
         }
-        s_instance->m_contexts[uid] = std::make_unique<Context>(dependencies);
-        return s_instance->m_contexts[uid].get();
+        return RegisterContext(uid, std::make_unique<Context>(dependencies));
     }
 
-    void ContextManager::SetCurContext(Context* context) { curContext = context; }
+    Context* ContextManager::RegisterContext(int uid, ContextPtr context)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (m_contexts.find(uid) != m_contexts.end())
+            return nullptr;
+        context->SetHandle(m_contextHandles.Add(context.get()));
+        return (m_contexts[uid] = std::move(context)).get();
+    }
 
-    bool ContextManager::Exists(Context* context)
+    ContextManager::ContextPtr ContextManager::UnregisterContext(int uid)
     {
-        for (auto it = s_instance->m_contexts.begin(); it != s_instance->m_contexts.end(); ++it)
-        {
-            if (it->second.get() == context)
-                return true;
-        }
-        return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = m_contexts.find(uid);
+        if (it == m_contexts.end())
+            return nullptr;
+        // The handle is invalidated first, so that the render thread stops
+        // using the context before it is destroyed.
+        m_contextHandles.Remove(it->second->handle());
+        ContextPtr context = std::move(it->second);
+        m_contexts.erase(it);
+        return context;
+    }
+
+    void ContextManager::WaitForRenderEvents() const
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (IsRenderEventInFlight())
+            std::this_thread::yield();
     }
 
+    void ContextManager::SetCurContext(Context* context) { curContext = context; }
+
     void ContextManager::DestroyContext(int uid)
     {
-        auto it = s_instance->m_contexts.find(uid);
-        if (it != s_instance->m_contexts.end())
+        ContextPtr context = s_instance->UnregisterContext(uid);
+        if (!context)
+            return;
+        s_instance->WaitForRenderEvents();
+        context.reset();
+    }
+
+    rtc::Thread* ContextManager::asyncThread()
+    {
+        if (!m_asyncThread)
         {
-            s_instance->m_contexts.erase(it);
+            m_asyncThread = rtc::Thread::Create();
+            m_asyncThread->SetName("WebRTC Context", nullptr);
+            m_asyncThread->Start();
         }
+        return m_asyncThread.get();
+    }
+
+    rtc::scoped_refptr<ContextAsyncOperation> ContextManager::CreateContextAsync(
+        int uid, const ContextDependencies& dependencies, DelegateContextAsyncCompleted callback)
+    {
+        auto operation = rtc::make_ref_counted<ContextAsyncOperation>(callback);
+        asyncThread()->PostTask(
+            [this, uid, dependencies, operation]() mutable
+            {
+                if (GetContext(uid))
+                {
+                    DebugLog("Using already created context with ID %d", uid);
+                    operation->Complete(ContextAsyncState::kFailed, nullptr);
+                    return;
+                }
+                Context* context = RegisterContext(uid, std::make_unique<Context>(dependencies));
+                operation->Complete(context ? ContextAsyncState::kSucceeded : ContextAsyncState::kFailed, context);
+            });
+        return operation;
+    }
+
+    rtc::scoped_refptr<ContextAsyncOperation>
+    ContextManager::DestroyContextAsync(int uid, DelegateContextAsyncCompleted callback)
+    {
+        auto operation = rtc::make_ref_counted<ContextAsyncOperation>(callback);
+        ContextPtr context = UnregisterContext(uid);
+        asyncThread()->PostTask(
+            [this, context = std::move(context), operation]() mutable
+            {
+                if (!context)
+                {
+                    operation->Complete(ContextAsyncState::kFailed, nullptr);
+                    return;
+                }
+                WaitForRenderEvents();
+                context.reset();
+                operation->Complete(ContextAsyncState::kSucceeded, nullptr);
+            });
+        return operation;
+    }
+
+    void ContextAsyncOperation::Complete(ContextAsyncState state, Context* context)
+    {
+        m_context.store(context);
+        m_state.store(state);
+        if (m_callback)
+            m_callback(this, state);
+    }
+
+    bool ContextManager::BeginRenderEvent(HandleTable::Handle handle, const Context* context)
+    {
+        m_renderEventsInFlight.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Exists(handle, context))
+            return true;
+        m_renderEventsInFlight.fetch_sub(1);
+        return false;
     }
 
+    void ContextManager::EndRenderEvent() { m_renderEventsInFlight.fetch_sub(1); }
+
     ContextManager::~ContextManager()
     {
+        // The operations in flight are finished before the contexts are destroyed.
+        if (m_asyncThread)
+        {
+            m_asyncThread->BlockingCall([]() {});
+            m_asyncThread->Stop();
+        }
         if (m_contexts.size())
         {
             DebugWarning("%lu remaining context(s) registered", m_contexts.size());
@@ -148,16 +247,161 @@ namespace webrtc
     }
 
     Context::Context(ContextDependencies& dependencies)
-        : m_workerThread(rtc::Thread::CreateWithSocketServer())
-        , m_signalingThread(rtc::Thread::CreateWithSocketServer())
+        : m_signalingThread(rtc::Thread::CreateWithSocketServer())
         , m_taskQueueFactory(CreateDefaultTaskQueueFactory())
+        , m_statsReports(Clock::GetRealTimeClock())
     {
-        m_workerThread->Start();
-        m_signalingThread->Start();
+        StartThread(m_signalingThread.get(), "WebRTC Signaling", dependencies.threads.signaling, dependencies.profiler);
 
         rtc::InitializeSSL();
 
-        m_audioDevice = m_workerThread->BlockingCall(
+        rtc::scoped_refptr<AudioEncoderFactory> audioEncoderFactory = CreateAudioEncoderFactory();
+        rtc::scoped_refptr<AudioDecoderFactory> audioDecoderFactory = CreateAudioDecoderFactory();
+
+        const int32_t shardCount = std::max(dependencies.threads.factoryShards, 1);
+        for (int32_t i = 0; i < shardCount; i++)
+            m_shards.push_back(CreateShard(i, dependencies, audioEncoderFactory, audioDecoderFactory));
+    }
+
+    HandleTable::Handle Context::GetRefPtrHandle(const rtc::RefCountInterface* ptr) const
+    {
+        std::lock_guard<std::mutex> lock(m_refPtrMutex);
+        auto it = m_mapRefPtr.find(ptr);
+        return it != m_mapRefPtr.end() ? it->second.handle : HandleTable::kInvalidHandle;
+    }
+
+    void Context::AddRefPtr(rtc::scoped_refptr<rtc::RefCountInterface> refptr)
+    {
+        ReleaseDeferredRefPtrs();
+        std::lock_guard<std::mutex> lock(m_refPtrMutex);
+        const rtc::RefCountInterface* ptr = refptr.get();
+        if (m_mapRefPtr.find(ptr) != m_mapRefPtr.end())
+            return;
+        const HandleTable::Handle handle = m_refPtrHandles.Add(ptr);
+        m_mapRefPtr.emplace(ptr, RefPtrEntry { std::move(refptr), handle });
+    }
+
+    void Context::RemoveRefPtr(const rtc::RefCountInterface* ptr)
+    {
+        rtc::scoped_refptr<rtc::RefCountInterface> refptr;
+        {
+            std::lock_guard<std::mutex> lock(m_refPtrMutex);
+            auto it = m_mapRefPtr.find(ptr);
+            if (it == m_mapRefPtr.end())
+                return;
+            m_refPtrHandles.Remove(it->second.handle);
+            refptr = std::move(it->second.refptr);
+            m_mapRefPtr.erase(it);
+
+            // The render thread validates the objects by handle without a
+            // lock, so an event in flight may still use the object.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ContextManager::GetInstance()->IsRenderEventInFlight())
+            {
+                m_deferredRefPtrs.push_back(std::move(refptr));
+                return;
+            }
+        }
+        refptr = nullptr;
+        ReleaseDeferredRefPtrs();
+    }
+
+    void Context::ReleaseDeferredRefPtrs()
+    {
+        std::vector<rtc::scoped_refptr<rtc::RefCountInterface>> refptrs;
+        {
+            std::lock_guard<std::mutex> lock(m_refPtrMutex);
+            if (m_deferredRefPtrs.empty() || ContextManager::GetInstance()->IsRenderEventInFlight())
+                return;
+            refptrs.swap(m_deferredRefPtrs);
+        }
+        // Released outside of the lock.
+    }
+
+    Context::~Context()
+    {
+        // The warm-up tasks create connections on the shards.
+        std::unique_ptr<TaskQueueBase, TaskQueueDeleter> warmupQueue;
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            warmupQueue = std::move(m_warmupQueue);
+        }
+        warmupQueue = nullptr;
+        std::vector<PooledPeerConnection> pooled;
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            pooled.swap(m_pooledConnections);
+        }
+        ReleasePooledPeerConnections(std::move(pooled));
+        m_certificates = nullptr;
+
+        for (auto& shard : m_shards)
+        {
+            shard->factory = nullptr;
+            shard->workerThread->BlockingCall([&shard]() { shard->audioDevice = nullptr; });
+        }
+        m_peerConnectionShards.clear();
+        m_mapClients.clear();
+
+        // check count of refptr to avoid to forget disposing
+        RTC_DCHECK_EQ(m_mapRefPtr.size(), 0);
+
+        m_mapRefPtr.clear();
+        m_deferredRefPtrs.clear();
+        m_mapMediaStreamObserver.clear();
+        m_mapDataChannels.clear();
+        m_mapVideoRenderer.clear();
+
+        m_profilerThreads.clear();
+        for (auto& shard : m_shards)
+        {
+            shard->workerThread->Quit();
+            if (shard->networkThread)
+                shard->networkThread->Quit();
+        }
+        m_shards.clear();
+        m_signalingThread->Quit();
+        m_signalingThread.reset();
+    }
+
+    void Context::StartThread(
+        rtc::Thread* thread, const char* name, const ThreadOptions& options, ProfilerMarkerFactory* profiler)
+    {
+        // The name is given to the OS thread when the thread starts.
+        thread->SetName(name, nullptr);
+        thread->Start();
+        thread->BlockingCall(
+            [&]()
+            {
+                ApplyThreadOptions(options);
+                if (profiler)
+                    m_profilerThreads.push_back(profiler->CreateScopedProfilerThread("WebRTC", name));
+            });
+    }
+
+    std::unique_ptr<Context::FactoryShard> Context::CreateShard(
+        int32_t index,
+        const ContextDependencies& dependencies,
+        rtc::scoped_refptr<AudioEncoderFactory> audioEncoderFactory,
+        rtc::scoped_refptr<AudioDecoderFactory> audioDecoderFactory)
+    {
+        const ContextThreadOptions& threads = dependencies.threads;
+        // Threads of the first shard are named without the index.
+        const std::string suffix = index ? " " + std::to_string(index) : "";
+
+        auto shard = std::make_unique<FactoryShard>();
+        if (threads.separateNetworkThread)
+        {
+            shard->networkThread = rtc::Thread::CreateWithSocketServer();
+            StartThread(
+                shard->networkThread.get(), ("WebRTC Network" + suffix).c_str(), threads.network, dependencies.profiler);
+        }
+        // The worker thread runs socket I/O unless the network thread is separated.
+        shard->workerThread = shard->networkThread ? rtc::Thread::Create() : rtc::Thread::CreateWithSocketServer();
+        StartThread(
+            shard->workerThread.get(), ("WebRTC Worker" + suffix).c_str(), threads.worker, dependencies.profiler);
+
+        shard->audioDevice = shard->workerThread->BlockingCall(
             [&]() { return rtc::make_ref_counted<DummyAudioDevice>(m_taskQueueFactory.get()); });
 
         std::unique_ptr<webrtc::VideoEncoderFactory> videoEncoderFactory =
@@ -166,63 +410,59 @@ namespace webrtc
         std::unique_ptr<webrtc::VideoDecoderFactory> videoDecoderFactory =
             std::make_unique<UnityVideoDecoderFactory>(dependencies.device, dependencies.profiler);
 
-        rtc::scoped_refptr<AudioEncoderFactory> audioEncoderFactory = CreateAudioEncoderFactory();
-        rtc::scoped_refptr<AudioDecoderFactory> audioDecoderFactory = CreateAudioDecoderFactory();
-
-        m_peerConnectionFactory = CreatePeerConnectionFactory(
-            m_workerThread.get(),
-            m_workerThread.get(),
+        shard->factory = CreatePeerConnectionFactory(
+            shard->networkThread ? shard->networkThread.get() : shard->workerThread.get(),
+            shard->workerThread.get(),
             m_signalingThread.get(),
-            m_audioDevice,
+            shard->audioDevice,
             audioEncoderFactory,
             audioDecoderFactory,
             std::move(videoEncoderFactory),
             std::move(videoDecoderFactory),
             nullptr,
             nullptr);
+        return shard;
     }
 
-    Context::~Context()
+    Context::FactoryShard& Context::SelectShard()
     {
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-
-            m_peerConnectionFactory = nullptr;
-            m_workerThread->BlockingCall([this]() { m_audioDevice = nullptr; });
-            m_mapClients.clear();
-
-            // check count of refptr to avoid to forget disposing
-            RTC_DCHECK_EQ(m_mapRefPtr.size(), 0);
-
-            m_mapRefPtr.clear();
-            m_mapMediaStreamObserver.clear();
-            m_mapDataChannels.clear();
-            m_mapVideoRenderer.clear();
+        auto it = std::min_element(
+            m_shards.begin(),
+            m_shards.end(),
+            [](const std::unique_ptr<FactoryShard>& a, const std::unique_ptr<FactoryShard>& b)
+            { return a->peerConnectionCount < b->peerConnectionCount; });
+        return **it;
+    }
 
-            m_workerThread->Quit();
-            m_workerThread.reset();
-            m_signalingThread->Quit();
-            m_signalingThread.reset();
-        }
+    std::vector<size_t> Context::GetPeerConnectionCountPerShard() const
+    {
+        std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+        std::vector<size_t> counts;
+        for (const auto& shard : m_shards)
+            counts.push_back(shard->peerConnectionCount);
+        return counts;
     }
 
     rtc::scoped_refptr<MediaStreamInterface> Context::CreateMediaStream(const std::string& streamId)
     {
-        return m_peerConnectionFactory->CreateLocalMediaStream(streamId);
+        return primaryFactory()->CreateLocalMediaStream(streamId);
     }
 
     void Context::RegisterMediaStreamObserver(webrtc::MediaStreamInterface* stream)
     {
+        std::lock_guard<std::mutex> lock(m_mediaStreamObserverMutex);
         m_mapMediaStreamObserver[stream] = std::make_unique<MediaStreamObserver>(stream);
     }
 
     void Context::UnRegisterMediaStreamObserver(webrtc::MediaStreamInterface* stream)
     {
+        std::lock_guard<std::mutex> lock(m_mediaStreamObserverMutex);
         m_mapMediaStreamObserver.erase(stream);
     }
 
     MediaStreamObserver* Context::GetObserver(const webrtc::MediaStreamInterface* stream)
     {
+        std::lock_guard<std::mutex> lock(m_mediaStreamObserverMutex);
         return m_mapMediaStreamObserver[stream].get();
     }
 
@@ -234,7 +474,7 @@ namespace webrtc
     rtc::scoped_refptr<VideoTrackInterface>
     Context::CreateVideoTrack(const std::string& label, VideoTrackSourceInterface* source)
     {
-        return m_peerConnectionFactory->CreateVideoTrack(rtc::scoped_refptr<VideoTrackSourceInterface>(source), label);
+        return primaryFactory()->CreateVideoTrack(rtc::scoped_refptr<VideoTrackSourceInterface>(source), label);
     }
 
     void Context::StopMediaStreamTrack(webrtc::MediaStreamTrackInterface* track)
@@ -255,35 +495,106 @@ namespace webrtc
     rtc::scoped_refptr<AudioTrackInterface>
     Context::CreateAudioTrack(const std::string& label, webrtc::AudioSourceInterface* source)
     {
-        return m_peerConnectionFactory->CreateAudioTrack(label, source);
+        return primaryFactory()->CreateAudioTrack(label, source);
     }
 
     AudioTrackSinkAdapter* Context::CreateAudioTrackSinkAdapter()
     {
-        auto sink = std::make_unique<AudioTrackSinkAdapter>();
+        return CreateAudioTrackSinkAdapter(AudioTrackSinkOptions());
+    }
+
+    AudioTrackSinkAdapter* Context::CreateAudioTrackSinkAdapter(const AudioTrackSinkOptions& options)
+    {
+        auto sink = std::make_unique<AudioTrackSinkAdapter>(m_taskQueueFactory.get(), options);
         AudioTrackSinkAdapter* ptr = sink.get();
+        std::lock_guard<std::mutex> lock(m_audioTrackSinkMutex);
         m_mapAudioTrackAndSink.emplace(ptr, std::move(sink));
         return ptr;
     }
 
-    void Context::DeleteAudioTrackSinkAdapter(AudioTrackSinkAdapter* sink) { m_mapAudioTrackAndSink.erase(sink); }
+    void Context::DeleteAudioTrackSinkAdapter(AudioTrackSinkAdapter* sink)
+    {
+        // The sink waits for its task queue when it is destroyed, which is done
+        // without holding the lock.
+        std::unique_ptr<AudioTrackSinkAdapter> removed;
+        {
+            std::lock_guard<std::mutex> lock(m_audioTrackSinkMutex);
+            auto it = m_mapAudioTrackAndSink.find(sink);
+            if (it == m_mapAudioTrackAndSink.end())
+                return;
+            removed = std::move(it->second);
+            m_mapAudioTrackAndSink.erase(it);
+        }
+    }
+
+    // The settings which reach the encoder through the options of the source.
+    static bool HasSameCodecSettings(const OpusEncoderSettings& a, const OpusEncoderSettings& b)
+    {
+        return a.complexity == b.complexity && a.ptimeMs == b.ptimeMs && a.dtx == b.dtx && a.fec == b.fec;
+    }
+
+    RTCErrorType Context::SetOpusEncoderSettings(
+        PeerConnectionObject* obj,
+        RtpSenderInterface* sender,
+        UnityAudioTrackSource* source,
+        const OpusEncoderSettings& settings)
+    {
+        std::lock_guard<std::mutex> lock(m_opusEncoderSettingsMutex);
+        auto it = m_opusEncoderSettings.find(sender);
+        const OpusEncoderSettings previous =
+            it != m_opusEncoderSettings.end() ? it->second.settings : OpusEncoderSettings();
+
+        const bool codecChanged = !HasSameCodecSettings(previous, settings);
+        if (codecChanged)
+        {
+            // The send stream keeps the options it was configured with.
+            if (sender->ssrc() != 0)
+                return RTCErrorType::INVALID_STATE;
+            for (const auto& pair : m_opusEncoderSettings)
+            {
+                if (pair.first != sender && pair.second.source == source &&
+                    !HasSameCodecSettings(pair.second.settings, settings))
+                    return RTCErrorType::INVALID_MODIFICATION;
+            }
+        }
+
+        if (settings.maxBitrateBps != previous.maxBitrateBps)
+        {
+            RtpParameters parameters = sender->GetParameters();
+            for (auto& encoding : parameters.encodings)
+                encoding.max_bitrate_bps = settings.maxBitrateBps;
+            webrtc::RTCError error = sender->SetParameters(parameters);
+            if (!error.ok())
+                return error.type();
+        }
+
+        if (codecChanged)
+        {
+            OpusEncoderSettings codecSettings = settings;
+            codecSettings.maxBitrateBps = absl::nullopt;
+            source->SetOpusEncoderSettings(codecSettings);
+        }
+        m_opusEncoderSettings[sender] = { obj, source, settings };
+        return RTCErrorType::NONE;
+    }
+
+    void Context::SetAudioPlayoutFormat(int32_t sampleRate, size_t channels)
+    {
+        for (auto& shard : m_shards)
+            shard->audioDevice->SetPlayoutFormat(sampleRate, channels);
+    }
 
     void Context::AddStatsReport(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report)
     {
         std::lock_guard<std::mutex> lock(mutexStatsReport);
-        m_listStatsReport.push_back(report);
+        m_statsReports.Add(report);
     }
 
     const RTCStats** Context::GetStatsList(const RTCStatsReport* report, size_t* length, uint32_t** types)
     {
         std::lock_guard<std::mutex> lock(mutexStatsReport);
 
-        auto result = std::find_if(
-            m_listStatsReport.begin(),
-            m_listStatsReport.end(),
-            [report](rtc::scoped_refptr<const webrtc::RTCStatsReport> it) { return it.get() == report; });
-
-        if (result == m_listStatsReport.end())
+        if (!m_statsReports.Find(report))
         {
             RTC_LOG(LS_INFO) << "Calling GetStatsList is failed. The reference of RTCStatsReport is not found.";
             return nullptr;
@@ -308,21 +619,49 @@ namespace webrtc
         return ret;
     }
 
-    void Context::DeleteStatsReport(const webrtc::RTCStatsReport* report)
+    const uint8_t* Context::GetStatsSnapshot(const RTCStatsReport* report, size_t* length)
     {
         std::lock_guard<std::mutex> lock(mutexStatsReport);
 
-        auto result = std::find_if(
-            m_listStatsReport.begin(),
-            m_listStatsReport.end(),
-            [report](rtc::scoped_refptr<const webrtc::RTCStatsReport> it) { return it.get() == report; });
+        StatsReportRegistry::Entry* entry = m_statsReports.Find(report);
+        if (!entry)
+        {
+            RTC_LOG(LS_INFO) << "Calling GetStatsSnapshot is failed. The reference of RTCStatsReport is not found.";
+            return nullptr;
+        }
+
+        // A written snapshot is never empty since it has the header.
+        if (entry->snapshot.empty())
+            m_statsSnapshotWriter.Write(*report, &entry->snapshot);
+        *length = entry->snapshot.size();
+        return entry->snapshot.data();
+    }
 
-        if (result == m_listStatsReport.end())
+    void Context::DeleteStatsReport(const webrtc::RTCStatsReport* report)
+    {
+        std::lock_guard<std::mutex> lock(mutexStatsReport);
+
+        if (!m_statsReports.Remove(report))
         {
             RTC_LOG(LS_INFO) << "Calling DeleteStatsReport is failed. The reference of RTCStatsReport is not found.";
-            return;
         }
-        m_listStatsReport.erase(result);
+    }
+
+    void Context::SetStatsReportTimeToLive(TimeDelta timeToLive)
+    {
+        std::lock_guard<std::mutex> lock(mutexStatsReport);
+        m_statsReports.SetTimeToLive(timeToLive);
+    }
+
+    StatsReportUsage Context::GetStatsReportUsage()
+    {
+        std::lock_guard<std::mutex> lock(mutexStatsReport);
+
+        StatsReportUsage usage;
+        usage.count = m_statsReports.size();
+        usage.bytes = m_statsReports.memoryUsage();
+        usage.expiredCount = m_statsReports.expiredCount();
+        return usage;
     }
 
     DataChannelInterface*
@@ -343,39 +682,221 @@ namespace webrtc
     void Context::AddDataChannel(rtc::scoped_refptr<DataChannelInterface> channel, PeerConnectionObject& pc)
     {
         auto dataChannelObj = std::make_unique<DataChannelObject>(channel, pc);
+        std::lock_guard<std::mutex> lock(m_dataChannelMutex);
         m_mapDataChannels[channel.get()] = std::move(dataChannelObj);
     }
 
     DataChannelObject* Context::GetDataChannelObject(const DataChannelInterface* channel)
     {
+        std::lock_guard<std::mutex> lock(m_dataChannelMutex);
         return m_mapDataChannels[channel].get();
     }
 
     void Context::DeleteDataChannel(DataChannelInterface* channel)
     {
-        if (m_mapDataChannels.count(channel) > 0)
+        std::unique_ptr<DataChannelObject> obj;
         {
-            m_mapDataChannels.erase(channel);
+            std::lock_guard<std::mutex> lock(m_dataChannelMutex);
+            auto it = m_mapDataChannels.find(channel);
+            if (it == m_mapDataChannels.end())
+                return;
+            obj = std::move(it->second);
+            m_mapDataChannels.erase(it);
         }
     }
 
     PeerConnectionObject* Context::CreatePeerConnection(const webrtc::PeerConnectionInterface::RTCConfiguration& config)
+    {
+        PooledPeerConnection pooled = ClaimPooledPeerConnection(config);
+        if (!pooled.object)
+        {
+            pooled.object = CreatePeerConnectionObject(config, &pooled.shard);
+            if (!pooled.object)
+                return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+        PeerConnectionObject* ptr = pooled.object.get();
+        m_mapClients[ptr] = std::move(pooled.object);
+        m_peerConnectionShards[ptr] = pooled.shard;
+        return ptr;
+    }
+
+    std::unique_ptr<PeerConnectionObject> Context::CreatePeerConnectionObject(
+        const webrtc::PeerConnectionInterface::RTCConfiguration& config, FactoryShard** shard)
     {
         std::unique_ptr<PeerConnectionObject> obj = std::make_unique<PeerConnectionObject>(*this);
         PeerConnectionDependencies dependencies(obj.get());
-        auto result = m_peerConnectionFactory->CreatePeerConnectionOrError(config, std::move(dependencies));
+        {
+            // The shard is reserved before the connection is created, so that
+            // concurrent calls are spread across the shards.
+            std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+            *shard = &SelectShard();
+            (*shard)->peerConnectionCount++;
+        }
+
+        // A connection without a certificate generates one before it gathers
+        // candidates, unless the pool has one ready.
+        webrtc::PeerConnectionInterface::RTCConfiguration configuration = config;
+        if (configuration.certificates.empty())
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            if (m_certificates)
+            {
+                if (auto certificate = m_certificates->Take())
+                    configuration.certificates.push_back(certificate);
+            }
+        }
+
+        auto result = (*shard)->factory->CreatePeerConnectionOrError(configuration, std::move(dependencies));
         if (!result.ok())
         {
+            std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+            (*shard)->peerConnectionCount--;
             RTC_LOG(LS_ERROR) << result.error().message();
             return nullptr;
         }
         obj->connection = result.MoveValue();
-        PeerConnectionObject* ptr = obj.get();
-        m_mapClients[ptr] = std::move(obj);
-        return ptr;
+        return obj;
     }
 
-    void Context::DeletePeerConnection(PeerConnectionObject* obj) { m_mapClients.erase(obj); }
+    void Context::SetPeerConnectionPool(const webrtc::PeerConnectionInterface::RTCConfiguration& config, size_t size)
+    {
+        std::vector<PooledPeerConnection> released;
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            if (config != m_poolConfig)
+            {
+                released.swap(m_pooledConnections);
+                m_poolConfig = config;
+            }
+            while (m_pooledConnections.size() > size)
+            {
+                released.push_back(std::move(m_pooledConnections.back()));
+                m_pooledConnections.pop_back();
+            }
+            m_poolSize = size;
+            // Cancels the warm-up in progress.
+            m_poolGeneration++;
+
+            if (size > 0 && !m_warmupQueue)
+            {
+                m_warmupQueue =
+                    m_taskQueueFactory->CreateTaskQueue("WebRTC Warm-up", TaskQueueFactory::Priority::LOW);
+                m_certificates = std::make_unique<CertificatePool>(m_warmupQueue.get());
+            }
+            if (m_certificates)
+                m_certificates->SetCapacity(size);
+            if (size > 0)
+                m_warmupQueue->PostTask([this, generation = m_poolGeneration]() { FillPeerConnectionPool(generation); });
+        }
+        ReleasePooledPeerConnections(std::move(released));
+    }
+
+    size_t Context::pooledPeerConnectionCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        return m_pooledConnections.size();
+    }
+
+    uint64_t Context::pooledPeerConnectionClaimCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        return m_poolClaimCount;
+    }
+
+    Context::PooledPeerConnection
+    Context::ClaimPooledPeerConnection(const webrtc::PeerConnectionInterface::RTCConfiguration& config)
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (m_pooledConnections.empty() || config != m_poolConfig)
+            return {};
+        PooledPeerConnection pooled = std::move(m_pooledConnections.back());
+        m_pooledConnections.pop_back();
+        m_poolClaimCount++;
+        m_warmupQueue->PostTask([this, generation = m_poolGeneration]() { FillPeerConnectionPool(generation); });
+        return pooled;
+    }
+
+    void Context::FillPeerConnectionPool(uint64_t generation)
+    {
+        while (true)
+        {
+            webrtc::PeerConnectionInterface::RTCConfiguration config;
+            {
+                std::lock_guard<std::mutex> lock(m_poolMutex);
+                if (generation != m_poolGeneration || m_pooledConnections.size() >= m_poolSize)
+                    return;
+                config = m_poolConfig;
+            }
+            PooledPeerConnection pooled;
+            pooled.object = CreatePeerConnectionObject(config, &pooled.shard);
+            if (!pooled.object)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_poolMutex);
+                if (generation == m_poolGeneration && m_pooledConnections.size() < m_poolSize)
+                {
+                    m_pooledConnections.push_back(std::move(pooled));
+                    continue;
+                }
+            }
+            std::vector<PooledPeerConnection> released;
+            released.push_back(std::move(pooled));
+            ReleasePooledPeerConnections(std::move(released));
+            return;
+        }
+    }
+
+    void Context::ReleasePooledPeerConnections(std::vector<PooledPeerConnection> connections)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+            for (auto& pooled : connections)
+                pooled.shard->peerConnectionCount--;
+        }
+        // Closed outside of the locks, since closing waits for the signaling thread.
+        for (auto& pooled : connections)
+            pooled.object->Close();
+    }
+
+    void Context::DeletePeerConnection(PeerConnectionObject* obj)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_opusEncoderSettingsMutex);
+            for (auto it = m_opusEncoderSettings.begin(); it != m_opusEncoderSettings.end();)
+            {
+                if (it->second.connection == obj)
+                    it = m_opusEncoderSettings.erase(it);
+                else
+                    ++it;
+            }
+        }
+        std::unique_ptr<PeerConnectionObject> connection;
+        {
+            std::lock_guard<std::mutex> lock(m_peerConnectionMutex);
+            auto it = m_peerConnectionShards.find(obj);
+            if (it != m_peerConnectionShards.end())
+            {
+                it->second->peerConnectionCount--;
+                m_peerConnectionShards.erase(it);
+            }
+            auto client = m_mapClients.find(obj);
+            if (client == m_mapClients.end())
+                return;
+            connection = std::move(client->second);
+            m_mapClients.erase(client);
+        }
+        // Closing the connection waits for the signaling thread, which must
+        // not be blocked by the registry.
+    }
+
+    DelegateEventsPending Context::s_onEventsPending = nullptr;
+
+    void Context::PushEvent(const EventRecord& record, std::string_view data, std::string_view text)
+    {
+        if (m_eventQueue.Push(record, data, text) && s_onEventsPending)
+            s_onEventsPending(this);
+    }
 
     uint32_t Context::s_rendererId = 0;
     uint32_t Context::GenerateRendererId() { return s_rendererId++; }
@@ -384,26 +905,49 @@ namespace webrtc
     {
         auto rendererId = GenerateRendererId();
         auto renderer = std::make_shared<UnityVideoRenderer>(rendererId, callback, needFlipVertical);
+        std::unique_lock<std::shared_mutex> lock(m_videoRendererMutex);
         m_mapVideoRenderer[rendererId] = renderer;
-        return m_mapVideoRenderer[rendererId].get();
+        return renderer.get();
     }
 
-    std::shared_ptr<UnityVideoRenderer> Context::GetVideoRenderer(uint32_t id) { return m_mapVideoRenderer[id]; }
+    std::shared_ptr<UnityVideoRenderer> Context::GetVideoRenderer(uint32_t id)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_videoRendererMutex);
+        auto it = m_mapVideoRenderer.find(id);
+        return it != m_mapVideoRenderer.end() ? it->second : nullptr;
+    }
+
+    bool Context::TryGetVideoRenderer(uint32_t id, std::shared_ptr<UnityVideoRenderer>* renderer)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_videoRendererMutex, std::try_to_lock);
+        if (!lock.owns_lock())
+            return false;
+        auto it = m_mapVideoRenderer.find(id);
+        *renderer = it != m_mapVideoRenderer.end() ? it->second : nullptr;
+        return true;
+    }
 
     void Context::DeleteVideoRenderer(UnityVideoRenderer* renderer)
     {
-        m_mapVideoRenderer.erase(renderer->GetId());
-        renderer = nullptr;
+        std::shared_ptr<UnityVideoRenderer> removed;
+        {
+            std::unique_lock<std::shared_mutex> lock(m_videoRendererMutex);
+            auto it = m_mapVideoRenderer.find(renderer->GetId());
+            if (it == m_mapVideoRenderer.end())
+                return;
+            removed = std::move(it->second);
+            m_mapVideoRenderer.erase(it);
+        }
     }
 
     void Context::GetRtpSenderCapabilities(cricket::MediaType kind, RtpCapabilities* capabilities) const
     {
-        *capabilities = m_peerConnectionFactory->GetRtpSenderCapabilities(kind);
+        *capabilities = primaryFactory()->GetRtpSenderCapabilities(kind);
     }
 
     void Context::GetRtpReceiverCapabilities(cricket::MediaType kind, RtpCapabilities* capabilities) const
     {
-        *capabilities = m_peerConnectionFactory->GetRtpReceiverCapabilities(kind);
+        *capabilities = primaryFactory()->GetRtpReceiverCapabilities(kind);
     }
 
 } // end namespace webrtc
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "AudioTrackSinkAdapter.h"
+#include "CertificatePool.h"
 #include "DummyAudioDevice.h"
+#include "EventQueue.h"
 #include "GraphicsDevice/IGraphicsDevice.h"
+#include "HandleTable.h"
+#include "MarshalArena.h"
 #include "PeerConnectionObject.h"
+#include "StatsReportRegistry.h"
+#include "StatsSnapshot.h"
+#include "ThreadOptions.h"
+#include "UnityAudioTrackSource.h"
 #include "UnityVideoRenderer.h"
 #include "UnityVideoTrackSource.h"
 
@@ -35,15 +46,60 @@ namespace webrtc
         { "track", 22 }
     };
 
+    // Data format used by the managed code.
+    struct StatsReportUsage
+    {
+        uint64_t count;
+        uint64_t bytes;
+        uint64_t expiredCount;
+    };
+
     class IGraphicsDevice;
     class ProfilerMarkerFactory;
+    class ScopedProfilerThread;
     struct ContextDependencies
     {
-        IGraphicsDevice* device;
-        ProfilerMarkerFactory* profiler;
+        IGraphicsDevice* device = nullptr;
+        ProfilerMarkerFactory* profiler = nullptr;
+        ContextThreadOptions threads;
     };
 
     class Context;
+
+    // Data format used by the managed code.
+    enum class ContextAsyncState : int32_t
+    {
+        kPending = 0,
+        kSucceeded = 1,
+        kFailed = 2,
+    };
+
+    class ContextAsyncOperation;
+    using DelegateContextAsyncCompleted = void (*)(ContextAsyncOperation* operation, ContextAsyncState state);
+
+    // Creation or destruction of a context on the background thread of the
+    // ContextManager. The managed code polls the state, or is notified by the
+    // callback on the background thread.
+    class ContextAsyncOperation : public rtc::RefCountInterface
+    {
+    public:
+        explicit ContextAsyncOperation(DelegateContextAsyncCompleted callback)
+            : m_callback(callback)
+        {
+        }
+        ContextAsyncState state() const { return m_state.load(); }
+        // The created context, set before the state becomes kSucceeded.
+        Context* context() const { return m_context.load(); }
+        void Complete(ContextAsyncState state, Context* context);
+
+    private:
+        DelegateContextAsyncCompleted m_callback;
+        std::atomic<Context*> m_context { nullptr };
+        std::atomic<ContextAsyncState> m_state { ContextAsyncState::kPending };
+    };
+
+    using DelegateEventsPending = void (*)(Context* context);
+
     class MediaStreamObserver;
     class SetSessionDescriptionObserver;
     class ContextManager
@@ -55,14 +111,45 @@ namespace webrtc
         Context* GetContext(int uid) const;
         Context* CreateContext(int uid, ContextDependencies& dependencies);
         void DestroyContext(int uid);
+        // Starting and stopping the threads of a context takes tens of
+        // milliseconds, so these run on a background thread. The operations
+        // run in the order they are requested. The context is unregistered
+        // when DestroyContextAsync returns.
+        rtc::scoped_refptr<ContextAsyncOperation>
+        CreateContextAsync(int uid, const ContextDependencies& dependencies, DelegateContextAsyncCompleted callback);
+        rtc::scoped_refptr<ContextAsyncOperation> DestroyContextAsync(int uid, DelegateContextAsyncCompleted callback);
         void SetCurContext(Context*);
-        bool Exists(Context* context);
+        // Lock-free, so that the render thread can check the context on every
+        // event. The context pointer is not dereferenced.
+        bool Exists(HandleTable::Handle handle, const Context* context) const
+        {
+            return m_contextHandles.Contains(handle, context);
+        }
+        // Called by the render thread around the use of a context and of the
+        // objects validated by handle. Returns false, without beginning the
+        // event, when the context has been destroyed. Contexts and ref
+        // pointers are released after the events in flight have finished,
+        // so the render thread never waits for the main thread.
+        bool BeginRenderEvent(HandleTable::Handle handle, const Context* context);
+        void EndRenderEvent();
+        bool IsRenderEventInFlight() const { return m_renderEventsInFlight.load() > 0; }
         using ContextPtr = std::unique_ptr<Context>;
         Context* curContext = nullptr;
+        // Guards the registered contexts.
         std::mutex mutex;
 
     private:
+        // Returns nullptr when a context with the ID exists.
+        Context* RegisterContext(int uid, ContextPtr context);
+        // Unregisters the context and invalidates its handle.
+        ContextPtr UnregisterContext(int uid);
+        void WaitForRenderEvents() const;
+        rtc::Thread* asyncThread();
+
         std::map<int, ContextPtr> m_contexts;
+        std::unique_ptr<rtc::Thread> m_asyncThread;
+        HandleTable m_contextHandles;
+        std::atomic<int32_t> m_renderEventsInFlight { 0 };
         static std::unique_ptr<ContextManager> s_instance;
     };
 
@@ -72,29 +159,31 @@ namespace webrtc
         explicit Context(ContextDependencies& dependencies);
         ~Context();
 
-        bool ExistsRefPtr(const rtc::RefCountInterface* ptr) const
+        // Handle of the context in the ContextManager.
+        HandleTable::Handle handle() const { return m_handle; }
+        void SetHandle(HandleTable::Handle handle) { m_handle = handle; }
+
+        // Lock-free, so that the render thread can check the objects passed by
+        // the managed code without contending with the main thread.
+        bool ExistsRefPtr(HandleTable::Handle handle, const rtc::RefCountInterface* ptr) const
         {
-            return m_mapRefPtr.find(ptr) != m_mapRefPtr.end();
+            return m_refPtrHandles.Contains(handle, ptr);
         }
+        HandleTable::Handle GetRefPtrHandle(const rtc::RefCountInterface* ptr) const;
         template<typename T>
         void AddRefPtr(rtc::scoped_refptr<T> refptr)
         {
-            m_mapRefPtr.emplace(refptr.get(), refptr);
+            AddRefPtr(rtc::scoped_refptr<rtc::RefCountInterface>(refptr.get()));
         }
-        void AddRefPtr(rtc::RefCountInterface* ptr) { m_mapRefPtr.emplace(ptr, ptr); }
+        void AddRefPtr(rtc::RefCountInterface* ptr) { AddRefPtr(rtc::scoped_refptr<rtc::RefCountInterface>(ptr)); }
+        void AddRefPtr(rtc::scoped_refptr<rtc::RefCountInterface> refptr);
 
         template<typename T>
         void RemoveRefPtr(rtc::scoped_refptr<T>& refptr)
         {
-            std::lock_guard<std::mutex> lock(mutex);
-            m_mapRefPtr.erase(refptr.get());
-        }
-        template<typename T>
-        void RemoveRefPtr(T* ptr)
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            m_mapRefPtr.erase(ptr);
+            RemoveRefPtr(static_cast<const rtc::RefCountInterface*>(refptr.get()));
         }
+        void RemoveRefPtr(const rtc::RefCountInterface* ptr);
 
         // MediaStream
         rtc::scoped_refptr<MediaStreamInterface> CreateMediaStream(const std::string& streamId);
@@ -106,8 +195,21 @@ namespace webrtc
         rtc::scoped_refptr<AudioSourceInterface> CreateAudioSource();
         // Audio Renderer
         AudioTrackSinkAdapter* CreateAudioTrackSinkAdapter();
+        AudioTrackSinkAdapter* CreateAudioTrackSinkAdapter(const AudioTrackSinkOptions& options);
         void DeleteAudioTrackSinkAdapter(AudioTrackSinkAdapter* sink);
 
+        // Keeps the Opus encoder settings of the sender. The maximum bitrate is
+        // applied to the encodings of the sender. The other settings reach the
+        // encoder through the options of the source, which libwebrtc reads when
+        // the send stream of the sender is configured, so they must be set
+        // before the sender is negotiated and be equal for the senders of the
+        // source.
+        RTCErrorType SetOpusEncoderSettings(
+            PeerConnectionObject* obj,
+            RtpSenderInterface* sender,
+            UnityAudioTrackSource* source,
+            const OpusEncoderSettings& settings);
+
         // Video Source
         rtc::scoped_refptr<UnityVideoTrackSource> CreateVideoSource();
 
@@ -121,12 +223,30 @@ namespace webrtc
         // PeerConnection
         PeerConnectionObject* CreatePeerConnection(const webrtc::PeerConnectionInterface::RTCConfiguration& config);
         void DeletePeerConnection(PeerConnectionObject* obj);
+        // Keeps `size` connections created with `config` in the background,
+        // which CreatePeerConnection hands out for an equal configuration.
+        // Their ports and candidates are gathered on creation when the
+        // configuration has an ICE candidate pool, and their DTLS certificates
+        // are generated ahead of time. A size of zero releases the pool.
+        void SetPeerConnectionPool(const webrtc::PeerConnectionInterface::RTCConfiguration& config, size_t size);
+        size_t pooledPeerConnectionCount() const;
+        // Number of connections taken from the pool by `CreatePeerConnection`.
+        uint64_t pooledPeerConnectionClaimCount() const;
 
         // StatsReport
         std::mutex mutexStatsReport;
         void AddStatsReport(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report);
         const RTCStats** GetStatsList(const RTCStatsReport* report, size_t* length, uint32_t** types);
+        // Returns the snapshot of the report, which is valid until the report is deleted.
+        const uint8_t* GetStatsSnapshot(const RTCStatsReport* report, size_t* length);
         void DeleteStatsReport(const webrtc::RTCStatsReport* report);
+        // Reports which the managed code does not access for the time are released.
+        void SetStatsReportTimeToLive(TimeDelta timeToLive);
+        StatsReportUsage GetStatsReportUsage();
+
+        // Memory for the strings and arrays returned to the managed code. The
+        // managed code serializes the calls which use the arena.
+        MarshalArena& marshalArena() { return m_marshalArena; }
 
         // DataChannel
         DataChannelInterface*
@@ -138,6 +258,9 @@ namespace webrtc
         // Renderer
         UnityVideoRenderer* CreateVideoRenderer(DelegateVideoFrameResize callback, bool needFlipVertical);
         std::shared_ptr<UnityVideoRenderer> GetVideoRenderer(uint32_t id);
+        // Does not wait for the registry, so that the render thread does not
+        // block while the main thread creates or deletes a renderer.
+        bool TryGetVideoRenderer(uint32_t id, std::shared_ptr<UnityVideoRenderer>* renderer);
         void DeleteVideoRenderer(UnityVideoRenderer* renderer);
 
         // RtpSender
@@ -147,25 +270,123 @@ namespace webrtc
         void GetRtpReceiverCapabilities(cricket::MediaType kind, RtpCapabilities* capabilities) const;
 
         // AudioDevice
-        rtc::scoped_refptr<DummyAudioDevice> GetAudioDevice() const { return m_audioDevice; }
+        rtc::scoped_refptr<DummyAudioDevice> GetAudioDevice() const { return m_shards.front()->audioDevice; }
+        void SetAudioPlayoutFormat(int32_t sampleRate, size_t channels);
 
-        // mutex;
-        std::mutex mutex;
+        // Factory shards
+        size_t shardCount() const { return m_shards.size(); }
+        std::vector<size_t> GetPeerConnectionCountPerShard() const;
+
+        // Events of the observers, which the managed code drains on the main
+        // thread. The callback is called on the thread of the first event
+        // pushed after each drain, so that the managed code schedules a drain.
+        void PushEvent(const EventRecord& record, std::string_view data = {}, std::string_view text = {});
+        int32_t DrainEvents(const EventRecord** records) { return m_eventQueue.Drain(records); }
+        static void RegisterOnEventsPending(DelegateEventsPending callback) { s_onEventsPending = callback; }
+
+        // Render events skipped because a registry they read was locked.
+        uint64_t skippedRenderEventCount() const { return m_skippedRenderEvents.load(std::memory_order_relaxed); }
+        void OnRenderEventSkipped() { m_skippedRenderEvents.fetch_add(1, std::memory_order_relaxed); }
 
     private:
-        std::unique_ptr<rtc::Thread> m_workerThread;
+        // A peer connection factory with its own network and worker threads.
+        // Shards share the signaling thread, so the tracks and sources created
+        // by the first shard can be added to peer connections of any shard.
+        // Their proxies forward the calls to the threads of the first shard.
+        struct FactoryShard
+        {
+            // Null when the worker thread is used as the network thread.
+            std::unique_ptr<rtc::Thread> networkThread;
+            std::unique_ptr<rtc::Thread> workerThread;
+            rtc::scoped_refptr<DummyAudioDevice> audioDevice;
+            rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+            size_t peerConnectionCount = 0;
+        };
+
+        void StartThread(
+            rtc::Thread* thread, const char* name, const ThreadOptions& options, ProfilerMarkerFactory* profiler);
+        std::unique_ptr<FactoryShard> CreateShard(
+            int32_t index,
+            const ContextDependencies& dependencies,
+            rtc::scoped_refptr<AudioEncoderFactory> audioEncoderFactory,
+            rtc::scoped_refptr<AudioDecoderFactory> audioDecoderFactory);
+        // Peer connections are placed on the shard with the fewest connections.
+        // Requires m_peerConnectionMutex.
+        FactoryShard& SelectShard();
+        struct PooledPeerConnection
+        {
+            std::unique_ptr<PeerConnectionObject> object;
+            FactoryShard* shard = nullptr;
+        };
+        // Counts the connection on its shard until it is released.
+        std::unique_ptr<PeerConnectionObject>
+        CreatePeerConnectionObject(const webrtc::PeerConnectionInterface::RTCConfiguration& config, FactoryShard** shard);
+        PooledPeerConnection ClaimPooledPeerConnection(const webrtc::PeerConnectionInterface::RTCConfiguration& config);
+        // Runs on m_warmupQueue. Stops when the pool is changed.
+        void FillPeerConnectionPool(uint64_t generation);
+        void ReleasePooledPeerConnections(std::vector<PooledPeerConnection> connections);
+        // Releases the ref pointers removed while a render event was in flight.
+        void ReleaseDeferredRefPtrs();
+        // Creates the tracks, sources and streams shared by all shards.
+        webrtc::PeerConnectionFactoryInterface* primaryFactory() const { return m_shards.front()->factory.get(); }
+
+        // Destroyed after the objects whose observers push events.
+        EventQueue m_eventQueue;
         std::unique_ptr<rtc::Thread> m_signalingThread;
         std::unique_ptr<TaskQueueFactory> m_taskQueueFactory;
-        rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> m_peerConnectionFactory;
-        rtc::scoped_refptr<DummyAudioDevice> m_audioDevice;
-        std::vector<rtc::scoped_refptr<const webrtc::RTCStatsReport>> m_listStatsReport;
+        std::vector<std::unique_ptr<const ScopedProfilerThread>> m_profilerThreads;
+        std::vector<std::unique_ptr<FactoryShard>> m_shards;
+
+        // Each registry has its own lock, so that unrelated calls do not
+        // serialize and the render thread only contends with the registry
+        // it reads. m_peerConnectionMutex guards the shard counts as well as
+        // m_peerConnectionShards and m_mapClients.
+        mutable std::mutex m_peerConnectionMutex;
+        std::map<const PeerConnectionObject*, FactoryShard*> m_peerConnectionShards;
+        // m_poolMutex guards the pool, and the queue and the certificates
+        // which are created with the first pool.
+        mutable std::mutex m_poolMutex;
+        webrtc::PeerConnectionInterface::RTCConfiguration m_poolConfig;
+        size_t m_poolSize = 0;
+        uint64_t m_poolGeneration = 0;
+        uint64_t m_poolClaimCount = 0;
+        std::vector<PooledPeerConnection> m_pooledConnections;
+        std::unique_ptr<TaskQueueBase, TaskQueueDeleter> m_warmupQueue;
+        std::unique_ptr<CertificatePool> m_certificates;
+        StatsReportRegistry m_statsReports;
+        StatsSnapshotWriter m_statsSnapshotWriter;
+        MarshalArena m_marshalArena;
         std::map<const PeerConnectionObject*, std::unique_ptr<PeerConnectionObject>> m_mapClients;
+        std::mutex m_mediaStreamObserverMutex;
         std::map<const webrtc::MediaStreamInterface*, std::unique_ptr<MediaStreamObserver>> m_mapMediaStreamObserver;
+        std::mutex m_dataChannelMutex;
         std::map<const DataChannelInterface*, std::unique_ptr<DataChannelObject>> m_mapDataChannels;
+        std::shared_mutex m_videoRendererMutex;
         std::map<const uint32_t, std::shared_ptr<UnityVideoRenderer>> m_mapVideoRenderer;
+        std::mutex m_audioTrackSinkMutex;
         std::map<const AudioTrackSinkAdapter*, std::unique_ptr<AudioTrackSinkAdapter>> m_mapAudioTrackAndSink;
-        std::map<const rtc::RefCountInterface*, rtc::scoped_refptr<rtc::RefCountInterface>> m_mapRefPtr;
+        struct SenderOpusEncoderSettings
+        {
+            const PeerConnectionObject* connection;
+            const UnityAudioTrackSource* source;
+            OpusEncoderSettings settings;
+        };
+        // Removed with the connection of the sender.
+        std::mutex m_opusEncoderSettingsMutex;
+        std::map<const RtpSenderInterface*, SenderOpusEncoderSettings> m_opusEncoderSettings;
+        struct RefPtrEntry
+        {
+            rtc::scoped_refptr<rtc::RefCountInterface> refptr;
+            HandleTable::Handle handle;
+        };
+        mutable std::mutex m_refPtrMutex;
+        std::unordered_map<const rtc::RefCountInterface*, RefPtrEntry> m_mapRefPtr;
+        std::vector<rtc::scoped_refptr<rtc::RefCountInterface>> m_deferredRefPtrs;
+        HandleTable m_refPtrHandles;
+        std::atomic<uint64_t> m_skippedRenderEvents { 0 };
+        HandleTable::Handle m_handle = HandleTable::kInvalidHandle;
 
+        static DelegateEventsPending s_onEventsPending;
         static uint32_t s_rendererId;
         static uint32_t GenerateRendererId();
     };
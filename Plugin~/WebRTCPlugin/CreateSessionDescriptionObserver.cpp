@@ -22,9 +22,12 @@ namespace webrtc
 
     void CreateSessionDescriptionObserver::OnSuccess(SessionDescriptionInterface* desc)
     {
+        // The observer takes the ownership of the description.
+        std::unique_ptr<SessionDescriptionInterface> description(desc);
         std::string out;
-        desc->ToString(&out);
-        const auto sdpType = ConvertSdpType(desc->GetType());
+        description->ToString(&out);
+        const auto sdpType = ConvertSdpType(description->GetType());
+        m_connection->OnSessionDescriptionCreated(std::move(description), out);
         s_createSessionDescCallback(m_connection, this, sdpType, out.c_str(), RTCErrorType::NONE, nullptr);
     }
 
@@ -0,0 +1,167 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "DataChannelChunker.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        void WriteUint32(uint8_t* dst, uint32_t value)
+        {
+            dst[0] = static_cast<uint8_t>(value);
+            dst[1] = static_cast<uint8_t>(value >> 8);
+            dst[2] = static_cast<uint8_t>(value >> 16);
+            dst[3] = static_cast<uint8_t>(value >> 24);
+        }
+
+        uint32_t ReadUint32(const uint8_t* src)
+        {
+            return static_cast<uint32_t>(src[0]) | static_cast<uint32_t>(src[1]) << 8 |
+                static_cast<uint32_t>(src[2]) << 16 | static_cast<uint32_t>(src[3]) << 24;
+        }
+    } // namespace
+
+    DataChannelChunker::DataChannelChunker(size_t chunkSize)
+        : chunkSize_(chunkSize)
+    {
+        RTC_DCHECK_GT(chunkSize_, 0);
+    }
+
+    void DataChannelChunker::Enqueue(const DataBuffer& message)
+    {
+        RTC_DCHECK_LE(message.size(), UINT32_MAX);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({ message, nextId_++, 0 });
+        pendingBytes_ += message.size();
+    }
+
+    bool DataChannelChunker::Next(DataBuffer* chunk)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+            return false;
+
+        OutgoingMessage& outgoing = queue_.front();
+        const size_t size = outgoing.message.size();
+        const size_t payloadSize = std::min(chunkSize_, size - outgoing.offset);
+
+        rtc::CopyOnWriteBuffer buffer(kChunkHeaderSize + payloadSize);
+        uint8_t* data = buffer.MutableData();
+        data[0] = kChunkVersion;
+        data[1] = outgoing.message.binary ? kChunkFlagBinary : 0;
+        data[2] = 0;
+        data[3] = 0;
+        WriteUint32(data + 4, outgoing.id);
+        WriteUint32(data + 8, static_cast<uint32_t>(size));
+        WriteUint32(data + 12, static_cast<uint32_t>(outgoing.offset));
+        if (payloadSize > 0)
+            std::memcpy(data + kChunkHeaderSize, outgoing.message.data.cdata() + outgoing.offset, payloadSize);
+
+        // Chunks are always binary, the original type is kept in the header.
+        *chunk = DataBuffer(buffer, true);
+
+        outgoing.offset += payloadSize;
+        pendingBytes_ -= payloadSize;
+        if (outgoing.offset < size)
+            queue_.push_back(std::move(outgoing));
+        queue_.pop_front();
+        return true;
+    }
+
+    DataChannelReassembler::DataChannelReassembler(size_t maxMessageSize)
+        : maxMessageSize_(maxMessageSize)
+    {
+    }
+
+    bool DataChannelReassembler::Push(const DataBuffer& chunk, DataBuffer* message)
+    {
+        const uint8_t* data = chunk.data.cdata();
+        if (chunk.size() < kChunkHeaderSize || data[0] != kChunkVersion)
+        {
+            RTC_LOG(LS_WARNING) << "Invalid chunk.";
+            return false;
+        }
+        const bool binary = (data[1] & kChunkFlagBinary) != 0;
+        const uint32_t id = ReadUint32(data + 4);
+        const size_t size = ReadUint32(data + 8);
+        const size_t offset = ReadUint32(data + 12);
+        const size_t payloadSize = chunk.size() - kChunkHeaderSize;
+        if (offset + payloadSize > size || (payloadSize == 0 && size > 0))
+        {
+            RTC_LOG(LS_WARNING) << "Invalid chunk.";
+            return false;
+        }
+        if (size > maxMessageSize_)
+        {
+            RTC_LOG(LS_WARNING) << "Dropped a chunk of a message of " << size << " bytes.";
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Messages which fit in a chunk are passed without copying.
+        if (payloadSize == size && offset == 0)
+        {
+            *message = DataBuffer(chunk.data.Slice(kChunkHeaderSize, payloadSize), binary);
+            return true;
+        }
+
+        auto it = pending_.find(id);
+        if (it == pending_.end())
+        {
+            if (pending_.size() >= kMaxPendingMessages)
+            {
+                RTC_LOG(LS_WARNING) << "Dropped an incomplete message.";
+                pending_.erase(pending_.begin());
+            }
+            it = pending_.emplace(id, IncomingMessage { AcquireBuffer(size), binary, 0, {} }).first;
+        }
+
+        IncomingMessage& incoming = it->second;
+        if (incoming.buffer.size() != size)
+        {
+            RTC_LOG(LS_WARNING) << "Invalid chunk.";
+            return false;
+        }
+        auto next = incoming.receivedChunks.lower_bound(offset);
+        if ((next != incoming.receivedChunks.end() && next->first < offset + payloadSize) ||
+            (next != incoming.receivedChunks.begin() && std::prev(next)->first + std::prev(next)->second > offset))
+        {
+            RTC_LOG(LS_WARNING) << "Ignored a chunk which was already received.";
+            return false;
+        }
+        incoming.receivedChunks.emplace_hint(next, offset, payloadSize);
+        std::memcpy(incoming.buffer.MutableData() + offset, data + kChunkHeaderSize, payloadSize);
+        incoming.receivedSize += payloadSize;
+        if (incoming.receivedSize < size)
+            return false;
+
+        *message = DataBuffer(incoming.buffer, incoming.binary);
+        if (pool_.size() < kMaxPooledBuffers)
+            pool_.push_back(std::move(incoming.buffer));
+        pending_.erase(it);
+        return true;
+    }
+
+    rtc::CopyOnWriteBuffer DataChannelReassembler::AcquireBuffer(size_t size)
+    {
+        if (pool_.empty())
+            return rtc::CopyOnWriteBuffer(size);
+
+        rtc::CopyOnWriteBuffer buffer = std::move(pool_.back());
+        pool_.pop_back();
+        // `Clear` detaches the storage when the previous message is still in use.
+        buffer.Clear();
+        buffer.SetSize(size);
+        return buffer;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <api/data_channel_interface.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Framing layer which splits messages into chunks so that large messages
+    // do not exceed the message size limit of SCTP nor block small messages
+    // behind them. Both peers need to enable it.
+    //
+    // Each chunk starts with a header in little endian:
+    //   uint8  version
+    //   uint8  flags (kChunkFlagBinary)
+    //   uint16 reserved
+    //   uint32 message id
+    //   uint32 message size
+    //   uint32 offset of the chunk in the message
+    constexpr size_t kChunkHeaderSize = 16;
+    constexpr uint8_t kChunkVersion = 1;
+    constexpr uint8_t kChunkFlagBinary = 1 << 0;
+
+    class DataChannelChunker
+    {
+    public:
+        static constexpr size_t kDefaultChunkSize = 16 * 1024;
+
+        explicit DataChannelChunker(size_t chunkSize = kDefaultChunkSize);
+        DataChannelChunker(const DataChannelChunker&) = delete;
+        DataChannelChunker& operator=(const DataChannelChunker&) = delete;
+
+        void Enqueue(const DataBuffer& message);
+
+        // Takes the next chunk, visiting the queued messages in round-robin
+        // order so that a small message waits for at most one chunk of each
+        // large message. Returns false when no message is queued.
+        bool Next(DataBuffer* chunk);
+
+        size_t chunkSize() const { return chunkSize_; }
+        size_t pendingMessages() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return queue_.size();
+        }
+        // Bytes of the queued messages which are not taken as chunks yet.
+        size_t pendingBytes() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pendingBytes_;
+        }
+
+    private:
+        struct OutgoingMessage
+        {
+            DataBuffer message;
+            uint32_t id;
+            size_t offset;
+        };
+
+        const size_t chunkSize_;
+        mutable std::mutex mutex_;
+        std::deque<OutgoingMessage> queue_;
+        size_t pendingBytes_ = 0;
+        uint32_t nextId_ = 0;
+    };
+
+    class DataChannelReassembler
+    {
+    public:
+        // Messages which are partially received when this count is exceeded are
+        // dropped, for channels whose chunks may be lost.
+        static constexpr size_t kMaxPendingMessages = 64;
+        static constexpr size_t kMaxPooledBuffers = 4;
+        // The message size in a chunk header comes from the remote peer, so
+        // larger messages are dropped instead of being allocated.
+        static constexpr size_t kDefaultMaxMessageSize = 64 * 1024 * 1024;
+
+        explicit DataChannelReassembler(size_t maxMessageSize = kDefaultMaxMessageSize);
+        DataChannelReassembler(const DataChannelReassembler&) = delete;
+        DataChannelReassembler& operator=(const DataChannelReassembler&) = delete;
+
+        // Returns true when `chunk` completes a message. The message shares the
+        // storage of a pooled buffer which is reused after `message` is released.
+        bool Push(const DataBuffer& chunk, DataBuffer* message);
+
+        size_t pendingMessages() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pending_.size();
+        }
+
+    private:
+        struct IncomingMessage
+        {
+            rtc::CopyOnWriteBuffer buffer;
+            bool binary;
+            size_t receivedSize;
+            // Offset and size of the received chunks, so that a chunk received
+            // twice or overlapping another one is not counted again.
+            std::map<size_t, size_t> receivedChunks;
+        };
+
+        rtc::CopyOnWriteBuffer AcquireBuffer(size_t size);
+
+        const size_t maxMessageSize_;
+        mutable std::mutex mutex_;
+        std::map<uint32_t, IncomingMessage> pending_;
+        std::vector<rtc::CopyOnWriteBuffer> pool_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#include "DataChannelFlowControl.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    DataChannelFlowControl::DataChannelFlowControl(DataChannelInterface* channel)
+        : channel_(channel)
+    {
+        RTC_DCHECK(channel_);
+    }
+
+    void DataChannelFlowControl::SetSendQueueLimit(uint64_t limit)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queueLimit_ = limit;
+    }
+
+    uint64_t DataChannelFlowControl::sendQueueLimit() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queueLimit_;
+    }
+
+    uint64_t DataChannelFlowControl::queuedAmount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queuedAmount_;
+    }
+
+    bool DataChannelFlowControl::Send(const DataBuffer& buffer)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (queueLimit_ == 0)
+        {
+            lock.unlock();
+            return channel_->Send(buffer);
+        }
+
+        if (sending_ || !queue_.empty())
+        {
+            if (queuedAmount_ + buffer.size() > queueLimit_)
+                return false;
+            queue_.push_back(buffer);
+            queuedAmount_ += buffer.size();
+            if (sending_)
+            {
+                retry_ = true;
+                return true;
+            }
+            sending_ = true;
+            DrainQueue(lock);
+            return true;
+        }
+
+        sending_ = true;
+        lock.unlock();
+        const bool canSend = CanSend(buffer.size());
+        bool result = canSend && channel_->Send(buffer);
+        lock.lock();
+
+        if (!canSend && queuedAmount_ + buffer.size() <= queueLimit_)
+        {
+            // Messages queued by other threads in the meantime follow this one.
+            queue_.push_front(buffer);
+            queuedAmount_ += buffer.size();
+            result = true;
+        }
+        DrainQueue(lock);
+        return result;
+    }
+
+    bool DataChannelFlowControl::OnBufferedAmountChange(uint64_t sentDataSize)
+    {
+        SendQueuedMessages();
+
+        // Moving messages from the queue to the channel does not change the
+        // amount, so only the sent data counts as the decrease.
+        uint64_t amount = channel_->buffered_amount();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            amount += queuedAmount_;
+        }
+        const uint64_t threshold = threshold_;
+        return amount + sentDataSize > threshold && amount <= threshold;
+    }
+
+    bool DataChannelFlowControl::CanSend(size_t size) const
+    {
+        return channel_->buffered_amount() + size <= DataChannelInterface::MaxSendQueueSize();
+    }
+
+    void DataChannelFlowControl::SendQueuedMessages()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (sending_)
+        {
+            retry_ = true;
+            return;
+        }
+        sending_ = true;
+        DrainQueue(lock);
+    }
+
+    void DataChannelFlowControl::DrainQueue(std::unique_lock<std::mutex>& lock)
+    {
+        RTC_DCHECK(sending_);
+
+        do
+        {
+            retry_ = false;
+            while (!queue_.empty())
+            {
+                // Other threads only append to the queue while sending_ is set.
+                const size_t size = queue_.front().size();
+                lock.unlock();
+                const bool canSend = CanSend(size);
+                lock.lock();
+                if (!canSend)
+                    break;
+
+                DataBuffer buffer = std::move(queue_.front());
+                queue_.pop_front();
+                queuedAmount_ -= size;
+                lock.unlock();
+                const bool sent = channel_->Send(buffer);
+                lock.lock();
+                if (!sent)
+                {
+                    RTC_LOG(LS_WARNING) << "Failed to send a queued message.";
+                    break;
+                }
+            }
+        } while (retry_);
+        sending_ = false;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include <api/data_channel_interface.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Keeps the send buffer of the data channel from overflowing, which closes
+    // the channel. When the send queue is enabled, messages which do not fit
+    // in the send buffer are kept natively and sent as the buffered amount
+    // falls, so the managed code does not need to poll the buffered amount.
+    class DataChannelFlowControl
+    {
+    public:
+        explicit DataChannelFlowControl(DataChannelInterface* channel);
+        DataChannelFlowControl(const DataChannelFlowControl&) = delete;
+        DataChannelFlowControl& operator=(const DataChannelFlowControl&) = delete;
+
+        void SetBufferedAmountLowThreshold(uint64_t threshold) { threshold_ = threshold; }
+        uint64_t bufferedAmountLowThreshold() const { return threshold_; }
+
+        // Zero disables the send queue.
+        void SetSendQueueLimit(uint64_t limit);
+        uint64_t sendQueueLimit() const;
+        uint64_t queuedAmount() const;
+
+        // Returns false when the message is neither sent nor queued.
+        bool Send(const DataBuffer& buffer);
+
+        // Returns true when the amount of data buffered in the channel and the
+        // send queue falls to or below the threshold.
+        bool OnBufferedAmountChange(uint64_t sentDataSize);
+
+    private:
+        bool CanSend(size_t size) const;
+        void SendQueuedMessages();
+        // Requires `lock` on mutex_ and sending_ set by the caller, and clears
+        // sending_.
+        void DrainQueue(std::unique_lock<std::mutex>& lock);
+
+        DataChannelInterface* channel_;
+        std::atomic<uint64_t> threshold_ { 0 };
+
+        // The channel is a proxy whose methods block on the signaling thread,
+        // which is the thread `OnBufferedAmountChange` is called on, so the
+        // mutex is never held while calling the channel. Only the thread which
+        // set `sending_` sends messages from the queue, which keeps them in
+        // order, and `retry_` tells it that the queue or the buffered amount
+        // changed in the meantime.
+        mutable std::mutex mutex_;
+        std::deque<DataBuffer> queue_;
+        uint64_t queuedAmount_ = 0;
+        uint64_t queueLimit_ = 0;
+        bool sending_ = false;
+        bool retry_ = false;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
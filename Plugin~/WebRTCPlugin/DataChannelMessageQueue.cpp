@@ -0,0 +1,49 @@
+#include "pch.h"
+
+#include "DataChannelMessageQueue.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    bool DataChannelMessageQueue::Push(const DataBuffer& buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (capacity_ != 0 && writing_.data.size() + buffer.size() > capacity_)
+        {
+            droppedCount_++;
+            return false;
+        }
+
+        DataChannelMessageIndex index;
+        index.offset = static_cast<int32_t>(writing_.data.size());
+        index.length = static_cast<int32_t>(buffer.size());
+        index.binary = buffer.binary ? 1 : 0;
+        writing_.index.push_back(index);
+        writing_.data.insert(writing_.data.end(), buffer.data.cdata(), buffer.data.cdata() + buffer.size());
+        return true;
+    }
+
+    int32_t DataChannelMessageQueue::Drain(const uint8_t** data, const DataChannelMessageIndex** index)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::swap(writing_, reading_);
+        writing_.data.clear();
+        writing_.index.clear();
+
+        *data = reading_.data.data();
+        *index = reading_.index.data();
+        return static_cast<int32_t>(reading_.index.size());
+    }
+
+    void DataChannelMessageQueue::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_.data.clear();
+        writing_.index.clear();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <api/data_channel_interface.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Data format used by the managed code.
+    struct DataChannelMessageIndex
+    {
+        int32_t offset;
+        int32_t length;
+        int32_t binary;
+    };
+
+    // Queues received messages into a packed byte array so that the managed
+    // code drains all of them with one call per frame. Two batches are swapped
+    // on draining, so the memory of the drained batch stays valid until the
+    // next call and neither batch allocates once it has grown large enough.
+    // The bytes of messages queued between two drains are bounded by the
+    // capacity, and messages over it are dropped, so the queue does not grow
+    // without limit while the managed code stops draining it.
+    class DataChannelMessageQueue
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 16 * 1024 * 1024;
+
+        DataChannelMessageQueue() = default;
+        DataChannelMessageQueue(const DataChannelMessageQueue&) = delete;
+        DataChannelMessageQueue& operator=(const DataChannelMessageQueue&) = delete;
+
+        // Returns false when the message is dropped because the queue is full.
+        bool Push(const DataBuffer& buffer);
+        int32_t Drain(const uint8_t** data, const DataChannelMessageIndex** index);
+        void Clear();
+
+        // Zero removes the limit. Messages already queued are kept.
+        void SetCapacity(size_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            capacity_ = capacity;
+        }
+        size_t capacity() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return capacity_;
+        }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return writing_.index.size();
+        }
+        uint64_t droppedCount() const { return droppedCount_; }
+
+    private:
+        struct Batch
+        {
+            std::vector<uint8_t> data;
+            std::vector<DataChannelMessageIndex> index;
+        };
+
+        mutable std::mutex mutex_;
+        Batch writing_;
+        Batch reading_;
+        size_t capacity_ = kDefaultCapacity;
+        std::atomic<uint64_t> droppedCount_ { 0 };
+    };
+
+} // end namespace webrtc
+} // end namespace unity
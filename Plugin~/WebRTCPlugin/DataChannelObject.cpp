@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include "Context.h"
 #include "DataChannelObject.h"
 
 namespace unity
@@ -10,10 +11,8 @@ namespace webrtc
     DataChannelObject::DataChannelObject(
         rtc::scoped_refptr<webrtc::DataChannelInterface> channel, PeerConnectionObject& pc)
         : dataChannel(channel)
-        , onMessage(nullptr)
-        , onOpen(nullptr)
-        , onClose(nullptr)
-        , onError(nullptr)
+        , context_(pc.context)
+        , flowControl_(channel.get())
     {
         dataChannel->RegisterObserver(this);
     }
@@ -27,9 +26,15 @@ namespace webrtc
             dataChannel->Close();
         }
         dataChannel = nullptr;
-        onClose = nullptr;
-        onOpen = nullptr;
-        onMessage = nullptr;
+    }
+
+    void DataChannelObject::PushEvent(EventType type, int32_t value, std::string_view data)
+    {
+        EventRecord record = {};
+        record.type = type;
+        record.value = value;
+        record.sender = dataChannel.get();
+        context_.PushEvent(record, data);
     }
 
     void DataChannelObject::OnStateChange()
@@ -38,26 +43,15 @@ namespace webrtc
         switch (state)
         {
         case webrtc::DataChannelInterface::kOpen:
-            if (onOpen)
-                onOpen(dataChannel.get());
+            PushEvent(EventType::DataChannelOpen);
             break;
         case webrtc::DataChannelInterface::kClosed:
         {
             RTCError error = dataChannel->error();
             if (error.type() == RTCErrorType::NONE)
-            {
-                if (onClose)
-                    onClose(dataChannel.get());
-            }
+                PushEvent(EventType::DataChannelClose);
             else
-            {
-                if (onError)
-                    onError(
-                        dataChannel.get(),
-                        error.type(),
-                        error.message(),
-                        static_cast<int32_t>(std::strlen(error.message())));
-            }
+                PushEvent(EventType::DataChannelError, static_cast<int32_t>(error.type()), error.message());
             break;
         }
         case webrtc::DataChannelInterface::kConnecting:
@@ -65,16 +59,161 @@ namespace webrtc
             break;
         }
     }
-    void DataChannelObject::OnMessage(const webrtc::DataBuffer& buffer)
+    uint8_t* DataChannelObject::LeaseSendBuffer(size_t capacity, rtc::CopyOnWriteBuffer** lease)
+    {
+        rtc::CopyOnWriteBuffer* buffer = sendBufferPool_.Lease(capacity);
+        *lease = buffer;
+        return buffer->MutableData();
+    }
+
+    bool DataChannelObject::CommitSendBuffer(rtc::CopyOnWriteBuffer* lease, size_t length)
     {
-        if (onMessage)
+        if (!sendBufferPool_.IsLeased(lease) || length > lease->size())
         {
-            size_t size = buffer.data.size();
-            if (onMessage != nullptr)
+            RTC_LOG(LS_ERROR) << "Invalid send buffer.";
+            return false;
+        }
+        lease->SetSize(length);
+        // DataBuffer shares the storage of the leased buffer.
+        bool result = Send(webrtc::DataBuffer(*lease, true));
+        sendBufferPool_.Return(lease);
+        return result;
+    }
+
+    void DataChannelObject::CancelSendBuffer(rtc::CopyOnWriteBuffer* lease) { sendBufferPool_.Return(lease); }
+
+    bool DataChannelObject::Send(const webrtc::DataBuffer& buffer)
+    {
+        std::shared_ptr<DataChannelChunker> chunker;
+        {
+            std::lock_guard<std::mutex> lock(chunkMutex_);
+            chunker = chunker_;
+        }
+        if (!chunker)
+            return flowControl_.Send(buffer);
+
+        // The chunker keeps the message until it is pumped, so the checks of
+        // the channel are done here instead.
+        if (dataChannel->state() != webrtc::DataChannelInterface::kOpen)
+            return false;
+        const uint64_t limit = flowControl_.sendQueueLimit();
+        if (limit != 0 && chunker->pendingBytes() + flowControl_.queuedAmount() + buffer.size() > limit)
+            return false;
+        chunker->Enqueue(buffer);
+        PumpChunks();
+        return true;
+    }
+
+    void DataChannelObject::SetChunking(bool enabled, size_t chunkSize)
+    {
+        std::lock_guard<std::mutex> lock(chunkMutex_);
+        if (!enabled)
+        {
+            chunker_ = nullptr;
+            failedChunk_ = std::nullopt;
+            reassembler_ = nullptr;
+            return;
+        }
+        if (chunker_ && chunker_->chunkSize() == chunkSize)
+            return;
+        chunker_ = std::make_shared<DataChannelChunker>(chunkSize);
+        failedChunk_ = std::nullopt;
+        if (!reassembler_)
+            reassembler_ = std::make_unique<DataChannelReassembler>();
+    }
+
+    void DataChannelObject::PumpChunks()
+    {
+        std::unique_lock<std::mutex> lock(chunkMutex_);
+        if (pumpingChunks_)
+        {
+            pumpAgain_ = true;
+            return;
+        }
+        pumpingChunks_ = true;
+
+        webrtc::DataBuffer next(rtc::CopyOnWriteBuffer(), true);
+        do
+        {
+            pumpAgain_ = false;
+            const std::shared_ptr<DataChannelChunker> chunker = chunker_;
+            if (!chunker)
+                break;
+            std::optional<webrtc::DataBuffer> chunk = std::move(failedChunk_);
+            failedChunk_ = std::nullopt;
+
+            lock.unlock();
+            bool failed = false;
+            while (dataChannel->buffered_amount() + flowControl_.queuedAmount() < kChunkSendWindow)
             {
-                onMessage(dataChannel.get(), buffer.data.data(), static_cast<int32_t>(size));
+                if (!chunk)
+                {
+                    if (!chunker->Next(&next))
+                        break;
+                    chunk = std::move(next);
+                }
+                if (!flowControl_.Send(*chunk))
+                {
+                    RTC_LOG(LS_WARNING) << "Failed to send a chunk, which is retried on the next pump.";
+                    failed = true;
+                    break;
+                }
+                chunk = std::nullopt;
             }
+            lock.lock();
+
+            // Dropping the chunk would corrupt the message on the remote peer,
+            // so it is kept unless the chunker has been replaced.
+            if (chunk && chunker == chunker_)
+                failedChunk_ = std::move(chunk);
+            if (failed)
+                break;
+        } while (pumpAgain_);
+        pumpingChunks_ = false;
+    }
+
+    void DataChannelObject::SetBatchedReceive(bool enabled)
+    {
+        batchedReceive_ = enabled;
+        if (!enabled)
+            receiveQueue_.Clear();
+    }
+
+    void DataChannelObject::OnBufferedAmountChange(uint64_t sent_data_size)
+    {
+        bool low = flowControl_.OnBufferedAmountChange(sent_data_size);
+        PumpChunks();
+        if (low)
+            PushEvent(EventType::DataChannelBufferedAmountLow);
+    }
+
+    void DataChannelObject::OnMessage(const webrtc::DataBuffer& buffer)
+    {
+        std::unique_lock<std::mutex> lock(chunkMutex_);
+        if (!reassembler_)
+        {
+            lock.unlock();
+            DeliverMessage(buffer);
+            return;
+        }
+        webrtc::DataBuffer message(rtc::CopyOnWriteBuffer(), true);
+        bool completed = reassembler_->Push(buffer, &message);
+        lock.unlock();
+        if (completed)
+            DeliverMessage(message);
+    }
+
+    void DataChannelObject::DeliverMessage(const webrtc::DataBuffer& buffer)
+    {
+        if (batchedReceive_)
+        {
+            receiveQueue_.Push(buffer);
+            return;
         }
+        PushEvent(
+            EventType::DataChannelMessage,
+            buffer.binary ? 1 : 0,
+            std::string_view(reinterpret_cast<const char*>(buffer.data.data()), buffer.data.size()));
     }
 
 } // end namespace webrtc
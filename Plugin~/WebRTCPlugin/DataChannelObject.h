@@ -1,7 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+
 #include <api/data_channel_interface.h>
 
+#include "DataChannelChunker.h"
+#include "DataChannelFlowControl.h"
+#include "DataChannelMessageQueue.h"
+#include "DataChannelSendBufferPool.h"
+#include "EventQueue.h"
+
 namespace unity
 {
 namespace webrtc
@@ -9,12 +20,8 @@ namespace webrtc
 
     using namespace ::webrtc;
 
+    class Context;
     class PeerConnectionObject;
-    class DataChannelObject;
-    using DelegateOnMessage = void (*)(DataChannelInterface*, const uint8_t*, int32_t);
-    using DelegateOnOpen = void (*)(DataChannelInterface*);
-    using DelegateOnClose = void (*)(DataChannelInterface*);
-    using DelegateOnError = void (*)(DataChannelInterface*, RTCErrorType, const char*, int32_t);
 
     class DataChannelObject : public DataChannelObserver
     {
@@ -23,21 +30,78 @@ namespace webrtc
         ~DataChannelObject() override;
 
         void Close() { dataChannel->Close(); }
-        void RegisterOnMessage(DelegateOnMessage callback) { onMessage = callback; }
-        void RegisterOnOpen(DelegateOnOpen callback) { onOpen = callback; }
-        void RegisterOnClose(DelegateOnClose callback) { onClose = callback; }
-        void RegisterOnError(DelegateOnError callback) { onError = callback; }
+
+        // Sends through the flow control which queues the message natively when
+        // the send queue is enabled and the send buffer of the channel is full.
+        // When chunking is enabled, the message is split into chunks instead.
+        // Returns false when the channel is not open, or the message does not
+        // fit in the send queue.
+        bool Send(const webrtc::DataBuffer& buffer);
+        DataChannelFlowControl& flowControl() { return flowControl_; }
+
+        // Splits sent messages into chunks of `chunkSize` bytes and reassembles
+        // received chunks. Both peers need to enable it before sending.
+        void SetChunking(bool enabled, size_t chunkSize);
+        bool chunking() const
+        {
+            std::lock_guard<std::mutex> lock(chunkMutex_);
+            return chunker_ != nullptr;
+        }
+
+        // Zero-copy send path. The managed code writes a message into the leased
+        // buffer, then sends it with `CommitSendBuffer` or gives it back with
+        // `CancelSendBuffer`.
+        uint8_t* LeaseSendBuffer(size_t capacity, rtc::CopyOnWriteBuffer** lease);
+        bool CommitSendBuffer(rtc::CopyOnWriteBuffer* lease, size_t length);
+        void CancelSendBuffer(rtc::CopyOnWriteBuffer* lease);
+        DataChannelSendBufferPool& sendBufferPool() { return sendBufferPool_; }
+
+        // When batched receive is enabled, received messages are queued instead
+        // of being pushed to the event queue, and drained with `ReceiveBatch`.
+        void SetBatchedReceive(bool enabled);
+        int32_t ReceiveBatch(const uint8_t** data, const DataChannelMessageIndex** index)
+        {
+            return receiveQueue_.Drain(data, index);
+        }
+        DataChannelMessageQueue& receiveQueue() { return receiveQueue_; }
+
         // werbrtc::DataChannelObserver
+        // The events are pushed to the event queue of the context.
         // The data channel state have changed.
         void OnStateChange() override;
         //  A data buffer was successfully received.
         void OnMessage(const webrtc::DataBuffer& buffer) override;
+        // The data channel's buffered_amount has changed.
+        void OnBufferedAmountChange(uint64_t sent_data_size) override;
 
         rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel;
-        DelegateOnMessage onMessage;
-        DelegateOnOpen onOpen;
-        DelegateOnClose onClose;
-        DelegateOnError onError;
+
+    private:
+        // Bytes of chunks passed to the channel at once. Chunks of a large message
+        // are held natively beyond it so that small messages can be interleaved.
+        static constexpr uint64_t kChunkSendWindow = 1024 * 1024;
+
+        void PumpChunks();
+        void DeliverMessage(const webrtc::DataBuffer& buffer);
+        void PushEvent(EventType type, int32_t value = 0, std::string_view data = {});
+
+        Context& context_;
+        DataChannelFlowControl flowControl_;
+        DataChannelSendBufferPool sendBufferPool_;
+        DataChannelMessageQueue receiveQueue_;
+        std::atomic<bool> batchedReceive_ { false };
+        // Like the flow control, the mutex is not held while calling the
+        // channel, whose buffered amount callback pumps chunks on the
+        // signaling thread. Only the thread which set `pumpingChunks_` passes
+        // chunks to the flow control, and `pumpAgain_` tells it that the window
+        // or the chunker changed in the meantime. A chunk which the flow control
+        // failed to send is kept in `failedChunk_` and sent first next time.
+        mutable std::mutex chunkMutex_;
+        std::shared_ptr<DataChannelChunker> chunker_;
+        std::optional<webrtc::DataBuffer> failedChunk_;
+        std::unique_ptr<DataChannelReassembler> reassembler_;
+        bool pumpingChunks_ = false;
+        bool pumpAgain_ = false;
     };
 
 } // end namespace webrtc
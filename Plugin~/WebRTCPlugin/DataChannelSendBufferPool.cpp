@@ -0,0 +1,70 @@
+#include "pch.h"
+
+#include "DataChannelSendBufferPool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    rtc::CopyOnWriteBuffer* DataChannelSendBufferPool::Lease(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::unique_ptr<rtc::CopyOnWriteBuffer> buffer;
+        if (available_.empty())
+        {
+            buffer = std::make_unique<rtc::CopyOnWriteBuffer>();
+        }
+        else
+        {
+            buffer = std::move(available_.back());
+            available_.pop_back();
+        }
+
+        // `Clear` detaches the storage instead of copying it when the previous
+        // message is still queued in the data channel. The detached storage is
+        // allocated with the same capacity, so it is counted here as well as
+        // the growth by `SetSize`.
+        const uint8_t* storage = buffer->cdata();
+        buffer->Clear();
+        if (buffer->cdata() != storage)
+            allocationCount_++;
+        storage = buffer->cdata();
+        buffer->SetSize(capacity);
+        if (buffer->cdata() != storage)
+            allocationCount_++;
+
+        leased_.push_back(std::move(buffer));
+        return leased_.back().get();
+    }
+
+    void DataChannelSendBufferPool::Return(rtc::CopyOnWriteBuffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = std::find_if(
+            leased_.begin(),
+            leased_.end(),
+            [buffer](const std::unique_ptr<rtc::CopyOnWriteBuffer>& leased) { return leased.get() == buffer; });
+        if (it == leased_.end())
+        {
+            RTC_LOG(LS_WARNING) << "The buffer is not leased from the pool.";
+            return;
+        }
+
+        if (available_.size() < kMaxPooledBuffers)
+            available_.push_back(std::move(*it));
+        leased_.erase(it);
+    }
+
+    bool DataChannelSendBufferPool::IsLeased(const rtc::CopyOnWriteBuffer* buffer) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::any_of(
+            leased_.begin(),
+            leased_.end(),
+            [buffer](const std::unique_ptr<rtc::CopyOnWriteBuffer>& leased) { return leased.get() == buffer; });
+    }
+
+} // end namespace webrtc
+} // end namespace unity
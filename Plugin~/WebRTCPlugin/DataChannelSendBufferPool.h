@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <rtc_base/copy_on_write_buffer.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Lends `rtc::CopyOnWriteBuffer` instances which the managed code writes
+    // a message into in place. The buffer is passed to `DataChannelInterface::Send`
+    // by reference, so the message is not copied again before it reaches the
+    // SCTP transport.
+    class DataChannelSendBufferPool
+    {
+    public:
+        // Buffers over this count are released when they are returned.
+        static constexpr size_t kMaxPooledBuffers = 16;
+
+        DataChannelSendBufferPool() = default;
+        DataChannelSendBufferPool(const DataChannelSendBufferPool&) = delete;
+        DataChannelSendBufferPool& operator=(const DataChannelSendBufferPool&) = delete;
+
+        // Returns a buffer whose size is `capacity`.
+        rtc::CopyOnWriteBuffer* Lease(size_t capacity);
+        void Return(rtc::CopyOnWriteBuffer* buffer);
+        bool IsLeased(const rtc::CopyOnWriteBuffer* buffer) const;
+
+        size_t pooledCount() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return available_.size();
+        }
+        uint64_t allocationCount() const { return allocationCount_; }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<rtc::CopyOnWriteBuffer>> leased_;
+        std::vector<std::unique_ptr<rtc::CopyOnWriteBuffer>> available_;
+        std::atomic<uint64_t> allocationCount_ { 0 };
+    };
+
+} // end namespace webrtc
+} // end namespace unity
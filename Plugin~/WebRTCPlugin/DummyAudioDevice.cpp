@@ -10,11 +10,23 @@ namespace unity
 namespace webrtc
 {
     DummyAudioDevice::DummyAudioDevice(TaskQueueFactory* taskQueueFactory)
-        : audio_data(kChannels * kSamplesPerFrame)
+        : audio_data(kDefaultChannels * samplesPerFrame_)
         , tackQueueFactory_(taskQueueFactory)
     {
     }
 
+    void DummyAudioDevice::SetPlayoutFormat(int32_t sampleRate, size_t channels)
+    {
+        RTC_DCHECK_GT(sampleRate, 0);
+        RTC_DCHECK_GT(channels, 0);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        samplingRate_ = sampleRate;
+        channels_ = channels;
+        samplesPerFrame_ = static_cast<size_t>(sampleRate * kFrameLengthMs / 1000);
+        audio_data.resize(channels_ * samplesPerFrame_);
+    }
+
     int32_t DummyAudioDevice::Init()
     {
         taskQueue_ = std::make_unique<rtc::TaskQueue>(
@@ -59,7 +71,13 @@ namespace webrtc
             // and mixing multiple audio stream. But we want each audio streams, not final
             // result.
             audio_transport_->PullRenderData(
-                kBytesPerSample * 8, kSamplingRate, kChannels, kSamplesPerFrame, data, &elapsed_time_ms, &ntp_time_ms);
+                kBytesPerSample * 8,
+                samplingRate_,
+                channels_,
+                samplesPerFrame_,
+                data,
+                &elapsed_time_ms,
+                &ntp_time_ms);
         }
     }
 
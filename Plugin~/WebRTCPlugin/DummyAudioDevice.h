@@ -177,15 +177,34 @@ namespace webrtc
         virtual int GetRecordAudioParameters(webrtc::AudioParameters* params) const override { return 0; }
 #endif
 
+        // Sets the format of the mix pulled from the audio transport. The mix
+        // is discarded, and the sinks of the tracks receive the audio in the
+        // format of the decoder whatever this format is. A rate other than the
+        // rate of the mixer adds a resample of the mix.
+        void SetPlayoutFormat(int32_t sampleRate, size_t channels);
+        int32_t PlayoutSampleRate() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return samplingRate_;
+        }
+        size_t PlayoutChannels() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return channels_;
+        }
+
+        static constexpr int32_t kDefaultSamplingRate = 48000;
+        static constexpr size_t kDefaultChannels = 2;
+
     private:
         void ProcessAudio();
         bool PlayoutThreadProcess();
 
         const int32_t kFrameLengthMs = 10;
         const int32_t kBytesPerSample = 2;
-        const size_t kChannels = 2;
-        const int32_t kSamplingRate = 48000;
-        const size_t kSamplesPerFrame = static_cast<size_t>(kSamplingRate * kFrameLengthMs / 1000);
+        int32_t samplingRate_ = kDefaultSamplingRate;
+        size_t channels_ = kDefaultChannels;
+        size_t samplesPerFrame_ = static_cast<size_t>(kDefaultSamplingRate * kFrameLengthMs / 1000);
         std::vector<int16_t> audio_data;
         std::unique_ptr<rtc::TaskQueue> taskQueue_;
         RepeatingTaskHandle task_;
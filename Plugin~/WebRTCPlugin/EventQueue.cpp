@@ -0,0 +1,106 @@
+#include "pch.h"
+
+#include "EventQueue.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    EventQueue::EventQueue()
+        : head_(&stub_)
+        , tail_(&stub_)
+    {
+    }
+
+    EventQueue::~EventQueue() { Clear(); }
+
+    bool EventQueue::Push(const EventRecord& record, std::string_view data, std::string_view text)
+    {
+        Node* node = new Node();
+        node->record = record;
+        if (!data.empty())
+            node->data.assign(data.data(), data.size());
+        if (!text.empty())
+            node->text.assign(text.data(), text.size());
+        Link(node);
+
+        // The node is linked before the flag is set, so a consumer which has
+        // cleared the flag before this exchange pops the node.
+        return !pending_.exchange(true);
+    }
+
+    void EventQueue::Link(Node* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        // Between the exchange and this store, the consumer stops at `prev`.
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    EventQueue::Node* EventQueue::Pop()
+    {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_)
+        {
+            if (!next)
+                return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            tail_ = next;
+            return tail;
+        }
+        // A producer has exchanged the head but not linked the node yet.
+        if (tail != head_.load(std::memory_order_acquire))
+            return nullptr;
+
+        // The stub takes the place of the last node, so that it can be popped.
+        Link(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    int32_t EventQueue::Drain(const EventRecord** records)
+    {
+        ReleaseDrained();
+        pending_.store(false);
+
+        while (Node* node = Pop())
+        {
+            drained_.push_back(node);
+            EventRecord record = node->record;
+            record.data = node->data.c_str();
+            record.text = node->text.c_str();
+            record.length = static_cast<int32_t>(node->data.size());
+            records_.push_back(record);
+        }
+        *records = records_.data();
+        return static_cast<int32_t>(records_.size());
+    }
+
+    void EventQueue::Clear()
+    {
+        ReleaseDrained();
+        while (Node* node = Pop())
+            delete node;
+    }
+
+    void EventQueue::ReleaseDrained()
+    {
+        for (Node* node : drained_)
+            delete node;
+        drained_.clear();
+        records_.clear();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
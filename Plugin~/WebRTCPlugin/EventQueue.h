@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Data format used by the managed code.
+    enum class EventType : int32_t
+    {
+        IceCandidate = 0,
+        IceConnectionChange = 1,
+        ConnectionStateChange = 2,
+        IceGatheringChange = 3,
+        NegotiationNeeded = 4,
+        DataChannel = 5,
+        Track = 6,
+        RemoveTrack = 7,
+        StatsDelivered = 8,
+        DataChannelOpen = 9,
+        DataChannelClose = 10,
+        DataChannelError = 11,
+        DataChannelMessage = 12,
+        DataChannelBufferedAmountLow = 13,
+    };
+
+    // Data format used by the managed code.
+    // `sender` is the peer connection or the data channel which raised the
+    // event, and `value` holds the state, the index or the error type. `data`
+    // and `text` are null terminated, and `length` is the size of `data`.
+    struct EventRecord
+    {
+        EventType type;
+        int32_t value;
+        void* sender;
+        void* object;
+        void* object2;
+        const char* data;
+        const char* text;
+        int32_t length;
+    };
+
+    // Carries the events of the observers from the signaling and network
+    // threads to the managed code, which drains all of them with one call on
+    // the main thread. Producers link a node with one atomic exchange and never
+    // wait for each other or for the consumer.
+    class EventQueue
+    {
+    public:
+        EventQueue();
+        ~EventQueue();
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        // Safe to call from any thread. `data` and `text` are copied. Returns
+        // true for the first event after a drain, so that the consumer is
+        // notified once for each batch.
+        bool Push(const EventRecord& record, std::string_view data = {}, std::string_view text = {});
+
+        // Must be called by a single thread at a time. The records and their
+        // strings stay valid until the next call of `Drain` or `Clear`.
+        int32_t Drain(const EventRecord** records);
+        void Clear();
+
+    private:
+        struct Node
+        {
+            std::atomic<Node*> next { nullptr };
+            EventRecord record;
+            std::string data;
+            std::string text;
+        };
+
+        void Link(Node* node);
+        Node* Pop();
+        void ReleaseDrained();
+
+        // Producers exchange the head, and the consumer follows the tail.
+        std::atomic<Node*> head_;
+        Node* tail_;
+        Node stub_;
+        std::atomic<bool> pending_ { false };
+        std::vector<Node*> drained_;
+        std::vector<EventRecord> records_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
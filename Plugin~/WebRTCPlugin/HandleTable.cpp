@@ -0,0 +1,105 @@
+#include "pch.h"
+
+#include "HandleTable.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    HandleTable::HandleTable()
+    {
+        for (auto& chunk : chunks_)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    HandleTable::~HandleTable()
+    {
+        for (auto& chunk : chunks_)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    HandleTable::Handle HandleTable::Add(const void* ptr)
+    {
+        if (!ptr)
+            return kInvalidHandle;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t index;
+        if (!freeIndices_.empty())
+        {
+            index = freeIndices_.back();
+            freeIndices_.pop_back();
+        }
+        else
+        {
+            if (slotCount_ == kChunkSize * kMaxChunks)
+                return kInvalidHandle;
+            index = slotCount_++;
+            auto& chunk = chunks_[index >> kChunkBits];
+            if (!chunk.load(std::memory_order_relaxed))
+                chunk.store(new Slot[kChunkSize], std::memory_order_release);
+        }
+
+        Slot& slot = chunks_[index >> kChunkBits].load(std::memory_order_relaxed)[index & (kChunkSize - 1)];
+        slot.ptr.store(ptr, std::memory_order_release);
+        size_++;
+        const uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+        return static_cast<Handle>(generation) << 32 | index;
+    }
+
+    bool HandleTable::Remove(Handle handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint32_t index = IndexOf(handle);
+        if (index >= slotCount_)
+            return false;
+        Slot& slot = chunks_[index >> kChunkBits].load(std::memory_order_relaxed)[index & (kChunkSize - 1)];
+        uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+        if (generation != GenerationOf(handle) || !slot.ptr.load(std::memory_order_relaxed))
+            return false;
+
+        slot.ptr.store(nullptr, std::memory_order_release);
+        // Generation 0 is skipped, so that the handle of the first slot never
+        // becomes kInvalidHandle.
+        if (++generation == 0)
+            generation = 1;
+        slot.generation.store(generation, std::memory_order_release);
+        freeIndices_.push_back(index);
+        size_--;
+        return true;
+    }
+
+    const HandleTable::Slot* HandleTable::FindSlot(uint32_t index) const
+    {
+        if ((index >> kChunkBits) >= kMaxChunks)
+            return nullptr;
+        const Slot* chunk = chunks_[index >> kChunkBits].load(std::memory_order_acquire);
+        if (!chunk)
+            return nullptr;
+        return &chunk[index & (kChunkSize - 1)];
+    }
+
+    const void* HandleTable::Get(Handle handle) const
+    {
+        const Slot* slot = FindSlot(IndexOf(handle));
+        if (!slot)
+            return nullptr;
+        const uint32_t generation = slot->generation.load(std::memory_order_acquire);
+        if (generation != GenerationOf(handle))
+            return nullptr;
+        const void* ptr = slot->ptr.load(std::memory_order_acquire);
+        // The slot may have been removed and reused between the loads, in
+        // which case the generation has changed.
+        if (slot->generation.load(std::memory_order_acquire) != generation)
+            return nullptr;
+        return ptr;
+    }
+
+    size_t HandleTable::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Maps handles to pointers. A handle packs the 32-bit index of a slot with
+    // the generation of the slot, which is incremented when the pointer is
+    // removed, so that a stale handle never resolves to an object which later
+    // reuses the slot. Slots are allocated in chunks which are never moved or
+    // freed until the table is destroyed, so `Get` is a few atomic loads
+    // without a lock and can be called from the render thread. `Add` and
+    // `Remove` are serialized with a mutex.
+    class HandleTable
+    {
+    public:
+        using Handle = uint64_t;
+        static constexpr Handle kInvalidHandle = 0;
+
+        HandleTable();
+        ~HandleTable();
+        HandleTable(const HandleTable&) = delete;
+        HandleTable& operator=(const HandleTable&) = delete;
+
+        // Returns kInvalidHandle when the pointer is null or the table is full.
+        Handle Add(const void* ptr);
+        // Returns false when the handle is stale.
+        bool Remove(Handle handle);
+        // Returns nullptr when the handle is stale.
+        const void* Get(Handle handle) const;
+        bool Contains(Handle handle, const void* ptr) const { return ptr != nullptr && Get(handle) == ptr; }
+
+        size_t size() const;
+
+        static uint32_t IndexOf(Handle handle) { return static_cast<uint32_t>(handle); }
+        static uint32_t GenerationOf(Handle handle) { return static_cast<uint32_t>(handle >> 32); }
+
+    private:
+        static constexpr uint32_t kChunkBits = 10;
+        static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+        static constexpr uint32_t kMaxChunks = 4096;
+
+        struct Slot
+        {
+            // Starts at 1, so that no valid handle equals kInvalidHandle.
+            std::atomic<uint32_t> generation { 1 };
+            std::atomic<const void*> ptr { nullptr };
+        };
+
+        const Slot* FindSlot(uint32_t index) const;
+
+        std::array<std::atomic<Slot*>, kMaxChunks> chunks_;
+        mutable std::mutex mutex_;
+        std::vector<uint32_t> freeIndices_;
+        uint32_t slotCount_ = 0;
+        size_t size_ = 0;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
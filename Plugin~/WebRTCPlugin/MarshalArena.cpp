@@ -0,0 +1,80 @@
+#include "pch.h"
+
+#include <cstring>
+
+#include "MarshalArena.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    MarshalArena::MarshalArena(size_t blockSize)
+        : blockSize_(blockSize)
+    {
+        RTC_DCHECK_GT(blockSize_, 0);
+    }
+
+    void* MarshalArena::Allocate(size_t size, size_t alignment)
+    {
+        RTC_DCHECK(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+        if (!blocks_.empty())
+        {
+            if (void* ptr = AllocateFromBlock(blocks_.back(), size, alignment))
+                return ptr;
+        }
+
+        // Values larger than the block size get a block of their own.
+        const size_t blockSize = std::max(blockSize_, size + alignment);
+        blocks_.push_back({ std::make_unique<uint8_t[]>(blockSize), blockSize });
+        offset_ = 0;
+        void* ptr = AllocateFromBlock(blocks_.back(), size, alignment);
+        RTC_DCHECK(ptr);
+        return ptr;
+    }
+
+    void* MarshalArena::AllocateFromBlock(Block& block, size_t size, size_t alignment)
+    {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(alignment - 1);
+        const size_t offset = static_cast<size_t>(aligned - base);
+        if (offset > block.size || block.size - offset < size)
+            return nullptr;
+
+        offset_ = offset + size;
+        bytesAllocated_ += size;
+        return block.data.get() + offset;
+    }
+
+    char* MarshalArena::CopyString(absl::string_view str)
+    {
+        char* dst = AllocateArray<char>(str.size() + 1);
+        std::memcpy(dst, str.data(), str.size());
+        dst[str.size()] = '\0';
+        return dst;
+    }
+
+    void MarshalArena::Reset()
+    {
+        // Blocks are merged into one, so that the next calls of the same size
+        // fit in a single block.
+        if (blocks_.size() > 1)
+        {
+            const size_t size = capacity();
+            blocks_.clear();
+            blocks_.push_back({ std::make_unique<uint8_t[]>(size), size });
+        }
+        offset_ = 0;
+        bytesAllocated_ = 0;
+    }
+
+    size_t MarshalArena::capacity() const
+    {
+        size_t size = 0;
+        for (const auto& block : blocks_)
+            size += block.size;
+        return size;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
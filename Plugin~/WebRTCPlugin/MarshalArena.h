@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <absl/strings/string_view.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Bump allocator for the values which exports return to the managed code.
+    // The managed code copies the values right after the call, so everything
+    // allocated is released at once by `Reset` instead of calling
+    // CoTaskMemFree for each string and array. Blocks are kept across resets,
+    // so that the arena stops allocating once it has grown to the largest
+    // call. The arena is not thread-safe.
+    class MarshalArena
+    {
+    public:
+        static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+        explicit MarshalArena(size_t blockSize = kDefaultBlockSize);
+        MarshalArena(const MarshalArena&) = delete;
+        MarshalArena& operator=(const MarshalArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        T* AllocateArray(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Returns a null-terminated copy of the string.
+        char* CopyString(absl::string_view str);
+
+        // Invalidates all pointers returned since the last reset.
+        void Reset();
+
+        // Bytes allocated since the last reset.
+        size_t bytesAllocated() const { return bytesAllocated_; }
+        size_t capacity() const;
+        size_t blockCount() const { return blocks_.size(); }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t size;
+        };
+
+        void* AllocateFromBlock(Block& block, size_t size, size_t alignment);
+
+        size_t blockSize_;
+        std::vector<Block> blocks_;
+        // Offset in the last block.
+        size_t offset_ = 0;
+        size_t bytesAllocated_ = 0;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
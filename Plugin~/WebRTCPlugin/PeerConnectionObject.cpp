@@ -67,35 +67,47 @@ namespace webrtc
         connection = nullptr;
     }
 
+    void PeerConnectionObject::PushEvent(EventType type, int32_t value, void* object)
+    {
+        EventRecord record = {};
+        record.type = type;
+        record.value = value;
+        record.sender = this;
+        record.object = object;
+        context.PushEvent(record);
+    }
+
     void PeerConnectionObject::OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> channel)
     {
         context.AddDataChannel(channel, *this);
-        if (onDataChannel != nullptr)
-        {
-            onDataChannel(this, channel.get());
-        }
+        if (!closed_)
+            PushEvent(EventType::DataChannel, 0, channel.get());
     }
 
     void PeerConnectionObject::OnIceCandidate(const webrtc::IceCandidateInterface* candidate)
     {
+        // The candidate has been added to the local description.
+        InvalidateSessionDescriptions();
+
         std::string out;
 
         if (!candidate->ToString(&out))
         {
             DebugError("Can't make string form of sdp.");
         }
-        if (onIceCandidate != nullptr)
-        {
-            onIceCandidate(this, out.c_str(), candidate->sdp_mid().c_str(), candidate->sdp_mline_index());
-        }
+        if (closed_)
+            return;
+        EventRecord record = {};
+        record.type = EventType::IceCandidate;
+        record.value = candidate->sdp_mline_index();
+        record.sender = this;
+        context.PushEvent(record, out, candidate->sdp_mid());
     }
 
     void PeerConnectionObject::OnRenegotiationNeeded()
     {
-        if (onRenegotiationNeeded != nullptr)
-        {
-            onRenegotiationNeeded(this);
-        }
+        if (!closed_)
+            PushEvent(EventType::NegotiationNeeded);
     }
 
     void PeerConnectionObject::OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
@@ -104,52 +116,40 @@ namespace webrtc
         context.AddRefPtr(transceiver->receiver());
         context.AddRefPtr(transceiver->receiver()->track());
 
-        if (onTrack != nullptr)
-        {
-            onTrack(this, transceiver.get());
-        }
+        if (!closed_)
+            PushEvent(EventType::Track, 0, transceiver.get());
     }
 
     void PeerConnectionObject::OnRemoveTrack(rtc::scoped_refptr<RtpReceiverInterface> receiver)
     {
-        if (onRemoveTrack != nullptr)
-        {
-            onRemoveTrack(this, receiver.get());
-        }
+        PushEvent(EventType::RemoveTrack, 0, receiver.get());
     }
 
     // Called any time the IceConnectionState changes.
     void PeerConnectionObject::OnIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState new_state)
     {
         DebugLog("OnIceConnectionChange %d", new_state);
-        if (onIceConnectionChange != nullptr)
-        {
-            onIceConnectionChange(this, new_state);
-        }
+        if (!closed_)
+            PushEvent(EventType::IceConnectionChange, static_cast<int32_t>(new_state));
     }
 
     void PeerConnectionObject::OnConnectionChange(PeerConnectionInterface::PeerConnectionState new_state)
     {
         DebugLog("OnConnectionChange %d", new_state);
-        if (onConnectionStateChange != nullptr)
-        {
-            onConnectionStateChange(this, new_state);
-        }
+        PushEvent(EventType::ConnectionStateChange, static_cast<int32_t>(new_state));
     }
 
     // Called any time the IceGatheringState changes.
     void PeerConnectionObject::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState new_state)
     {
         DebugLog("OnIceGatheringChange %d", new_state);
-        if (onIceGatheringChange != nullptr)
-        {
-            onIceGatheringChange(this, new_state);
-        }
+        PushEvent(EventType::IceGatheringChange, static_cast<int32_t>(new_state));
     }
 
     void PeerConnectionObject::OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState new_state)
     {
         DebugLog("OnSignalingChange %d", new_state);
+        InvalidateSessionDescriptions();
     }
 
     void PeerConnectionObject::OnAddStream(rtc::scoped_refptr<webrtc::MediaStreamInterface> stream)
@@ -171,11 +171,7 @@ namespace webrtc
             onCreateSDSuccess = nullptr;
             onCreateSDFailure = nullptr;
             onLocalSdpReady = nullptr;
-            onIceCandidate = nullptr;
-            onIceConnectionChange = nullptr;
-            onDataChannel = nullptr;
-            onRenegotiationNeeded = nullptr;
-            onTrack = nullptr;
+            closed_ = true;
 
             connection->Close();
         }
@@ -186,13 +182,26 @@ namespace webrtc
         rtc::scoped_refptr<SetLocalDescriptionObserverInterface> observer,
         std::string& error)
     {
-        SdpParseError error_;
-        std::unique_ptr<SessionDescriptionInterface> _desc =
-            CreateSessionDescription(ConvertSdpType(desc.type), desc.sdp, &error_);
+        const webrtc::SdpType type = ConvertSdpType(desc.type);
+        std::unique_ptr<SessionDescriptionInterface> _desc;
+        {
+            // The description is usually the one created by the last CreateOffer
+            // or CreateAnswer, which does not need to be parsed again.
+            std::lock_guard<std::mutex> lock(createdDescriptionMutex_);
+            if (createdDescription_ && createdDescription_->GetType() == type && createdSdp_ == desc.sdp)
+                _desc = std::move(createdDescription_);
+            createdDescription_ = nullptr;
+            createdSdp_.clear();
+        }
         if (!_desc)
         {
-            error = error_.description;
-            return RTCErrorType::SYNTAX_ERROR;
+            SdpParseError error_;
+            _desc = CreateSessionDescription(type, desc.sdp, &error_);
+            if (!_desc)
+            {
+                error = error_.description;
+                return RTCErrorType::SYNTAX_ERROR;
+            }
         }
         connection->SetLocalDescription(std::move(_desc), observer);
         return RTCErrorType::NONE;
@@ -227,8 +236,21 @@ namespace webrtc
         webrtc::PeerConnectionInterface::RTCConfiguration _config;
         if (!Convert(config, _config))
             return webrtc::RTCErrorType::INVALID_PARAMETER;
+        return SetConfiguration(_config);
+    }
 
-        const auto error = connection->SetConfiguration(_config);
+    webrtc::RTCErrorType
+    PeerConnectionObject::SetConfiguration(const webrtc::PeerConnectionInterface::RTCConfiguration& config)
+    {
+        // The certificate given by the context on creation cannot be modified.
+        webrtc::PeerConnectionInterface::RTCConfiguration configuration = config;
+        if (configuration.certificates.empty())
+            configuration.certificates = connection->GetConfiguration().certificates;
+        const auto error = connection->SetConfiguration(configuration);
+        {
+            std::lock_guard<std::mutex> lock(configurationMutex_);
+            configuration_.clear();
+        }
         if (!error.ok())
         {
             LogPrint(rtc::LoggingSeverity::LS_ERROR, error.message());
@@ -238,6 +260,10 @@ namespace webrtc
 
     std::string PeerConnectionObject::GetConfiguration() const
     {
+        std::lock_guard<std::mutex> lock(configurationMutex_);
+        if (!configuration_.empty())
+            return configuration_;
+
         auto _config = connection->GetConfiguration();
 
         Json::Value root;
@@ -268,7 +294,8 @@ namespace webrtc
         root["bundlePolicy"]["value"] = _config.bundle_policy;
 
         Json::StreamWriterBuilder builder;
-        return Json::writeString(builder, root);
+        configuration_ = Json::writeString(builder, root);
+        return configuration_;
     }
 
     void
@@ -289,26 +316,66 @@ namespace webrtc
         connection->CreateAnswer(observer, _options);
     }
 
-    void PeerConnectionObject::ReceiveStatsReport(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report)
+    void PeerConnectionObject::ReceiveStatsReport(
+        const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report, PeerConnectionStatsCollectorCallback* callback)
     {
         context.AddStatsReport(report);
+
+        EventRecord record = {};
+        record.type = EventType::StatsDelivered;
+        record.sender = this;
+        record.object = callback;
+        record.object2 = const_cast<RTCStatsReport*>(report.get());
+        context.PushEvent(record);
+    }
+
+    void PeerConnectionObject::OnSessionDescriptionCreated(
+        std::unique_ptr<SessionDescriptionInterface> desc, const std::string& sdp)
+    {
+        std::lock_guard<std::mutex> lock(createdDescriptionMutex_);
+        createdDescription_ = std::move(desc);
+        createdSdp_ = sdp;
+    }
+
+    const SessionDescriptionInterface*
+    PeerConnectionObject::GetDescription(RTCSessionDescriptionSource source) const
+    {
+        switch (source)
+        {
+        case RTCSessionDescriptionSource::Local:
+            return connection->local_description();
+        case RTCSessionDescriptionSource::Remote:
+            return connection->remote_description();
+        case RTCSessionDescriptionSource::PendingLocal:
+            return connection->pending_local_description();
+        case RTCSessionDescriptionSource::PendingRemote:
+            return connection->pending_remote_description();
+        case RTCSessionDescriptionSource::CurrentLocal:
+            return connection->current_local_description();
+        case RTCSessionDescriptionSource::CurrentRemote:
+            return connection->current_remote_description();
+        }
+        return nullptr;
     }
 
     bool PeerConnectionObject::GetSessionDescription(
-        const webrtc::SessionDescriptionInterface* sdp, RTCSessionDescription& desc) const
+        RTCSessionDescriptionSource source, uint64_t* handle, RTCSessionDescription& desc)
     {
-        if (sdp == nullptr)
+        const auto entry = descriptionCache_.Get(source, GetDescription(source));
+        if (entry == nullptr)
         {
             return false;
         }
 
-        std::string out;
-        sdp->ToString(&out);
+        desc.type = ConvertSdpType(entry->type);
+        desc.sdp = nullptr;
+        if (*handle == entry->handle)
+            return true;
 
-        desc.type = ConvertSdpType(sdp->GetType());
-        desc.sdp = static_cast<char*>(CoTaskMemAlloc(out.size() + 1));
-        out.copy(desc.sdp, out.size());
-        desc.sdp[out.size()] = '\0';
+        *handle = entry->handle;
+        desc.sdp = static_cast<char*>(CoTaskMemAlloc(entry->sdp.size() + 1));
+        entry->sdp.copy(desc.sdp, entry->sdp.size());
+        desc.sdp[entry->sdp.size()] = '\0';
         return true;
     }
 } // end namespace webrtc
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <api/peer_connection_interface.h>
 
 #include "DataChannelObject.h"
+#include "EventQueue.h"
 #include "PeerConnectionStatsCollectorCallback.h"
+#include "SessionDescriptionCache.h"
 #include "WebRTCPlugin.h"
 
 namespace unity
@@ -18,15 +23,6 @@ namespace webrtc
     using DelegateCreateSDSuccess = void (*)(PeerConnectionObject*, RTCSdpType, const char*);
     using DelegateCreateSDFailure = void (*)(PeerConnectionObject*, RTCErrorType, const char*);
     using DelegateLocalSdpReady = void (*)(PeerConnectionObject*, const char*, const char*);
-    using DelegateIceCandidate = void (*)(PeerConnectionObject*, const char*, const char*, const int);
-    using DelegateOnIceConnectionChange = void (*)(PeerConnectionObject*, PeerConnectionInterface::IceConnectionState);
-    using DelegateOnIceGatheringChange = void (*)(PeerConnectionObject*, PeerConnectionInterface::IceGatheringState);
-    using DelegateOnConnectionStateChange =
-        void (*)(PeerConnectionObject*, PeerConnectionInterface::PeerConnectionState);
-    using DelegateOnDataChannel = void (*)(PeerConnectionObject*, DataChannelInterface*);
-    using DelegateOnRenegotiationNeeded = void (*)(PeerConnectionObject*);
-    using DelegateOnTrack = void (*)(PeerConnectionObject*, RtpTransceiverInterface*);
-    using DelegateOnRemoveTrack = void (*)(PeerConnectionObject*, RtpReceiverInterface*);
 
     class PeerConnectionObject : public PeerConnectionObserver
     {
@@ -46,12 +42,21 @@ namespace webrtc
             rtc::scoped_refptr<SetRemoteDescriptionObserverInterface>,
             std::string& error);
 
-        bool GetSessionDescription(const SessionDescriptionInterface* sdp, RTCSessionDescription& desc) const;
+        // `handle` is the handle of the description the caller already has.
+        // `desc.sdp` is only allocated when the description differs from it.
+        bool GetSessionDescription(RTCSessionDescriptionSource source, uint64_t* handle, RTCSessionDescription& desc);
+        // Called when a description may have been modified in place.
+        void InvalidateSessionDescriptions() { descriptionCache_.Invalidate(); }
+        // Keeps the created description, so that setting it as the local
+        // description does not parse the SDP string again.
+        void OnSessionDescriptionCreated(std::unique_ptr<SessionDescriptionInterface> desc, const std::string& sdp);
         RTCErrorType SetConfiguration(const std::string& config);
+        RTCErrorType SetConfiguration(const PeerConnectionInterface::RTCConfiguration& config);
         std::string GetConfiguration() const;
         void CreateOffer(const RTCOfferAnswerOptions& options, CreateSessionDescriptionObserver* observer);
         void CreateAnswer(const RTCOfferAnswerOptions& options, CreateSessionDescriptionObserver* observer);
-        void ReceiveStatsReport(const rtc::scoped_refptr<const RTCStatsReport>& report);
+        void ReceiveStatsReport(
+            const rtc::scoped_refptr<const RTCStatsReport>& report, PeerConnectionStatsCollectorCallback* callback);
 
         void RegisterCallbackCreateSD(DelegateCreateSDSuccess onSuccess, DelegateCreateSDFailure onFailure)
         {
@@ -60,19 +65,10 @@ namespace webrtc
         }
 
         void RegisterLocalSdpReady(DelegateLocalSdpReady callback) { onLocalSdpReady = callback; }
-        void RegisterIceCandidate(DelegateIceCandidate callback) { onIceCandidate = callback; }
-        void RegisterIceConnectionChange(DelegateOnIceConnectionChange callback) { onIceConnectionChange = callback; }
-        void RegisterConnectionStateChange(DelegateOnConnectionStateChange callback)
-        {
-            onConnectionStateChange = callback;
-        }
-        void RegisterIceGatheringChange(DelegateOnIceGatheringChange callback) { onIceGatheringChange = callback; }
-        void RegisterOnDataChannel(DelegateOnDataChannel callback) { onDataChannel = callback; }
-        void RegisterOnRenegotiationNeeded(DelegateOnRenegotiationNeeded callback) { onRenegotiationNeeded = callback; }
-        void RegisterOnTrack(DelegateOnTrack callback) { onTrack = callback; }
-        void RegisterOnRemoveTrack(DelegateOnRemoveTrack callback) { onRemoveTrack = callback; }
 
         // webrtc::PeerConnectionObserver
+        // The events are pushed to the event queue of the context instead of
+        // calling the managed code on the signaling and network threads.
         // Triggered when the SignalingState changed.
         void OnSignalingChange(PeerConnectionInterface::SignalingState new_state) override;
         // Triggered when media is received on a new stream from remote peer.
@@ -93,7 +89,10 @@ namespace webrtc
         // A new ICE candidate has been gathered.
         void OnIceCandidate(const IceCandidateInterface* candidate) override;
         // Ice candidates have been removed.
-        void OnIceCandidatesRemoved(const std::vector<cricket::Candidate>& candidates) override { }
+        void OnIceCandidatesRemoved(const std::vector<cricket::Candidate>& candidates) override
+        {
+            InvalidateSessionDescriptions();
+        }
         // Called when the ICE connection receiving status changes.
         void OnIceConnectionReceivingChange(bool Receiving) override { }
         // This is called when signaling indicates a transceiver will be receiving
@@ -113,19 +112,25 @@ namespace webrtc
 
         DelegateCreateSDSuccess onCreateSDSuccess = nullptr;
         DelegateCreateSDFailure onCreateSDFailure = nullptr;
-        DelegateIceCandidate onIceCandidate = nullptr;
         DelegateLocalSdpReady onLocalSdpReady = nullptr;
-        DelegateOnConnectionStateChange onConnectionStateChange = nullptr;
-        DelegateOnIceConnectionChange onIceConnectionChange = nullptr;
-        DelegateOnIceGatheringChange onIceGatheringChange = nullptr;
-        DelegateOnDataChannel onDataChannel = nullptr;
-        DelegateOnRenegotiationNeeded onRenegotiationNeeded = nullptr;
-        DelegateOnTrack onTrack = nullptr;
-        DelegateOnRemoveTrack onRemoveTrack = nullptr;
         rtc::scoped_refptr<PeerConnectionInterface> connection = nullptr;
 
     private:
+        void PushEvent(EventType type, int32_t value = 0, void* object = nullptr);
+        const SessionDescriptionInterface* GetDescription(RTCSessionDescriptionSource source) const;
+
         Context& context;
+        // After Close, only the state changes and removed tracks are queued.
+        std::atomic<bool> closed_ { false };
+        SessionDescriptionCache descriptionCache_;
+
+        std::mutex createdDescriptionMutex_;
+        std::unique_ptr<SessionDescriptionInterface> createdDescription_;
+        std::string createdSdp_;
+
+        // The configuration only changes with SetConfiguration.
+        mutable std::mutex configurationMutex_;
+        mutable std::string configuration_;
     };
 
 } // end namespace webrtc
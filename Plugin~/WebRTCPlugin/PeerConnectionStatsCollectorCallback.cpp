@@ -7,8 +7,6 @@ namespace unity
 {
 namespace webrtc
 {
-    DelegateCollectStats PeerConnectionStatsCollectorCallback::s_collectStatsCallback = nullptr;
-
     rtc::scoped_refptr<PeerConnectionStatsCollectorCallback>
     PeerConnectionStatsCollectorCallback::Create(PeerConnectionObject* connection)
     {
@@ -17,8 +15,7 @@ namespace webrtc
     void PeerConnectionStatsCollectorCallback::OnStatsDelivered(
         const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report)
     {
-        m_owner->ReceiveStatsReport(report);
-        s_collectStatsCallback(m_owner, this, report.get());
+        m_owner->ReceiveStatsReport(report, this);
     }
 } // end namespace webrtc
 } // end namespace unity
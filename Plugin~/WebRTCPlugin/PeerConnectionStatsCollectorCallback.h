@@ -10,9 +10,6 @@ namespace unity
 namespace webrtc
 {
     class PeerConnectionObject;
-    class PeerConnectionStatsCollectorCallback;
-    using DelegateCollectStats =
-        void (*)(PeerConnectionObject*, PeerConnectionStatsCollectorCallback*, const RTCStatsReport*);
     class PeerConnectionStatsCollectorCallback : public RTCStatsCollectorCallback
     {
     public:
@@ -21,16 +18,12 @@ namespace webrtc
         static rtc::scoped_refptr<PeerConnectionStatsCollectorCallback> Create(PeerConnectionObject* connection);
         void OnStatsDelivered(const rtc::scoped_refptr<const RTCStatsReport>& report) override;
 
-        static void RegisterOnGetStats(DelegateCollectStats callback) { s_collectStatsCallback = callback; }
-
     protected:
         explicit PeerConnectionStatsCollectorCallback(PeerConnectionObject* owner) { m_owner = owner; }
         ~PeerConnectionStatsCollectorCallback() override = default;
 
     private:
         PeerConnectionObject* m_owner = nullptr;
-
-        static DelegateCollectStats s_collectStatsCallback;
     };
 } // end namespace webrtc
 } // end namespace unity
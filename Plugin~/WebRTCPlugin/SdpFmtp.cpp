@@ -0,0 +1,59 @@
+#include "pch.h"
+
+#include <cstring>
+
+#include "SdpFmtp.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    void ParseSdpFmtp(std::string_view line, SdpFmtpParameters* parameters)
+    {
+        ForEachSdpFmtpParameter(
+            line,
+            [parameters](std::string_view key, std::string_view value)
+            { parameters->emplace(std::string(key), std::string(value)); });
+    }
+
+    size_t SdpFmtpLength(const SdpFmtpParameters& parameters)
+    {
+        if (parameters.empty())
+            return 0;
+
+        // A '=' for each pair and a ';' between pairs.
+        size_t length = parameters.size() * 2 - 1;
+        for (const auto& pair : parameters)
+            length += pair.first.size() + pair.second.size();
+        return length;
+    }
+
+    char* WriteSdpFmtp(const SdpFmtpParameters& parameters, char* dst)
+    {
+        bool first = true;
+        for (const auto& pair : parameters)
+        {
+            if (!first)
+                *dst++ = ';';
+            first = false;
+            std::memcpy(dst, pair.first.data(), pair.first.size());
+            dst += pair.first.size();
+            *dst++ = '=';
+            std::memcpy(dst, pair.second.data(), pair.second.size());
+            dst += pair.second.size();
+        }
+        *dst = '\0';
+        return dst;
+    }
+
+    std::string SerializeSdpFmtp(const SdpFmtpParameters& parameters)
+    {
+        const size_t length = SdpFmtpLength(parameters);
+        std::string line(length + 1, '\0');
+        WriteSdpFmtp(parameters, line.data());
+        line.resize(length);
+        return line;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace unity
+{
+namespace webrtc
+{
+    using SdpFmtpParameters = std::map<std::string, std::string>;
+
+    // Calls `callback(key, value)` for each "key=value" pair of a fmtp line
+    // separated by ';', without copying the line. Empty pairs are skipped, a
+    // pair without '=' has an empty value, and the value ends at the next '='.
+    // The first value of a duplicated key is used by `ParseSdpFmtp`.
+    template<typename Callback>
+    void ForEachSdpFmtpParameter(std::string_view line, Callback&& callback)
+    {
+        while (!line.empty())
+        {
+            const size_t end = line.find(';');
+            const std::string_view pair = line.substr(0, end);
+            line = end == std::string_view::npos ? std::string_view() : line.substr(end + 1);
+            if (pair.empty())
+                continue;
+
+            const size_t separator = pair.find('=');
+            if (separator == std::string_view::npos)
+            {
+                callback(pair, std::string_view());
+                continue;
+            }
+            std::string_view value = pair.substr(separator + 1);
+            value = value.substr(0, value.find('='));
+            callback(pair.substr(0, separator), value);
+        }
+    }
+
+    void ParseSdpFmtp(std::string_view line, SdpFmtpParameters* parameters);
+
+    // Length of the serialized line without the null terminator.
+    size_t SdpFmtpLength(const SdpFmtpParameters& parameters);
+
+    // Writes "key=value" pairs separated by ';' and a null terminator to `dst`,
+    // which must have room for `SdpFmtpLength(parameters) + 1` characters.
+    // Returns the pointer to the null terminator.
+    char* WriteSdpFmtp(const SdpFmtpParameters& parameters, char* dst);
+
+    std::string SerializeSdpFmtp(const SdpFmtpParameters& parameters);
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,45 @@
+#include "pch.h"
+
+#include "SessionDescriptionCache.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    std::shared_ptr<const SessionDescriptionCache::Entry> SessionDescriptionCache::Get(
+        RTCSessionDescriptionSource source, const SessionDescriptionInterface* description)
+    {
+        // The generation is read before serializing, so that a modification
+        // made during serialization is picked up by the next call.
+        const uint64_t generation = generation_.load(std::memory_order_acquire);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[static_cast<size_t>(source)];
+        if (description == nullptr)
+        {
+            slot = Slot();
+            return nullptr;
+        }
+        if (slot.entry && slot.description == description && slot.generation == generation)
+            return slot.entry;
+
+        std::string sdp;
+        description->ToString(&sdp);
+        serializeCount_++;
+
+        const SdpType type = description->GetType();
+        if (!slot.entry || slot.entry->type != type || slot.entry->sdp != sdp)
+            slot.entry = std::make_shared<const Entry>(Entry { ++lastHandle_, type, std::move(sdp) });
+        slot.description = description;
+        slot.generation = generation;
+        return slot.entry;
+    }
+
+    size_t SessionDescriptionCache::serializeCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return serializeCount_;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
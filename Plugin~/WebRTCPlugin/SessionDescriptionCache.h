@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <api/jsep.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Data format used by the managed code.
+    enum class RTCSessionDescriptionSource : int32_t
+    {
+        Local = 0,
+        Remote = 1,
+        PendingLocal = 2,
+        PendingRemote = 3,
+        CurrentLocal = 4,
+        CurrentRemote = 5,
+    };
+
+    // Keeps the last SDP string of each description of a peer connection, so
+    // that reading a description which has not changed neither serializes it
+    // again nor copies it to the managed code. Each distinct string gets a
+    // handle, which the managed code compares with the one it has already
+    // converted.
+    class SessionDescriptionCache
+    {
+    public:
+        using Handle = uint64_t;
+        static constexpr Handle kInvalidHandle = 0;
+
+        struct Entry
+        {
+            Handle handle;
+            SdpType type;
+            std::string sdp;
+        };
+
+        SessionDescriptionCache() = default;
+        SessionDescriptionCache(const SessionDescriptionCache&) = delete;
+        SessionDescriptionCache& operator=(const SessionDescriptionCache&) = delete;
+
+        // Safe to call from any thread. Must be called after a description is
+        // modified in place, such as when an ICE candidate is added to it.
+        // Replaced descriptions are detected without it.
+        void Invalidate() { generation_.fetch_add(1, std::memory_order_acq_rel); }
+
+        // Returns null if `description` is null. The entry keeps its handle
+        // when the description is serialized again to the same string.
+        std::shared_ptr<const Entry>
+        Get(RTCSessionDescriptionSource source, const SessionDescriptionInterface* description);
+
+        size_t serializeCount() const;
+
+    private:
+        struct Slot
+        {
+            const SessionDescriptionInterface* description = nullptr;
+            uint64_t generation = 0;
+            std::shared_ptr<const Entry> entry;
+        };
+
+        std::atomic<uint64_t> generation_ { 0 };
+        mutable std::mutex mutex_;
+        std::array<Slot, 6> slots_;
+        Handle lastHandle_ = kInvalidHandle;
+        size_t serializeCount_ = 0;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
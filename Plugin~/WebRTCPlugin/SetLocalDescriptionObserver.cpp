@@ -22,6 +22,7 @@ namespace webrtc
 
     void SetLocalDescriptionObserver::OnSetLocalDescriptionComplete(RTCError error)
     {
+        m_connection->InvalidateSessionDescriptions();
         s_setLocalDescCallback(m_connection, this, error.type(), error.message());
     }
 } // end namespace webrtc
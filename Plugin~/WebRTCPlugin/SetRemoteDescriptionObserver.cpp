@@ -22,6 +22,7 @@ namespace webrtc
 
     void SetRemoteDescriptionObserver::OnSetRemoteDescriptionComplete(RTCError error)
     {
+        m_connection->InvalidateSessionDescriptions();
         s_setRemoteDescCallback(m_connection, this, error.type(), error.message());
     }
 } // end namespace webrtc
@@ -0,0 +1,138 @@
+#include "pch.h"
+
+#include "StatsReportRegistry.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        template<typename T>
+        size_t SequenceSize(const RTCStatsMemberInterface& member)
+        {
+            return member.cast_to<RTCStatsMember<std::vector<T>>>()->value().capacity() * sizeof(T);
+        }
+
+        template<typename T>
+        size_t MapSize(const RTCStatsMemberInterface& member)
+        {
+            size_t size = 0;
+            for (const auto& pair : *member.cast_to<RTCStatsMember<std::map<std::string, T>>>())
+                size += sizeof(pair) + pair.first.capacity();
+            return size;
+        }
+
+        // Memory held by the value outside of the member object.
+        size_t EstimateMemberSize(const RTCStatsMemberInterface& member)
+        {
+            if (!member.is_defined())
+                return 0;
+
+            switch (member.type())
+            {
+            case RTCStatsMemberInterface::kString:
+                return member.cast_to<RTCStatsMember<std::string>>()->value().capacity();
+            case RTCStatsMemberInterface::kSequenceBool:
+                return member.cast_to<RTCStatsMember<std::vector<bool>>>()->value().capacity() / 8;
+            case RTCStatsMemberInterface::kSequenceInt32:
+                return SequenceSize<int32_t>(member);
+            case RTCStatsMemberInterface::kSequenceUint32:
+                return SequenceSize<uint32_t>(member);
+            case RTCStatsMemberInterface::kSequenceInt64:
+                return SequenceSize<int64_t>(member);
+            case RTCStatsMemberInterface::kSequenceUint64:
+                return SequenceSize<uint64_t>(member);
+            case RTCStatsMemberInterface::kSequenceDouble:
+                return SequenceSize<double>(member);
+            case RTCStatsMemberInterface::kSequenceString:
+            {
+                size_t size = SequenceSize<std::string>(member);
+                for (const std::string& str : *member.cast_to<RTCStatsMember<std::vector<std::string>>>())
+                    size += str.capacity();
+                return size;
+            }
+            case RTCStatsMemberInterface::kMapStringUint64:
+                return MapSize<uint64_t>(member);
+            case RTCStatsMemberInterface::kMapStringDouble:
+                return MapSize<double>(member);
+            default:
+                return 0;
+            }
+        }
+    } // namespace
+
+    StatsReportRegistry::StatsReportRegistry(Clock* clock)
+        : clock_(clock)
+    {
+    }
+
+    void StatsReportRegistry::Add(const rtc::scoped_refptr<const RTCStatsReport>& report)
+    {
+        const Timestamp now = clock_->CurrentTime();
+        ReleaseExpiredReports(now);
+        entries_.insert_or_assign(report.get(), Entry { report, now, EstimateSize(*report), {} });
+    }
+
+    StatsReportRegistry::Entry* StatsReportRegistry::Find(const RTCStatsReport* report)
+    {
+        auto it = entries_.find(report);
+        if (it == entries_.end())
+            return nullptr;
+        it->second.lastAccessTime = clock_->CurrentTime();
+        return &it->second;
+    }
+
+    bool StatsReportRegistry::Remove(const RTCStatsReport* report) { return entries_.erase(report) > 0; }
+
+    void StatsReportRegistry::SetTimeToLive(TimeDelta timeToLive)
+    {
+        timeToLive_ = timeToLive;
+        lastExpiryTime_ = Timestamp::MinusInfinity();
+    }
+
+    size_t StatsReportRegistry::memoryUsage() const
+    {
+        size_t size = 0;
+        for (const auto& pair : entries_)
+            size += pair.second.reportBytes + pair.second.snapshot.capacity();
+        return size;
+    }
+
+    size_t StatsReportRegistry::EstimateSize(const RTCStatsReport& report)
+    {
+        size_t size = sizeof(RTCStatsReport);
+        for (const RTCStats& stats : report)
+        {
+            std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+            // The stats object has a member object per member, which holds the
+            // value and the flag whether it is defined.
+            size += sizeof(RTCStats) + stats.id().capacity() + members.size() * (sizeof(RTCStatsMember<double>));
+            for (const RTCStatsMemberInterface* member : members)
+                size += EstimateMemberSize(*member);
+        }
+        return size;
+    }
+
+    void StatsReportRegistry::ReleaseExpiredReports(Timestamp now)
+    {
+        if (timeToLive_.IsPlusInfinity() || now - lastExpiryTime_ < kExpiryInterval)
+            return;
+        lastExpiryTime_ = now;
+
+        for (auto it = entries_.begin(); it != entries_.end();)
+        {
+            if (now - it->second.lastAccessTime < timeToLive_)
+            {
+                ++it;
+                continue;
+            }
+            RTC_LOG(LS_INFO) << "RTCStatsReport is released because it has not been accessed for "
+                             << timeToLive_.ms() << " ms.";
+            it = entries_.erase(it);
+            expiredCount_++;
+        }
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <api/stats/rtc_stats_report.h>
+#include <api/units/time_delta.h>
+#include <system_wrappers/include/clock.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Keeps the reports passed to the managed code, keyed by the pointer which
+    // the managed code holds. When a finite time to live is set, reports which
+    // are not accessed for that time are released, so that reports the managed
+    // code never deletes do not accumulate. The managed stats objects and their
+    // members point into the report without accessing the registry, so the time
+    // to live is opt-in: a released report must not be used, and its address
+    // may be reused by a later report. The registry is not thread-safe.
+    class StatsReportRegistry
+    {
+    public:
+        static constexpr TimeDelta kDefaultTimeToLive = TimeDelta::PlusInfinity();
+
+        struct Entry
+        {
+            rtc::scoped_refptr<const RTCStatsReport> report;
+            Timestamp lastAccessTime;
+            // Estimated memory held by the report.
+            size_t reportBytes;
+            std::vector<uint8_t> snapshot;
+        };
+
+        explicit StatsReportRegistry(Clock* clock);
+        StatsReportRegistry(const StatsReportRegistry&) = delete;
+        StatsReportRegistry& operator=(const StatsReportRegistry&) = delete;
+
+        void Add(const rtc::scoped_refptr<const RTCStatsReport>& report);
+        // Returns nullptr if the report is not found. Accessing the report
+        // extends the expiry.
+        Entry* Find(const RTCStatsReport* report);
+        bool Remove(const RTCStatsReport* report);
+
+        // Reports are never released when the time to live is infinite.
+        void SetTimeToLive(TimeDelta timeToLive);
+        TimeDelta timeToLive() const { return timeToLive_; }
+
+        size_t size() const { return entries_.size(); }
+        // Estimated memory held by the reports and their snapshots.
+        size_t memoryUsage() const;
+        uint64_t expiredCount() const { return expiredCount_; }
+
+        static size_t EstimateSize(const RTCStatsReport& report);
+
+    private:
+        // Expired reports are looked for at most once per interval, which keeps
+        // the cost of `Add` constant.
+        static constexpr TimeDelta kExpiryInterval = TimeDelta::Seconds(1);
+
+        void ReleaseExpiredReports(Timestamp now);
+
+        Clock* clock_;
+        TimeDelta timeToLive_ = kDefaultTimeToLive;
+        Timestamp lastExpiryTime_ = Timestamp::MinusInfinity();
+        uint64_t expiredCount_ = 0;
+        std::unordered_map<const RTCStatsReport*, Entry> entries_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
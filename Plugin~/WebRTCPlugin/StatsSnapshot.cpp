@@ -0,0 +1,217 @@
+#include "pch.h"
+
+#include <cstring>
+
+#include "Context.h"
+#include "StatsSnapshot.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        size_t Align8(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+        template<typename T>
+        uint64_t ToBits(T value)
+        {
+            return static_cast<uint64_t>(value);
+        }
+
+        template<>
+        uint64_t ToBits(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        template<>
+        uint64_t ToBits(int32_t value)
+        {
+            return static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+
+        template<typename T>
+        void CopySection(uint8_t* dst, size_t offset, const std::vector<T>& src)
+        {
+            if (!src.empty())
+                std::memcpy(dst + offset, src.data(), sizeof(T) * src.size());
+        }
+    } // namespace
+
+    void StatsSnapshotWriter::Write(const RTCStatsReport& report, std::vector<uint8_t>* snapshot)
+    {
+        stats_.clear();
+        members_.clear();
+        strings_.clear();
+        values_.clear();
+        chars_.clear();
+        stringIndices_.clear();
+
+        for (const RTCStats& stats : report)
+            AddStats(stats);
+
+        StatsSnapshotHeader header = {};
+        header.magic = kStatsSnapshotMagic;
+        header.version = kStatsSnapshotVersion;
+        header.statsCount = static_cast<uint32_t>(stats_.size());
+        header.memberCount = static_cast<uint32_t>(members_.size());
+        header.stringCount = static_cast<uint32_t>(strings_.size());
+        header.valueCount = static_cast<uint32_t>(values_.size());
+
+        size_t offset = sizeof(StatsSnapshotHeader);
+        header.statsOffset = static_cast<uint32_t>(offset);
+        offset += sizeof(StatsSnapshotStats) * stats_.size();
+        header.membersOffset = static_cast<uint32_t>(offset);
+        offset += sizeof(StatsSnapshotMember) * members_.size();
+        header.stringsOffset = static_cast<uint32_t>(offset);
+        offset = Align8(offset + sizeof(StatsSnapshotString) * strings_.size());
+        header.valuesOffset = static_cast<uint32_t>(offset);
+        offset += sizeof(uint64_t) * values_.size();
+        header.charsOffset = static_cast<uint32_t>(offset);
+        offset = Align8(offset + chars_.size());
+        header.size = static_cast<uint32_t>(offset);
+
+        snapshot->assign(offset, 0);
+        uint8_t* data = snapshot->data();
+        std::memcpy(data, &header, sizeof(header));
+        CopySection(data, header.statsOffset, stats_);
+        CopySection(data, header.membersOffset, members_);
+        CopySection(data, header.stringsOffset, strings_);
+        CopySection(data, header.valuesOffset, values_);
+        if (!chars_.empty())
+            std::memcpy(data + header.charsOffset, chars_.data(), chars_.size());
+    }
+
+    void StatsSnapshotWriter::AddStats(const RTCStats& stats)
+    {
+        auto type = statsTypes.find(stats.type());
+
+        StatsSnapshotStats entry = {};
+        entry.id = AddString(stats.id());
+        entry.type = type != statsTypes.end() ? type->second : UINT32_MAX;
+        entry.timestampUs = stats.timestamp().us();
+        entry.firstMember = static_cast<uint32_t>(members_.size());
+        for (const RTCStatsMemberInterface* member : stats.Members())
+            AddMember(*member);
+        entry.memberCount = static_cast<uint32_t>(members_.size()) - entry.firstMember;
+        stats_.push_back(entry);
+    }
+
+    void StatsSnapshotWriter::AddMember(const RTCStatsMemberInterface& member)
+    {
+        StatsSnapshotMember entry = {};
+        entry.name = AddString(member.name());
+        entry.type = static_cast<uint8_t>(member.type());
+        entry.defined = member.is_defined();
+        if (!member.is_defined())
+        {
+            members_.push_back(entry);
+            return;
+        }
+
+        auto addSequence = [this, &entry](const auto& sequence)
+        {
+            entry.count = static_cast<uint32_t>(sequence.size());
+            entry.value = values_.size();
+            for (const auto& element : sequence)
+                AddValue(ToBits(element));
+        };
+        auto addMap = [this, &entry](const auto& map)
+        {
+            entry.count = static_cast<uint32_t>(map.size());
+            entry.value = values_.size();
+            for (const auto& pair : map)
+            {
+                AddValue(AddString(pair.first));
+                AddValue(ToBits(pair.second));
+            }
+        };
+
+        switch (member.type())
+        {
+        case RTCStatsMemberInterface::kBool:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<bool>>());
+            break;
+        case RTCStatsMemberInterface::kInt32:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<int32_t>>());
+            break;
+        case RTCStatsMemberInterface::kUint32:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<uint32_t>>());
+            break;
+        case RTCStatsMemberInterface::kInt64:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<int64_t>>());
+            break;
+        case RTCStatsMemberInterface::kUint64:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<uint64_t>>());
+            break;
+        case RTCStatsMemberInterface::kDouble:
+            entry.value = ToBits(*member.cast_to<RTCStatsMember<double>>());
+            break;
+        case RTCStatsMemberInterface::kString:
+            entry.value = AddString(*member.cast_to<RTCStatsMember<std::string>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceBool:
+        {
+            // std::vector<bool> does not give references to the elements.
+            const std::vector<bool>& sequence = *member.cast_to<RTCStatsMember<std::vector<bool>>>();
+            entry.count = static_cast<uint32_t>(sequence.size());
+            entry.value = values_.size();
+            for (bool element : sequence)
+                AddValue(element ? 1 : 0);
+            break;
+        }
+        case RTCStatsMemberInterface::kSequenceInt32:
+            addSequence(*member.cast_to<RTCStatsMember<std::vector<int32_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceUint32:
+            addSequence(*member.cast_to<RTCStatsMember<std::vector<uint32_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceInt64:
+            addSequence(*member.cast_to<RTCStatsMember<std::vector<int64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceUint64:
+            addSequence(*member.cast_to<RTCStatsMember<std::vector<uint64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceDouble:
+            addSequence(*member.cast_to<RTCStatsMember<std::vector<double>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceString:
+        {
+            const std::vector<std::string>& sequence =
+                *member.cast_to<RTCStatsMember<std::vector<std::string>>>();
+            entry.count = static_cast<uint32_t>(sequence.size());
+            entry.value = values_.size();
+            for (const std::string& element : sequence)
+                AddValue(AddString(element));
+            break;
+        }
+        case RTCStatsMemberInterface::kMapStringUint64:
+            addMap(*member.cast_to<RTCStatsMember<std::map<std::string, uint64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kMapStringDouble:
+            addMap(*member.cast_to<RTCStatsMember<std::map<std::string, double>>>());
+            break;
+        }
+        members_.push_back(entry);
+    }
+
+    uint32_t StatsSnapshotWriter::AddString(const std::string& str)
+    {
+        auto it = stringIndices_.find(str);
+        if (it != stringIndices_.end())
+            return it->second;
+
+        const uint32_t index = static_cast<uint32_t>(strings_.size());
+        strings_.push_back({ static_cast<uint32_t>(chars_.size()), static_cast<uint32_t>(str.size()) });
+        chars_.append(str);
+        stringIndices_.emplace(str, index);
+        return index;
+    }
+
+    void StatsSnapshotWriter::AddValue(uint64_t value) { values_.push_back(value); }
+
+} // end namespace webrtc
+} // end namespace unity
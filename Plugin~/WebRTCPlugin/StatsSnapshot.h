@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <api/stats/rtc_stats_report.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Flat binary form of RTCStatsReport which the managed code reads with
+    // one native call. All offsets are in bytes from the start of the
+    // snapshot, and all sections are aligned to 8 bytes.
+    //
+    //   StatsSnapshotHeader
+    //   StatsSnapshotStats[statsCount]
+    //   StatsSnapshotMember[memberCount], members of each stats are contiguous
+    //   StatsSnapshotString[stringCount]
+    //   uint64_t[valueCount], elements of sequences and entries of maps
+    //   char[], UTF-8 strings without terminators
+    constexpr uint32_t kStatsSnapshotMagic = 0x53435452; // "RTCS"
+    constexpr uint32_t kStatsSnapshotVersion = 1;
+
+    // Data format used by the managed code.
+    struct StatsSnapshotHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;
+        uint32_t statsCount;
+        uint32_t memberCount;
+        uint32_t stringCount;
+        uint32_t valueCount;
+        uint32_t statsOffset;
+        uint32_t membersOffset;
+        uint32_t stringsOffset;
+        uint32_t valuesOffset;
+        uint32_t charsOffset;
+    };
+    static_assert(sizeof(StatsSnapshotHeader) == 48, "The size must match the managed code.");
+
+    // Data format used by the managed code.
+    struct StatsSnapshotStats
+    {
+        uint32_t id; // index of the string table
+        uint32_t type; // value of RTCStatsType in the managed code
+        int64_t timestampUs;
+        uint32_t firstMember;
+        uint32_t memberCount;
+    };
+    static_assert(sizeof(StatsSnapshotStats) == 24, "The size must match the managed code.");
+
+    // Data format used by the managed code.
+    //
+    // `value` holds the bits of scalar values: bool and integers widened to
+    // 64 bits, and doubles as they are. It holds the index of the string table
+    // for strings. Sequences have `count` elements in the value slots starting
+    // at `value`, and maps have `count` pairs of a key string index and a value.
+    struct StatsSnapshotMember
+    {
+        uint32_t name; // index of the string table
+        uint8_t type; // RTCStatsMemberInterface::Type
+        uint8_t defined;
+        uint16_t reserved;
+        uint32_t count;
+        uint32_t reserved2;
+        uint64_t value;
+    };
+    static_assert(sizeof(StatsSnapshotMember) == 24, "The size must match the managed code.");
+
+    // Data format used by the managed code.
+    struct StatsSnapshotString
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    class StatsSnapshotWriter
+    {
+    public:
+        StatsSnapshotWriter() = default;
+        StatsSnapshotWriter(const StatsSnapshotWriter&) = delete;
+        StatsSnapshotWriter& operator=(const StatsSnapshotWriter&) = delete;
+
+        // Replaces the contents of `snapshot`. The buffer is reused when it has
+        // enough capacity.
+        void Write(const RTCStatsReport& report, std::vector<uint8_t>* snapshot);
+
+    private:
+        void AddStats(const RTCStats& stats);
+        void AddMember(const RTCStatsMemberInterface& member);
+        uint32_t AddString(const std::string& str);
+        void AddValue(uint64_t value);
+
+        std::vector<StatsSnapshotStats> stats_;
+        std::vector<StatsSnapshotMember> members_;
+        std::vector<StatsSnapshotString> strings_;
+        std::vector<uint64_t> values_;
+        std::string chars_;
+        // Member names and ids repeat across stats and reports.
+        std::unordered_map<std::string, uint32_t> stringIndices_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,239 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+#include "Context.h"
+#include "StatsSubscription.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        absl::optional<double> GetNumber(const RTCStatsMemberInterface& member)
+        {
+            if (!member.is_defined())
+                return absl::nullopt;
+
+            switch (member.type())
+            {
+            case RTCStatsMemberInterface::kBool:
+                return *member.cast_to<RTCStatsMember<bool>>() ? 1.0 : 0.0;
+            case RTCStatsMemberInterface::kInt32:
+                return static_cast<double>(*member.cast_to<RTCStatsMember<int32_t>>());
+            case RTCStatsMemberInterface::kUint32:
+                return static_cast<double>(*member.cast_to<RTCStatsMember<uint32_t>>());
+            case RTCStatsMemberInterface::kInt64:
+                return static_cast<double>(*member.cast_to<RTCStatsMember<int64_t>>());
+            case RTCStatsMemberInterface::kUint64:
+                return static_cast<double>(*member.cast_to<RTCStatsMember<uint64_t>>());
+            case RTCStatsMemberInterface::kDouble:
+                return *member.cast_to<RTCStatsMember<double>>();
+            default:
+                return absl::nullopt;
+            }
+        }
+
+        // Cumulative members of the stats objects, whose rate of change is
+        // reported. The type of a member does not tell a counter from a gauge,
+        // like "frameWidth" and "ssrc" are integers and "packetsLost" is signed.
+        constexpr std::string_view kCounters[] = {
+            "bytesDiscardedOnSend",
+            "bytesReceived",
+            "bytesSent",
+            "concealedSamples",
+            "concealmentEvents",
+            "consentRequestsSent",
+            "dataChannelsClosed",
+            "dataChannelsOpened",
+            "fecPacketsDiscarded",
+            "fecPacketsReceived",
+            "firCount",
+            "framesAssembledFromMultiplePackets",
+            "framesDecoded",
+            "framesDropped",
+            "framesEncoded",
+            "framesReceived",
+            "framesSent",
+            "freezeCount",
+            "headerBytesReceived",
+            "headerBytesSent",
+            "hugeFramesSent",
+            "insertedSamplesForDeceleration",
+            "jitterBufferDelay",
+            "jitterBufferEmittedCount",
+            "jitterBufferMinimumDelay",
+            "jitterBufferTargetDelay",
+            "keyFramesDecoded",
+            "keyFramesEncoded",
+            "messagesReceived",
+            "messagesSent",
+            "nackCount",
+            "packetsDiscarded",
+            "packetsDiscardedOnSend",
+            "packetsLost",
+            "packetsReceived",
+            "packetsSent",
+            "pauseCount",
+            "pliCount",
+            "qpSum",
+            "removedSamplesForAcceleration",
+            "requestsReceived",
+            "requestsSent",
+            "responsesReceived",
+            "responsesSent",
+            "retransmittedBytesSent",
+            "retransmittedPacketsSent",
+            "roundTripTimeMeasurements",
+            "selectedCandidatePairChanges",
+            "silentConcealedSamples",
+            "totalAssemblyTime",
+            "totalAudioEnergy",
+            "totalDecodeTime",
+            "totalEncodeTime",
+            "totalEncodedBytesTarget",
+            "totalFreezesDuration",
+            "totalInterFrameDelay",
+            "totalPacketSendDelay",
+            "totalPausesDuration",
+            "totalProcessingDelay",
+            "totalRoundTripTime",
+            "totalSamplesDuration",
+            "totalSamplesReceived",
+            "totalSamplesSent",
+            "totalSquaredInterFrameDelay",
+        };
+
+        bool IsCounter(std::string_view name)
+        {
+            return std::binary_search(std::begin(kCounters), std::end(kCounters), name);
+        }
+    } // namespace
+
+    rtc::scoped_refptr<StatsSubscription>
+    StatsSubscription::Create(const std::vector<uint32_t>& types, const std::vector<std::string>& members)
+    {
+        return rtc::make_ref_counted<StatsSubscription>(types, members);
+    }
+
+    StatsSubscription::StatsSubscription(const std::vector<uint32_t>& types, const std::vector<std::string>& members)
+        : types_(types.begin(), types.end())
+        , members_(members)
+    {
+        RTC_DCHECK(std::is_sorted(std::begin(kCounters), std::end(kCounters)));
+        for (const std::string& member : members_)
+            counters_.push_back(IsCounter(member));
+    }
+
+    void StatsSubscription::OnStatsDelivered(const rtc::scoped_refptr<const RTCStatsReport>& report)
+    {
+        Update(*report);
+    }
+
+    void StatsSubscription::Update(const RTCStatsReport& report)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::set<std::string_view> reported;
+        for (const RTCStats& stats : report)
+        {
+            auto type = statsTypes.find(stats.type());
+            if (type == statsTypes.end() || (!types_.empty() && types_.count(type->second) == 0))
+                continue;
+
+            StatsState& state = GetState(stats.id());
+            reported.insert(stats.id());
+            const int64_t timestampUs = stats.timestamp().us();
+            const double elapsed = static_cast<double>(timestampUs - state.timestampUs) / 1000000.0;
+
+            for (const RTCStatsMemberInterface* member : stats.Members())
+            {
+                auto name = std::find(members_.begin(), members_.end(), member->name());
+                if (name == members_.end())
+                    continue;
+                const size_t index = static_cast<size_t>(name - members_.begin());
+
+                absl::optional<double> value = GetNumber(*member);
+                absl::optional<double>& previous = state.values[index];
+                absl::optional<double>& rate = state.rates[index];
+                if (!value)
+                    continue;
+                const bool hasRate = counters_[index] && previous && elapsed > 0;
+                // A counter which stopped changing is queued once with the
+                // rate of zero.
+                if (value == previous && (!hasRate || rate == 0.0))
+                    continue;
+
+                StatsDelta delta = {};
+                delta.id = state.id;
+                delta.timestampUs = timestampUs;
+                delta.value = *value;
+                delta.key = state.key;
+                delta.type = type->second;
+                delta.member = static_cast<uint32_t>(index);
+                if (hasRate)
+                {
+                    delta.rate = (*value - *previous) / elapsed;
+                    delta.hasRate = 1;
+                    rate = delta.rate;
+                }
+                writing_.push_back(delta);
+                previous = value;
+            }
+            state.timestampUs = timestampUs;
+        }
+
+        for (auto it = states_.begin(); it != states_.end();)
+        {
+            auto next = std::next(it);
+            if (reported.count(it->first) == 0)
+                removedWriting_.push_back(states_.extract(it));
+            it = next;
+        }
+    }
+
+    int32_t StatsSubscription::Poll(const StatsDelta** deltas)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::swap(writing_, reading_);
+        writing_.clear();
+
+        removedReading_.clear();
+        std::swap(removedWriting_, removedReading_);
+        removedKeys_.clear();
+        for (const auto& node : removedReading_)
+            removedKeys_.push_back(node.mapped().key);
+
+        *deltas = reading_.data();
+        return static_cast<int32_t>(reading_.size());
+    }
+
+    int32_t StatsSubscription::RemovedKeys(const uint32_t** keys)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *keys = removedKeys_.data();
+        return static_cast<int32_t>(removedKeys_.size());
+    }
+
+    StatsSubscription::StatsState& StatsSubscription::GetState(const std::string& id)
+    {
+        auto it = states_.find(id);
+        if (it != states_.end())
+            return it->second;
+
+        StatsState state;
+        state.key = nextKey_++;
+        state.timestampUs = 0;
+        state.values.resize(members_.size());
+        state.rates.resize(members_.size());
+        it = states_.emplace(id, std::move(state)).first;
+        it->second.id = it->first.c_str();
+        return it->second;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
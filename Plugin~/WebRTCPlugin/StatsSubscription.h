@@ -0,0 +1,99 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <absl/types/optional.h>
+#include <api/stats/rtc_stats_collector_callback.h>
+#include <api/stats/rtc_stats_report.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Data format used by the managed code.
+    struct StatsDelta
+    {
+        // Id of the stats object, valid until the next poll after the stats
+        // object is removed from the report.
+        const char* id;
+        int64_t timestampUs;
+        double value;
+        // Change of a cumulative counter per second since the previous report.
+        double rate;
+        // Number assigned to the stats id, which is never reused by the subscription.
+        uint32_t key;
+        uint32_t type;
+        // Index of the member name of the filter.
+        uint32_t member;
+        int32_t hasRate;
+    };
+
+    // Collects only the members of the filter, and queues the values which have
+    // changed since the previous report. The managed code requests stats with
+    // the subscription as the callback, then drains the changes with `Poll`
+    // without having the whole report marshalled. The state of a stats object
+    // missing from a report is removed, and its key is reported by
+    // `RemovedKeys` so that the managed code drops the id it caches.
+    class StatsSubscription : public RTCStatsCollectorCallback
+    {
+    public:
+        static rtc::scoped_refptr<StatsSubscription>
+        Create(const std::vector<uint32_t>& types, const std::vector<std::string>& members);
+
+        // Processes the report and queues the changed values.
+        void Update(const RTCStatsReport& report);
+
+        // Returns the values queued since the previous call. The array stays
+        // valid until the next call.
+        int32_t Poll(const StatsDelta** deltas);
+        // Returns the keys of the stats objects removed before the last call
+        // of `Poll`, valid until the next call of it.
+        int32_t RemovedKeys(const uint32_t** keys);
+
+        // webrtc::RTCStatsCollectorCallback
+        void OnStatsDelivered(const rtc::scoped_refptr<const RTCStatsReport>& report) override;
+
+    protected:
+        StatsSubscription(const std::vector<uint32_t>& types, const std::vector<std::string>& members);
+        ~StatsSubscription() override = default;
+
+    private:
+        struct StatsState
+        {
+            uint32_t key;
+            const char* id;
+            int64_t timestampUs;
+            std::vector<absl::optional<double>> values;
+            // Rates queued last, for the counters of the filter.
+            std::vector<absl::optional<double>> rates;
+        };
+
+        StatsState& GetState(const std::string& id);
+
+        const std::set<uint32_t> types_;
+        const std::vector<std::string> members_;
+        // Whether each member of the filter is a cumulative counter.
+        std::vector<bool> counters_;
+
+        using StatsMap = std::map<std::string, StatsState>;
+
+        std::mutex mutex_;
+        // The id of a delta points to the id string in the map node, so removed
+        // nodes are kept like the deltas until the managed code has read them.
+        StatsMap states_;
+        uint32_t nextKey_ = 0;
+        std::vector<StatsDelta> writing_;
+        std::vector<StatsDelta> reading_;
+        std::vector<StatsMap::node_type> removedWriting_;
+        std::vector<StatsMap::node_type> removedReading_;
+        std::vector<uint32_t> removedKeys_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
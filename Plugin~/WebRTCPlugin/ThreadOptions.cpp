@@ -0,0 +1,81 @@
+#include "pch.h"
+
+#if UNITY_LINUX || UNITY_ANDROID
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif UNITY_OSX || UNITY_IOS || UNITY_IOS_SIMULATOR
+#include <pthread.h>
+#endif
+
+#include "ThreadOptions.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        bool SetPriority(ThreadPriorityHint priority)
+        {
+            if (priority == ThreadPriorityHint::kNormal)
+                return true;
+#if UNITY_WIN
+            const int value =
+                priority == ThreadPriorityHint::kHigh ? THREAD_PRIORITY_ABOVE_NORMAL : THREAD_PRIORITY_BELOW_NORMAL;
+            return SetThreadPriority(GetCurrentThread(), value) != 0;
+#elif UNITY_LINUX || UNITY_ANDROID
+            // The nice value applies to the thread on Linux. Raising the priority
+            // needs a permission which the process may not have.
+            const int nice = priority == ThreadPriorityHint::kHigh ? -5 : 5;
+            return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) == 0;
+#elif UNITY_OSX || UNITY_IOS || UNITY_IOS_SIMULATOR
+            const qos_class_t qos =
+                priority == ThreadPriorityHint::kHigh ? QOS_CLASS_USER_INTERACTIVE : QOS_CLASS_UTILITY;
+            return pthread_set_qos_class_self_np(qos, 0) == 0;
+#else
+            return false;
+#endif
+        }
+
+        bool SetAffinity(uint64_t mask)
+        {
+            if (mask == 0)
+                return true;
+#if UNITY_WIN
+            return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif UNITY_LINUX || UNITY_ANDROID
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+            {
+                if (mask & (uint64_t(1) << cpu))
+                    CPU_SET(cpu, &set);
+            }
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            // Apple platforms do not allow binding a thread to CPUs.
+            return false;
+#endif
+        }
+    } // namespace
+
+    bool ApplyThreadOptions(const ThreadOptions& options)
+    {
+        bool result = true;
+        if (!SetPriority(options.priority))
+        {
+            RTC_LOG(LS_WARNING) << "Failed to set the thread priority: " << static_cast<int>(options.priority);
+            result = false;
+        }
+        if (!SetAffinity(options.affinityMask))
+        {
+            RTC_LOG(LS_WARNING) << "Failed to set the thread affinity: " << options.affinityMask;
+            result = false;
+        }
+        return result;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
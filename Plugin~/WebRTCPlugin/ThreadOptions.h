@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    enum class ThreadPriorityHint : int32_t
+    {
+        kLow = -1,
+        kNormal = 0,
+        kHigh = 1,
+    };
+
+    // Data format used by the managed code.
+    struct ThreadOptions
+    {
+        ThreadPriorityHint priority = ThreadPriorityHint::kNormal;
+        // Bit mask of the CPUs the thread may run on. Zero leaves the thread on
+        // any CPU.
+        uint64_t affinityMask = 0;
+    };
+
+    // Data format used by the managed code.
+    struct ContextThreadOptions
+    {
+        // Socket I/O runs on its own thread instead of sharing the worker
+        // thread with codec management.
+        bool separateNetworkThread = false;
+        ThreadOptions network;
+        ThreadOptions worker;
+        ThreadOptions signaling;
+        // Number of peer connection factories, each with its own network and
+        // worker threads. Values less than 1 are treated as 1.
+        int32_t factoryShards = 1;
+    };
+
+    // Applies the hints to the calling thread. Returns false if the platform
+    // rejects or does not support one of them, which leaves the thread usable.
+    bool ApplyThreadOptions(const ThreadOptions& options);
+
+} // end namespace webrtc
+} // end namespace unity
@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include <absl/strings/match.h>
+#include <absl/strings/str_split.h>
 #include <api/audio_codecs/L16/audio_encoder_L16.h>
 #include <api/audio_codecs/audio_encoder_factory_template.h>
 #include <api/audio_codecs/g711/audio_encoder_g711.h>
@@ -7,6 +9,10 @@
 #include <api/audio_codecs/ilbc/audio_encoder_ilbc.h>
 #include <api/audio_codecs/opus/audio_encoder_multi_channel_opus.h>
 #include <api/audio_codecs/opus/audio_encoder_opus.h>
+#include <api/call/bitrate_allocation.h>
+#include <api/units/data_rate.h>
+#include <rtc_base/string_to_number.h>
+#include <rtc_base/strings/string_builder.h>
 
 #include "UnityAudioEncoderFactory.h"
 
@@ -16,6 +22,235 @@ namespace unity
 {
 namespace webrtc
 {
+    // Tells the settings apart from the configurations of the audio network
+    // adaptor of libwebrtc, which are serialized protobufs.
+    static constexpr absl::string_view kOpusEncoderSettingsPrefix = "x-unity-opus";
+    static constexpr absl::string_view kComplexityKey = "complexity";
+    static constexpr absl::string_view kPtimeKey = "ptime";
+    static constexpr absl::string_view kDtxKey = "dtx";
+    static constexpr absl::string_view kFecKey = "fec";
+    static constexpr absl::string_view kMaxBitrateKey = "maxbitrate";
+
+    bool ValidateOpusEncoderSettings(const OpusEncoderSettings& settings)
+    {
+        if (settings.complexity && (settings.complexity.value() < 0 || settings.complexity.value() > 10))
+            return false;
+        if (settings.ptimeMs)
+        {
+            const int ptime = settings.ptimeMs.value();
+            if (ptime != 10 && ptime != 20 && ptime != 40 && ptime != 60)
+                return false;
+        }
+        if (settings.maxBitrateBps &&
+            (settings.maxBitrateBps.value() < AudioEncoderOpusConfig::kMinBitrateBps ||
+             settings.maxBitrateBps.value() > AudioEncoderOpusConfig::kMaxBitrateBps))
+            return false;
+        return true;
+    }
+
+    std::string SerializeOpusEncoderSettings(const OpusEncoderSettings& settings)
+    {
+        rtc::StringBuilder sb;
+        sb << kOpusEncoderSettingsPrefix;
+        if (settings.complexity)
+            sb << ";" << kComplexityKey << "=" << settings.complexity.value();
+        if (settings.ptimeMs)
+            sb << ";" << kPtimeKey << "=" << settings.ptimeMs.value();
+        if (settings.dtx)
+            sb << ";" << kDtxKey << "=" << (settings.dtx.value() ? 1 : 0);
+        if (settings.fec)
+            sb << ";" << kFecKey << "=" << (settings.fec.value() ? 1 : 0);
+        if (settings.maxBitrateBps)
+            sb << ";" << kMaxBitrateKey << "=" << settings.maxBitrateBps.value();
+        return sb.Release();
+    }
+
+    absl::optional<OpusEncoderSettings> ParseOpusEncoderSettings(absl::string_view str)
+    {
+        std::vector<absl::string_view> fields = absl::StrSplit(str, ';');
+        if (fields.empty() || fields[0] != kOpusEncoderSettingsPrefix)
+            return absl::nullopt;
+
+        OpusEncoderSettings settings;
+        for (size_t i = 1; i < fields.size(); i++)
+        {
+            const size_t pos = fields[i].find('=');
+            if (pos == absl::string_view::npos)
+                return absl::nullopt;
+            const absl::string_view key = fields[i].substr(0, pos);
+            const absl::optional<int> value = rtc::StringToNumber<int>(fields[i].substr(pos + 1));
+            if (!value)
+                return absl::nullopt;
+
+            if (key == kComplexityKey)
+                settings.complexity = value;
+            else if (key == kPtimeKey)
+                settings.ptimeMs = value;
+            else if (key == kDtxKey)
+                settings.dtx = value.value() != 0;
+            else if (key == kFecKey)
+                settings.fec = value.value() != 0;
+            else if (key == kMaxBitrateKey)
+                settings.maxBitrateBps = value;
+            else
+                return absl::nullopt;
+        }
+        if (!ValidateOpusEncoderSettings(settings))
+            return absl::nullopt;
+        return settings;
+    }
+
+    static AudioEncoderOpusConfig ApplyOpusEncoderSettings(
+        const OpusEncoderSettings& settings, const AudioEncoderOpusConfig& base)
+    {
+        AudioEncoderOpusConfig config = base;
+        if (settings.complexity)
+        {
+            config.complexity = settings.complexity.value();
+            config.low_rate_complexity = settings.complexity.value();
+        }
+        if (settings.ptimeMs)
+            config.frame_size_ms = settings.ptimeMs.value();
+        if (settings.dtx)
+            config.dtx_enabled = settings.dtx.value();
+        if (settings.fec)
+            config.fec_enabled = settings.fec.value();
+        if (settings.maxBitrateBps && config.bitrate_bps)
+            config.bitrate_bps = std::min(config.bitrate_bps.value(), settings.maxBitrateBps.value());
+        return config;
+    }
+
+    // Forwards to an Opus encoder made from the negotiated configuration, and
+    // makes it again when the send stream passes settings of the sender with
+    // `EnableAudioNetworkAdaptor`.
+    class OpusEncoderWithSettings : public AudioEncoder
+    {
+    public:
+        OpusEncoderWithSettings(const AudioEncoderOpusConfig& config, int payloadType)
+            : config_(config)
+            , payloadType_(payloadType)
+            , encoder_(AudioEncoderOpus::MakeAudioEncoder(config, payloadType))
+        {
+        }
+
+        int SampleRateHz() const override { return encoder_->SampleRateHz(); }
+        size_t NumChannels() const override { return encoder_->NumChannels(); }
+        int RtpTimestampRateHz() const override { return encoder_->RtpTimestampRateHz(); }
+        size_t Num10MsFramesInNextPacket() const override { return encoder_->Num10MsFramesInNextPacket(); }
+        size_t Max10MsFramesInAPacket() const override { return encoder_->Max10MsFramesInAPacket(); }
+        int GetTargetBitrate() const override { return encoder_->GetTargetBitrate(); }
+        void Reset() override { encoder_->Reset(); }
+        bool SetFec(bool enable) override { return encoder_->SetFec(enable); }
+        bool SetDtx(bool enable) override { return encoder_->SetDtx(enable); }
+        bool GetDtx() const override { return encoder_->GetDtx(); }
+        bool SetApplication(Application application) override { return encoder_->SetApplication(application); }
+        void SetMaxPlaybackRate(int frequency_hz) override { encoder_->SetMaxPlaybackRate(frequency_hz); }
+        ANAStats GetANAStats() const override { return encoder_->GetANAStats(); }
+        absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange() const override
+        {
+            return encoder_->GetFrameLengthRange();
+        }
+
+        bool EnableAudioNetworkAdaptor(const std::string& config_string, RtcEventLog* event_log) override
+        {
+            absl::optional<OpusEncoderSettings> settings = ParseOpusEncoderSettings(config_string);
+            if (!settings)
+            {
+                if (absl::StartsWith(config_string, kOpusEncoderSettingsPrefix))
+                {
+                    RTC_LOG(LS_WARNING) << "Invalid Opus encoder settings: " << config_string;
+                    return false;
+                }
+                return encoder_->EnableAudioNetworkAdaptor(config_string, event_log);
+            }
+            AudioEncoderOpusConfig config = ApplyOpusEncoderSettings(settings.value(), config_);
+            if (!config.IsOk())
+            {
+                RTC_LOG(LS_WARNING) << "Opus encoder settings do not fit the codec: " << config_string;
+                return false;
+            }
+            maxBitrateBps_ = settings->maxBitrateBps;
+            Remake(config);
+            settingsApplied_ = true;
+            return true;
+        }
+
+        void DisableAudioNetworkAdaptor() override
+        {
+            if (!settingsApplied_)
+            {
+                encoder_->DisableAudioNetworkAdaptor();
+                return;
+            }
+            maxBitrateBps_ = absl::nullopt;
+            Remake(config_);
+            settingsApplied_ = false;
+        }
+
+        void OnReceivedUplinkPacketLossFraction(float uplink_packet_loss_fraction) override
+        {
+            encoder_->OnReceivedUplinkPacketLossFraction(uplink_packet_loss_fraction);
+        }
+        void OnReceivedTargetAudioBitrate(int target_bps) override
+        {
+            encoder_->OnReceivedTargetAudioBitrate(ClampBitrate(target_bps));
+        }
+        void OnReceivedUplinkBandwidth(int target_audio_bitrate_bps, absl::optional<int64_t> bwe_period_ms) override
+        {
+            encoder_->OnReceivedUplinkBandwidth(ClampBitrate(target_audio_bitrate_bps), bwe_period_ms);
+        }
+        void OnReceivedUplinkAllocation(BitrateAllocationUpdate update) override
+        {
+            if (maxBitrateBps_)
+                update.target_bitrate = std::min(update.target_bitrate, DataRate::BitsPerSec(maxBitrateBps_.value()));
+            encoder_->OnReceivedUplinkAllocation(update);
+        }
+        void OnReceivedRtt(int rtt_ms) override { encoder_->OnReceivedRtt(rtt_ms); }
+        void OnReceivedOverhead(size_t overhead_bytes_per_packet) override
+        {
+            overhead_ = overhead_bytes_per_packet;
+            encoder_->OnReceivedOverhead(overhead_bytes_per_packet);
+        }
+        void SetReceiverFrameLengthRange(int min_frame_length_ms, int max_frame_length_ms) override
+        {
+            frameLengthRange_ = std::make_pair(min_frame_length_ms, max_frame_length_ms);
+            encoder_->SetReceiverFrameLengthRange(min_frame_length_ms, max_frame_length_ms);
+        }
+
+    protected:
+        EncodedInfo EncodeImpl(uint32_t rtp_timestamp, rtc::ArrayView<const int16_t> audio, rtc::Buffer* encoded) override
+        {
+            return encoder_->Encode(rtp_timestamp, audio, encoded);
+        }
+
+    private:
+        int ClampBitrate(int bitrate) const
+        {
+            return maxBitrateBps_ ? std::min(bitrate, maxBitrateBps_.value()) : bitrate;
+        }
+
+        // The state the send stream passed to the previous encoder is passed
+        // to the new one.
+        void Remake(const AudioEncoderOpusConfig& config)
+        {
+            const int targetBitrate = encoder_->GetTargetBitrate();
+            encoder_ = AudioEncoderOpus::MakeAudioEncoder(config, payloadType_);
+            if (overhead_)
+                encoder_->OnReceivedOverhead(overhead_.value());
+            if (frameLengthRange_)
+                encoder_->SetReceiverFrameLengthRange(frameLengthRange_->first, frameLengthRange_->second);
+            encoder_->OnReceivedTargetAudioBitrate(ClampBitrate(targetBitrate));
+        }
+
+        // The configuration negotiated with the remote peer.
+        const AudioEncoderOpusConfig config_;
+        const int payloadType_;
+        std::unique_ptr<AudioEncoder> encoder_;
+        absl::optional<int> maxBitrateBps_;
+        absl::optional<size_t> overhead_;
+        absl::optional<std::pair<int, int>> frameLengthRange_;
+        bool settingsApplied_ = false;
+    };
 
     template<typename T>
     struct StereoSupportEncoder
@@ -51,10 +286,22 @@ namespace webrtc
         }
     };
 
+    // Makes encoders to which the settings of the sender can be applied.
+    struct ConfigurableOpusEncoder : public StereoSupportEncoder<AudioEncoderOpus>
+    {
+        static std::unique_ptr<AudioEncoder> MakeAudioEncoder(
+            const Config& config, int payload_type, absl::optional<AudioCodecPairId> codec_pair_id = absl::nullopt)
+        {
+            if (!config.IsOk())
+                return nullptr;
+            return std::make_unique<OpusEncoderWithSettings>(config, payload_type);
+        }
+    };
+
     rtc::scoped_refptr<AudioEncoderFactory> CreateAudioEncoderFactory()
     {
         return ::webrtc::CreateAudioEncoderFactory<
-            StereoSupportEncoder<AudioEncoderOpus>,
+            ConfigurableOpusEncoder,
             AudioEncoderMultiChannelOpus,
             AudioEncoderIlbc,
             AudioEncoderG722,
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string>
+
+#include <absl/strings/string_view.h>
+#include <absl/types/optional.h>
 #include <api/audio_codecs/audio_encoder_factory.h>
 #include <api/scoped_refptr.h>
 
@@ -9,6 +13,29 @@ namespace webrtc
 {
     using namespace ::webrtc;
 
+    // Opus encoder settings of a sender which override the negotiated ones.
+    struct OpusEncoderSettings
+    {
+        // 0 to 10. Lower values reduce CPU usage at the cost of quality.
+        absl::optional<int> complexity;
+        // 10, 20, 40 or 60.
+        absl::optional<int> ptimeMs;
+        absl::optional<bool> dtx;
+        absl::optional<bool> fec;
+        absl::optional<int> maxBitrateBps;
+    };
+
+    // Returns false when a setting is out of the range listed above.
+    bool ValidateOpusEncoderSettings(const OpusEncoderSettings& settings);
+
+    // The settings reach the encoder of a sender through the audio options of
+    // the source of its track. libwebrtc passes the audio network adaptor
+    // configuration of the options to the encoder of the send stream, and the
+    // Opus encoder made by `CreateAudioEncoderFactory` recognizes the settings
+    // in it, so that neither session description is modified.
+    std::string SerializeOpusEncoderSettings(const OpusEncoderSettings& settings);
+    absl::optional<OpusEncoderSettings> ParseOpusEncoderSettings(absl::string_view str);
+
     rtc::scoped_refptr<AudioEncoderFactory> CreateAudioEncoderFactory();
 
 } // end namespace webrtc
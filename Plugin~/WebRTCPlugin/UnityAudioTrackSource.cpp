@@ -1,8 +1,8 @@
 #include "pch.h"
 
-#include <common_audio/include/audio_util.h>
 #include <rtc_base/ref_counted_object.h>
 
+#include "AudioSampleConverter.h"
 #include "UnityAudioTrackSource.h"
 
 namespace unity
@@ -23,6 +23,25 @@ namespace webrtc
         return source;
     }
 
+    const cricket::AudioOptions UnityAudioTrackSource::options() const
+    {
+        std::lock_guard<std::mutex> lock(_optionsMutex);
+        return _options;
+    }
+
+    void UnityAudioTrackSource::SetOpusEncoderSettings(const OpusEncoderSettings& settings)
+    {
+        std::lock_guard<std::mutex> lock(_optionsMutex);
+        if (!settings.complexity && !settings.ptimeMs && !settings.dtx && !settings.fec && !settings.maxBitrateBps)
+        {
+            _options.audio_network_adaptor = absl::nullopt;
+            _options.audio_network_adaptor_config = absl::nullopt;
+            return;
+        }
+        _options.audio_network_adaptor = true;
+        _options.audio_network_adaptor_config = SerializeOpusEncoderSettings(settings);
+    }
+
     void UnityAudioTrackSource::AddSink(AudioTrackSinkInterface* sink)
     {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -63,15 +82,27 @@ namespace webrtc
             _convertedAudioData.reserve(nNumSamplesFor10ms * 20);
         }
 
-        for (size_t i = 0; i < nNumFrames; i++)
-            _convertedAudioData.push_back(::webrtc::FloatToS16(pAudioData[i]));
+        size_t offset = _convertedAudioData.size();
+        _convertedAudioData.resize(offset + nNumFrames);
+        ConvertFloatToS16(pAudioData, nNumFrames, _convertedAudioData.data() + offset);
+        // `nNumFrames` is the count of samples of all channels.
+        _levelMeter.Process(_convertedAudioData.data() + offset, nNumFrames / nNumChannels, nNumChannels, nSampleRate);
 
-        while (_convertedAudioData.size() >= nNumSamplesFor10ms)
+        // Shift the remaining samples once after passing all 10 ms frames
+        // instead of erasing the head of the buffer for each frame.
+        size_t readOffset = 0;
+        while (_convertedAudioData.size() - readOffset >= nNumSamplesFor10ms)
         {
             for (auto sink : _arrSink)
-                sink->OnData(_convertedAudioData.data(), nBitPerSample, nSampleRate, nNumChannels, nNumFramesFor10ms);
-            _convertedAudioData.erase(_convertedAudioData.begin(), _convertedAudioData.begin() + nNumSamplesFor10ms);
+                sink->OnData(
+                    _convertedAudioData.data() + readOffset,
+                    nBitPerSample,
+                    nSampleRate,
+                    nNumChannels,
+                    nNumFramesFor10ms);
+            readOffset += nNumSamplesFor10ms;
         }
+        _convertedAudioData.erase(_convertedAudioData.begin(), _convertedAudioData.begin() + readOffset);
     }
 
     UnityAudioTrackSource::UnityAudioTrackSource() { }
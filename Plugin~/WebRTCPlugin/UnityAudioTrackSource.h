@@ -5,6 +5,9 @@
 #include <api/media_stream_interface.h>
 #include <pc/local_audio_source.h>
 
+#include "AudioLevelMeter.h"
+#include "UnityAudioEncoderFactory.h"
+
 namespace unity
 {
 namespace webrtc
@@ -17,11 +20,17 @@ namespace webrtc
         static rtc::scoped_refptr<UnityAudioTrackSource> Create();
         static rtc::scoped_refptr<UnityAudioTrackSource> Create(const cricket::AudioOptions& audio_options);
 
-        const cricket::AudioOptions options() const override { return _options; }
+        const cricket::AudioOptions options() const override;
         void AddSink(AudioTrackSinkInterface* sink) override;
         void RemoveSink(AudioTrackSinkInterface* sink) override;
 
         void PushAudioData(const float* pAudioData, int nSampleRate, size_t nNumChannels, size_t nNumFrames);
+        AudioLevelMeter* levelMeter() { return &_levelMeter; }
+
+        // The settings are passed to the encoders of the senders of the track
+        // through the options, which a sender reads when its send stream is
+        // configured. Empty settings restore the negotiated configuration.
+        void SetOpusEncoderSettings(const OpusEncoderSettings& settings);
 
     protected:
         UnityAudioTrackSource();
@@ -33,7 +42,9 @@ namespace webrtc
         std::vector<int16_t> _convertedAudioData;
         std::vector<AudioTrackSinkInterface*> _arrSink;
         std::mutex _mutex;
+        mutable std::mutex _optionsMutex;
         cricket::AudioOptions _options;
+        AudioLevelMeter _levelMeter;
         int _sampleRate = 0;
         size_t _numChannels = 0;
         size_t _numFrames = 0;
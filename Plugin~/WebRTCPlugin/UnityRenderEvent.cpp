@@ -25,6 +25,7 @@ namespace webrtc
     static IUnityInterfaces* s_UnityInterfaces = nullptr;
     static IUnityGraphics* s_Graphics = nullptr;
     static Context* s_context = nullptr;
+    static HandleTable::Handle s_contextHandle = HandleTable::kInvalidHandle;
     static std::unique_ptr<UnityProfiler> s_UnityProfiler = nullptr;
     static std::unique_ptr<ProfilerMarkerFactory> s_ProfilerMarkerFactory = nullptr;
     static std::map<const uint32_t, std::shared_ptr<UnityVideoRenderer>> s_mapVideoRenderer;
@@ -235,6 +236,30 @@ struct VideoStreamTrackData
     int width;
     int height;
     UnityRenderingExtTextureFormat format;
+    // Handle of the source returned by ContextGetRefPtrHandle.
+    HandleTable::Handle sourceHandle;
+};
+
+// Validates s_context for the duration of a render event. The context and the
+// ref pointers are not released until the event ends.
+class ScopedRenderEvent
+{
+public:
+    ~ScopedRenderEvent()
+    {
+        if (m_begun)
+            ContextManager::GetInstance()->EndRenderEvent();
+    }
+    bool Begin()
+    {
+        if (!s_context)
+            return false;
+        m_begun = ContextManager::GetInstance()->BeginRenderEvent(s_contextHandle, s_context);
+        return m_begun;
+    }
+
+private:
+    bool m_begun = false;
 };
 
 // Data format used by the managed code.
@@ -252,12 +277,8 @@ static void UNITY_INTERFACE_API OnBatchUpdateEvent(int eventID, void* data)
 {
     if (eventID != s_batchUpdateEventID)
         return;
-    if (!s_context)
-        return;
-    if (!ContextManager::GetInstance()->Exists(s_context))
-        return;
-    std::unique_lock<std::mutex> lock(s_context->mutex, std::try_to_lock);
-    if (!lock.owns_lock())
+    ScopedRenderEvent renderEvent;
+    if (!renderEvent.Begin())
         return;
 
     BatchData* batchData = static_cast<BatchData*>(data);
@@ -292,7 +313,7 @@ static void UNITY_INTERFACE_API OnBatchUpdateEvent(int eventID, void* data)
             RTC_DCHECK_GT(trackData->height, 0);
 
             UnityVideoTrackSource* source = static_cast<UnityVideoTrackSource*>(trackData->source);
-            if (!s_context->ExistsRefPtr(source))
+            if (!s_context->ExistsRefPtr(trackData->sourceHandle, source))
             {
                 trackData->source = nullptr;
                 continue;
@@ -336,19 +357,21 @@ extern "C" UnityRenderingEventAndData UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API
 GetBatchUpdateEventFunc(Context* context)
 {
     s_context = context;
+    s_contextHandle = context ? context->handle() : HandleTable::kInvalidHandle;
     return OnBatchUpdateEvent;
 }
 
 extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetBatchUpdateEventID() { return s_batchUpdateEventID; }
 
+extern "C" uint64_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ContextGetSkippedRenderEventCount(Context* context)
+{
+    return context->skippedRenderEventCount();
+}
+
 static void UNITY_INTERFACE_API TextureUpdateCallback(int eventID, void* data)
 {
-    if (!s_context)
-        return;
-    if (!ContextManager::GetInstance()->Exists(s_context))
-        return;
-    std::unique_lock<std::mutex> lock(s_context->mutex, std::try_to_lock);
-    if (!lock.owns_lock())
+    ScopedRenderEvent renderEvent;
+    if (!renderEvent.Begin())
         return;
 
     auto event = static_cast<UnityRenderingExtEventType>(eventID);
@@ -357,7 +380,12 @@ static void UNITY_INTERFACE_API TextureUpdateCallback(int eventID, void* data)
     {
         auto params = reinterpret_cast<UnityRenderingExtTextureUpdateParamsV2*>(data);
 
-        auto renderer = s_context->GetVideoRenderer(params->userData);
+        std::shared_ptr<UnityVideoRenderer> renderer;
+        if (!s_context->TryGetVideoRenderer(params->userData, &renderer))
+        {
+            s_context->OnRenderEventSkipped();
+            return;
+        }
         if (renderer == nullptr)
             return;
         s_mapVideoRenderer[params->userData] = renderer;
@@ -385,5 +413,6 @@ static void UNITY_INTERFACE_API TextureUpdateCallback(int eventID, void* data)
 extern "C" UnityRenderingEventAndData UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetUpdateTextureFunc(Context* context)
 {
     s_context = context;
+    s_contextHandle = context ? context->handle() : HandleTable::kInvalidHandle;
     return TextureUpdateCallback;
 }
@@ -85,13 +85,14 @@ namespace webrtc
             if (factory)
                 factories_.emplace(impl, factory);
         }
+        supportedFormats_ = GetSupportedFormatsInFactories(factories_);
     }
 
     UnityVideoDecoderFactory::~UnityVideoDecoderFactory() = default;
 
     std::vector<webrtc::SdpVideoFormat> UnityVideoDecoderFactory::GetSupportedFormats() const
     {
-        return GetSupportedFormatsInFactories(factories_);
+        return supportedFormats_;
     }
 
     std::unique_ptr<webrtc::VideoDecoder>
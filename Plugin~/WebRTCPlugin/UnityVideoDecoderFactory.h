@@ -23,6 +23,7 @@ namespace webrtc
     private:
         ProfilerMarkerFactory* profiler_;
         std::map<std::string, std::unique_ptr<VideoDecoderFactory>> factories_;
+        std::vector<SdpVideoFormat> supportedFormats_;
     };
 }
 }
@@ -117,13 +117,8 @@ namespace webrtc
             if (factory)
                 factories_.emplace(impl, factory);
         }
-    }
-
-    UnityVideoEncoderFactory::~UnityVideoEncoderFactory() = default;
 
-    std::vector<webrtc::SdpVideoFormat> UnityVideoEncoderFactory::GetSupportedFormats() const
-    {
-        std::vector<SdpVideoFormat> supported_codecs = GetSupportedFormatsInFactories(factories_);
+        supportedFormats_ = GetSupportedFormatsInFactories(factories_);
 
         // Set video codec order: default video codec is VP8
         auto findIndex = [&](webrtc::SdpVideoFormat& format) -> long {
@@ -134,10 +129,16 @@ namespace webrtc
             return static_cast<long>(std::distance(std::begin(sortOrder), it));
         };
         std::sort(
-            supported_codecs.begin(),
-            supported_codecs.end(),
+            supportedFormats_.begin(),
+            supportedFormats_.end(),
             [&](webrtc::SdpVideoFormat& x, webrtc::SdpVideoFormat& y) -> int { return (findIndex(x) < findIndex(y)); });
-        return supported_codecs;
+    }
+
+    UnityVideoEncoderFactory::~UnityVideoEncoderFactory() = default;
+
+    std::vector<webrtc::SdpVideoFormat> UnityVideoEncoderFactory::GetSupportedFormats() const
+    {
+        return supportedFormats_;
     }
 
     webrtc::VideoEncoderFactory::CodecSupport UnityVideoEncoderFactory::QueryCodecSupport(
@@ -31,6 +31,8 @@ namespace webrtc
     private:
         ProfilerMarkerFactory* profiler_;
         std::map<std::string, std::unique_ptr<VideoEncoderFactory>> factories_;
+        // Formats of the factories don't change, so they are sorted once.
+        std::vector<SdpVideoFormat> supportedFormats_;
     };
 }
 }
@@ -1,13 +1,16 @@
 #include "pch.h"
 
 #include "Context.h"
+#include "Codec/VideoCodecCapabilityCache.h"
 #include "CreateSessionDescriptionObserver.h"
 #include "EncodedStreamTransformer.h"
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "MediaStreamObserver.h"
 #include "PeerConnectionObject.h"
+#include "SdpFmtp.h"
 #include "SetLocalDescriptionObserver.h"
 #include "SetRemoteDescriptionObserver.h"
+#include "StatsSubscription.h"
 #include "UnityAudioTrackSource.h"
 #include "UnityLogStream.h"
 #include "WebRTCPlugin.h"
@@ -19,48 +22,12 @@ namespace webrtc
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wmissing-prototypes"
 
-    std::string ConvertSdp(const std::map<std::string, std::string>& map)
+    std::tuple<cricket::MediaType, std::string> ConvertMimeType(std::string_view mimeType)
     {
-        std::string str = "";
-        for (const auto& pair : map)
-        {
-            if (!str.empty())
-            {
-                str += ";";
-            }
-            str += pair.first + "=" + pair.second;
-        }
-        return str;
-    }
-
-    std::vector<std::string> Split(const std::string& str, const std::string& delimiter)
-    {
-        std::vector<std::string> dst;
-        std::string s = str;
-        size_t pos = 0;
-
-        if (str.empty())
-            return dst;
-
-        while (true)
-        {
-            pos = s.find(delimiter);
-            size_t length = pos;
-            if (pos == std::string::npos)
-                length = str.length();
-            dst.push_back(s.substr(0, length));
-            if (pos == std::string::npos)
-                break;
-            s.erase(0, pos + delimiter.length());
-        }
-        return dst;
-    }
-
-    std::tuple<cricket::MediaType, std::string> ConvertMimeType(const std::string& mimeType)
-    {
-        const std::vector<std::string> vec = Split(mimeType, "/");
-        const std::string kind = vec[0];
-        const std::string name = vec[1];
+        const size_t separator = mimeType.find('/');
+        const std::string_view kind = mimeType.substr(0, separator);
+        const std::string_view name =
+            separator == std::string_view::npos ? std::string_view() : mimeType.substr(separator + 1);
         cricket::MediaType mediaType;
         if (kind == "video")
         {
@@ -70,20 +37,15 @@ namespace webrtc
         {
             mediaType = cricket::MEDIA_TYPE_AUDIO;
         }
-        return std::make_tuple(mediaType, name);
+        return std::make_tuple(mediaType, std::string(name));
     }
 
-    std::map<std::string, std::string> ConvertSdp(const std::string& src)
+    // Writes the fmtp line directly to the buffer passed to the managed code.
+    char* ConvertSdp(const SdpFmtpParameters& parameters)
     {
-        std::map<std::string, std::string> map;
-        std::vector<std::string> vec = Split(src, ";");
-
-        for (const auto& str : vec)
-        {
-            std::vector<std::string> pair = Split(str, "=");
-            map.emplace(pair[0], pair[1]);
-        }
-        return map;
+        char* ret = static_cast<char*>(CoTaskMemAlloc(SdpFmtpLength(parameters) + sizeof(char)));
+        WriteSdpFmtp(parameters, ret);
+        return ret;
     }
 
     ///
@@ -136,10 +98,12 @@ namespace webrtc
         return static_cast<T*>(dst);
     }
 
+    // Same layout as MarshallingArray of the managed code, whose length is a
+    // 32-bit integer followed by padding on 64-bit platforms.
     template<typename T>
     struct MarshallArray
     {
-        size_t length;
+        int32_t length;
         T* values;
 
         T& operator[](size_t i) const { return values[i]; }
@@ -160,7 +124,7 @@ namespace webrtc
         template<typename U>
         MarshallArray& operator=(const rtc::ArrayView<U>& src)
         {
-            length = static_cast<uint32_t>(src.size());
+            length = static_cast<int32_t>(src.size());
             values = static_cast<T*>(CoTaskMemAlloc(sizeof(T) * src.size()));
 
             for (size_t i = 0; i < src.size(); i++)
@@ -242,6 +206,43 @@ namespace webrtc
         *values = ConvertArray(vv, length);
         return ConvertArray(vc, length);
     }
+
+    // Resets the arena of the context, which releases the values returned by
+    // the previous call at once. The managed code has copied them already.
+    MarshalArena& BeginMarshal(Context* context)
+    {
+        MarshalArena& arena = context->marshalArena();
+        arena.Reset();
+        return arena;
+    }
+
+    template<typename T>
+    const char** StatsMemberGetMapStringValue(
+        MarshalArena& arena, const std::map<std::string, T>& map, T** values, size_t* length)
+    {
+        *length = map.size();
+        const char** keys = arena.AllocateArray<const char*>(map.size());
+        *values = arena.AllocateArray<T>(map.size());
+
+        size_t i = 0;
+        for (auto const& pair : map)
+        {
+            keys[i] = arena.CopyString(pair.first);
+            (*values)[i] = pair.second;
+            i++;
+        }
+        return keys;
+    }
+
+    ContextDependencies CreateContextDependencies(const ContextThreadOptions* options)
+    {
+        ContextDependencies dependencies;
+        dependencies.device = Plugin::GraphicsDevice();
+        dependencies.profiler = Plugin::ProfilerMarkerFactory();
+        if (options)
+            dependencies.threads = *options;
+        return dependencies;
+    }
 } // end namespace webrtc
 } // end namespace unity
 
@@ -313,6 +314,11 @@ extern "C"
         context->RemoveRefPtr(ptr);
     }
 
+    UNITY_INTERFACE_EXPORT HandleTable::Handle ContextGetRefPtrHandle(Context* context, rtc::RefCountInterface* ptr)
+    {
+        return context->GetRefPtrHandle(ptr);
+    }
+
     UNITY_INTERFACE_EXPORT EncodedStreamTransformer*
     ContextCreateFrameTransformer(Context* context, DelegateTransformedFrame callback)
     {
@@ -400,6 +406,11 @@ extern "C"
         return ConvertString(track->id());
     }
 
+    UNITY_INTERFACE_EXPORT const char* ContextMediaStreamTrackGetID(Context* context, MediaStreamTrackInterface* track)
+    {
+        return BeginMarshal(context).CopyString(track->id());
+    }
+
     UNITY_INTERFACE_EXPORT bool MediaStreamTrackGetEnabled(MediaStreamTrackInterface* track)
     {
         return track->enabled();
@@ -447,7 +458,12 @@ extern "C"
         }
     }
 
-    UNITY_INTERFACE_EXPORT Context* ContextCreate(int uid)
+    UNITY_INTERFACE_EXPORT void SetCodecCapabilityCachePath(const char* path)
+    {
+        VideoCodecCapabilityCache::GetInstance().SetPersistentPath(path ? path : "");
+    }
+
+    UNITY_INTERFACE_EXPORT Context* ContextCreateWithThreadOptions(int uid, const ContextThreadOptions* options)
     {
         auto ctx = ContextManager::GetInstance()->GetContext(uid);
         if (ctx != nullptr)
@@ -455,37 +471,201 @@ extern "C"
             DebugLog("Already created context with ID %d", uid);
             return ctx;
         }
-        ContextDependencies dependencies;
-        dependencies.device = Plugin::GraphicsDevice();
-        dependencies.profiler = Plugin::ProfilerMarkerFactory();
+        ContextDependencies dependencies = CreateContextDependencies(options);
         ctx = ContextManager::GetInstance()->CreateContext(uid, dependencies);
         return ctx;
     }
 
+    UNITY_INTERFACE_EXPORT Context* ContextCreate(int uid) { return ContextCreateWithThreadOptions(uid, nullptr); }
+
     UNITY_INTERFACE_EXPORT void ContextDestroy(int uid) { ContextManager::GetInstance()->DestroyContext(uid); }
 
-    UNITY_INTERFACE_EXPORT PeerConnectionObject* ContextCreatePeerConnection(Context* context)
+    UNITY_INTERFACE_EXPORT ContextAsyncOperation*
+    ContextCreateAsync(int uid, const ContextThreadOptions* options, DelegateContextAsyncCompleted callback)
+    {
+        return ContextManager::GetInstance()
+            ->CreateContextAsync(uid, CreateContextDependencies(options), callback)
+            .release();
+    }
+
+    UNITY_INTERFACE_EXPORT ContextAsyncOperation* ContextDestroyAsync(int uid, DelegateContextAsyncCompleted callback)
+    {
+        return ContextManager::GetInstance()->DestroyContextAsync(uid, callback).release();
+    }
+
+    UNITY_INTERFACE_EXPORT ContextAsyncState
+    ContextAsyncOperationGetState(ContextAsyncOperation* operation, Context** context)
+    {
+        ContextAsyncState state = operation->state();
+        *context = operation->context();
+        return state;
+    }
+
+    UNITY_INTERFACE_EXPORT void ContextAsyncOperationRelease(ContextAsyncOperation* operation)
+    {
+        operation->Release();
+    }
+
+    // Data format used by the managed code.
+    struct RTCIceServer
+    {
+        const char* credential;
+        RTCIceCredentialType credentialType;
+        MarshallArray<const char*> urls;
+        const char* username;
+    };
+
+    // Data format used by the managed code. It replaces the JSON format, which
+    // is kept for compatibility, and values which are not set keep the ones of
+    // the configuration it is applied to.
+    struct RTCConfiguration
+    {
+        MarshallArray<RTCIceServer> iceServers;
+        Optional<int32_t> iceTransportPolicy;
+        Optional<int32_t> bundlePolicy;
+        Optional<int32_t> rtcpMuxPolicy;
+        Optional<int32_t> iceCandidatePoolSize;
+        Optional<int32_t> minPort;
+        Optional<int32_t> maxPort;
+        Optional<int32_t> candidateNetworkPolicy;
+        Optional<int32_t> tcpCandidatePolicy;
+        Optional<bool> disableLinkLocalNetworks;
+
+        bool ApplyTo(PeerConnectionInterface::RTCConfiguration& dst) const
+        {
+            const int32_t minPort_ = minPort.value_or(dst.port_allocator_config.min_port);
+            const int32_t maxPort_ = maxPort.value_or(dst.port_allocator_config.max_port);
+            if (minPort_ < 0 || maxPort_ > 65535 || (maxPort_ != 0 && minPort_ > maxPort_))
+                return false;
+
+            // The servers are rebuilt, so that none keeps the fields of a
+            // previous server such as the TLS settings.
+            dst.servers.clear();
+            dst.servers.reserve(iceServers.length);
+            for (int32_t i = 0; i < iceServers.length; i++)
+            {
+                const RTCIceServer& src = iceServers[i];
+                PeerConnectionInterface::IceServer& server = dst.servers.emplace_back();
+                for (int32_t j = 0; j < src.urls.length; j++)
+                {
+                    if (src.urls[j] != nullptr)
+                        server.urls.emplace_back(src.urls[j]);
+                }
+                server.username = src.username ? src.username : "";
+                server.password = src.credential ? src.credential : "";
+            }
+            if (iceTransportPolicy.hasValue)
+                dst.type = static_cast<PeerConnectionInterface::IceTransportsType>(iceTransportPolicy.value);
+            if (bundlePolicy.hasValue)
+                dst.bundle_policy = static_cast<PeerConnectionInterface::BundlePolicy>(bundlePolicy.value);
+            if (rtcpMuxPolicy.hasValue)
+                dst.rtcp_mux_policy = static_cast<PeerConnectionInterface::RtcpMuxPolicy>(rtcpMuxPolicy.value);
+            if (iceCandidatePoolSize.hasValue)
+                dst.ice_candidate_pool_size = iceCandidatePoolSize.value;
+            dst.port_allocator_config.min_port = minPort_;
+            dst.port_allocator_config.max_port = maxPort_;
+            if (candidateNetworkPolicy.hasValue)
+                dst.candidate_network_policy =
+                    static_cast<PeerConnectionInterface::CandidateNetworkPolicy>(candidateNetworkPolicy.value);
+            if (tcpCandidatePolicy.hasValue)
+                dst.tcp_candidate_policy =
+                    static_cast<PeerConnectionInterface::TcpCandidatePolicy>(tcpCandidatePolicy.value);
+            if (disableLinkLocalNetworks.hasValue)
+                dst.disable_link_local_networks = disableLinkLocalNetworks.value;
+            return true;
+        }
+
+        // The strings and arrays are allocated in the arena.
+        void CopyFrom(MarshalArena& arena, const PeerConnectionInterface::RTCConfiguration& src)
+        {
+            iceServers.length = static_cast<int32_t>(src.servers.size());
+            iceServers.values = arena.AllocateArray<RTCIceServer>(src.servers.size());
+            for (size_t i = 0; i < src.servers.size(); i++)
+            {
+                const PeerConnectionInterface::IceServer& server = src.servers[i];
+                RTCIceServer& dst = iceServers[i];
+                dst.credential = arena.CopyString(server.password);
+                dst.credentialType = RTCIceCredentialType::Password;
+                dst.urls.length = static_cast<int32_t>(server.urls.size());
+                dst.urls.values = arena.AllocateArray<const char*>(server.urls.size());
+                for (size_t j = 0; j < server.urls.size(); j++)
+                    dst.urls[j] = arena.CopyString(server.urls[j]);
+                dst.username = arena.CopyString(server.username);
+            }
+            iceTransportPolicy = absl::optional<int32_t>(src.type);
+            bundlePolicy = absl::optional<int32_t>(src.bundle_policy);
+            rtcpMuxPolicy = absl::optional<int32_t>(src.rtcp_mux_policy);
+            iceCandidatePoolSize = absl::optional<int32_t>(src.ice_candidate_pool_size);
+            // Zero means that the range is not limited.
+            minPort = src.port_allocator_config.min_port != 0
+                ? absl::optional<int32_t>(src.port_allocator_config.min_port)
+                : absl::nullopt;
+            maxPort = src.port_allocator_config.max_port != 0
+                ? absl::optional<int32_t>(src.port_allocator_config.max_port)
+                : absl::nullopt;
+            candidateNetworkPolicy = absl::optional<int32_t>(src.candidate_network_policy);
+            tcpCandidatePolicy = absl::optional<int32_t>(src.tcp_candidate_policy);
+            disableLinkLocalNetworks = absl::optional<bool>(src.disable_link_local_networks);
+        }
+    };
+
+    // The configuration which the values of the managed code are applied to.
+    static PeerConnectionInterface::RTCConfiguration DefaultRTCConfiguration()
     {
         PeerConnectionInterface::RTCConfiguration config;
         config.sdp_semantics = SdpSemantics::kUnifiedPlan;
         config.enable_implicit_rollback = true;
         config.set_suspend_below_min_bitrate(false);
-        return context->CreatePeerConnection(config);
+        return config;
+    }
+
+    UNITY_INTERFACE_EXPORT PeerConnectionObject* ContextCreatePeerConnection(Context* context)
+    {
+        return context->CreatePeerConnection(DefaultRTCConfiguration());
     }
 
     UNITY_INTERFACE_EXPORT PeerConnectionObject*
     ContextCreatePeerConnectionWithConfig(Context* context, const char* conf)
     {
-        PeerConnectionInterface::RTCConfiguration config;
+        PeerConnectionInterface::RTCConfiguration config = DefaultRTCConfiguration();
         if (!Convert(conf, config))
             return nullptr;
+        return context->CreatePeerConnection(config);
+    }
 
-        config.sdp_semantics = SdpSemantics::kUnifiedPlan;
-        config.enable_implicit_rollback = true;
-        config.set_suspend_below_min_bitrate(false);
+    UNITY_INTERFACE_EXPORT PeerConnectionObject*
+    ContextCreatePeerConnectionWithRTCConfiguration(Context* context, const RTCConfiguration* configuration)
+    {
+        PeerConnectionInterface::RTCConfiguration config = DefaultRTCConfiguration();
+        if (!configuration->ApplyTo(config))
+            return nullptr;
         return context->CreatePeerConnection(config);
     }
 
+    // The pooled connections are claimed by ContextCreatePeerConnectionWithRTCConfiguration
+    // with an equal configuration, so the defaults must match.
+    UNITY_INTERFACE_EXPORT bool
+    ContextSetPeerConnectionPool(Context* context, const RTCConfiguration* configuration, int32_t size)
+    {
+        if (size < 0)
+            return false;
+        PeerConnectionInterface::RTCConfiguration config = DefaultRTCConfiguration();
+        if (!configuration->ApplyTo(config))
+            return false;
+        context->SetPeerConnectionPool(config, static_cast<size_t>(size));
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT int32_t ContextGetPooledPeerConnectionCount(Context* context)
+    {
+        return static_cast<int32_t>(context->pooledPeerConnectionCount());
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t ContextGetPooledPeerConnectionClaimCount(Context* context)
+    {
+        return context->pooledPeerConnectionClaimCount();
+    }
+
     UNITY_INTERFACE_EXPORT void ContextDeletePeerConnection(Context* context, PeerConnectionObject* obj)
     {
         obj->Close();
@@ -620,6 +800,21 @@ extern "C"
         return obj->SetConfiguration(std::string(conf));
     }
 
+    UNITY_INTERFACE_EXPORT RTCErrorType
+    PeerConnectionSetRTCConfiguration(PeerConnectionObject* obj, const RTCConfiguration* configuration)
+    {
+        PeerConnectionInterface::RTCConfiguration config = obj->connection->GetConfiguration();
+        if (!configuration->ApplyTo(config))
+            return RTCErrorType::INVALID_PARAMETER;
+        return obj->SetConfiguration(config);
+    }
+
+    UNITY_INTERFACE_EXPORT void ContextPeerConnectionGetRTCConfiguration(
+        Context* context, PeerConnectionObject* obj, RTCConfiguration* configuration)
+    {
+        configuration->CopyFrom(BeginMarshal(context), obj->connection->GetConfiguration());
+    }
+
     UNITY_INTERFACE_EXPORT char* PeerConnectionGetConfiguration(PeerConnectionObject* obj)
     {
         const std::string str = obj->GetConfiguration();
@@ -658,11 +853,53 @@ extern "C"
         return context->GetStatsList(report, length, types);
     }
 
+    UNITY_INTERFACE_EXPORT const uint8_t*
+    ContextGetStatsSnapshot(Context* context, const RTCStatsReport* report, size_t* length)
+    {
+        return context->GetStatsSnapshot(report, length);
+    }
+
     UNITY_INTERFACE_EXPORT void ContextDeleteStatsReport(Context* context, const RTCStatsReport* report)
     {
         context->DeleteStatsReport(report);
     }
 
+    UNITY_INTERFACE_EXPORT void ContextSetStatsReportTimeToLive(Context* context, int64_t timeToLiveMs)
+    {
+        // Zero or less disables the release of reports.
+        context->SetStatsReportTimeToLive(
+            timeToLiveMs > 0 ? TimeDelta::Millis(timeToLiveMs) : TimeDelta::PlusInfinity());
+    }
+
+    UNITY_INTERFACE_EXPORT void ContextGetStatsReportUsage(Context* context, StatsReportUsage* usage)
+    {
+        *usage = context->GetStatsReportUsage();
+    }
+
+    UNITY_INTERFACE_EXPORT StatsSubscription* ContextCreateStatsSubscription(
+        Context* context, const uint32_t* types, int32 typeCount, const char** members, int32 memberCount)
+    {
+        std::vector<uint32_t> _types(types, types + typeCount);
+        std::vector<std::string> _members(members, members + memberCount);
+        rtc::scoped_refptr<StatsSubscription> subscription = StatsSubscription::Create(_types, _members);
+        context->AddRefPtr(subscription);
+        return subscription.get();
+    }
+
+    UNITY_INTERFACE_EXPORT void
+    PeerConnectionRequestStatsSubscription(PeerConnectionObject* obj, StatsSubscription* subscription)
+    {
+        obj->connection->GetStats(subscription);
+    }
+
+    UNITY_INTERFACE_EXPORT int32 StatsSubscriptionPoll(
+        StatsSubscription* subscription, const StatsDelta** deltas, const uint32_t** removedKeys, int32* removedCount)
+    {
+        int32 count = subscription->Poll(deltas);
+        *removedCount = subscription->RemovedKeys(removedKeys);
+        return count;
+    }
+
     UNITY_INTERFACE_EXPORT const char* StatsGetJson(const RTCStats* stats) { return ConvertString(stats->ToJson()); }
 
     UNITY_INTERFACE_EXPORT int64_t StatsGetTimestamp(const RTCStats* stats) { return stats->timestamp().us(); }
@@ -780,6 +1017,48 @@ extern "C"
         return member->type();
     }
 
+    UNITY_INTERFACE_EXPORT const char* ContextStatsGetId(Context* context, const RTCStats* stats)
+    {
+        return BeginMarshal(context).CopyString(stats->id());
+    }
+
+    UNITY_INTERFACE_EXPORT const char* ContextStatsMemberGetName(Context* context, const RTCStatsMemberInterface* member)
+    {
+        return BeginMarshal(context).CopyString(member->name());
+    }
+
+    UNITY_INTERFACE_EXPORT const char*
+    ContextStatsMemberGetString(Context* context, const RTCStatsMemberInterface* member)
+    {
+        return BeginMarshal(context).CopyString(member->ValueToString());
+    }
+
+    UNITY_INTERFACE_EXPORT const char**
+    ContextStatsMemberGetStringArray(Context* context, const RTCStatsMemberInterface* member, size_t* length)
+    {
+        MarshalArena& arena = BeginMarshal(context);
+        const std::vector<std::string>& vec = *member->cast_to<RTCStatsMember<std::vector<std::string>>>();
+        *length = vec.size();
+        const char** dst = arena.AllocateArray<const char*>(vec.size());
+        for (size_t i = 0; i < vec.size(); i++)
+            dst[i] = arena.CopyString(vec[i]);
+        return dst;
+    }
+
+    UNITY_INTERFACE_EXPORT const char** ContextStatsMemberGetMapStringUint64(
+        Context* context, const RTCStatsMemberInterface* member, uint64_t** values, size_t* length)
+    {
+        const auto& map = *member->cast_to<RTCStatsMember<std::map<std::string, uint64_t>>>();
+        return StatsMemberGetMapStringValue(BeginMarshal(context), map, values, length);
+    }
+
+    UNITY_INTERFACE_EXPORT const char** ContextStatsMemberGetMapStringDouble(
+        Context* context, const RTCStatsMemberInterface* member, double** values, size_t* length)
+    {
+        const auto& map = *member->cast_to<RTCStatsMember<std::map<std::string, double>>>();
+        return StatsMemberGetMapStringValue(BeginMarshal(context), map, values, length);
+    }
+
     UNITY_INTERFACE_EXPORT SetLocalDescriptionObserver* PeerConnectionSetLocalDescription(
         PeerConnectionObject* obj, const RTCSessionDescription* desc, RTCErrorType* errorType, char* error[])
     {
@@ -817,40 +1096,10 @@ extern "C"
         return result.has_value();
     }
 
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetLocalDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
-    {
-        return obj->GetSessionDescription(obj->connection->local_description(), *desc);
-    }
-
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetRemoteDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
-    {
-        return obj->GetSessionDescription(obj->connection->remote_description(), *desc);
-    }
-
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetPendingLocalDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
-    {
-        return obj->GetSessionDescription(obj->connection->pending_local_description(), *desc);
-    }
-
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetPendingRemoteDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
-    {
-        return obj->GetSessionDescription(obj->connection->pending_remote_description(), *desc);
-    }
-
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetCurrentLocalDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
+    UNITY_INTERFACE_EXPORT bool PeerConnectionGetSessionDescription(
+        PeerConnectionObject* obj, RTCSessionDescriptionSource source, uint64_t* handle, RTCSessionDescription* desc)
     {
-        return obj->GetSessionDescription(obj->connection->current_local_description(), *desc);
-    }
-
-    UNITY_INTERFACE_EXPORT bool
-    PeerConnectionGetCurrentRemoteDescription(PeerConnectionObject* obj, RTCSessionDescription* desc)
-    {
-        return obj->GetSessionDescription(obj->connection->current_remote_description(), *desc);
+        return obj->GetSessionDescription(source, handle, *desc);
     }
 
     UNITY_INTERFACE_EXPORT RtpReceiverInterface**
@@ -919,33 +1168,14 @@ extern "C"
         ctx->DeleteDataChannel(channel);
     }
 
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterIceConnectionChange(PeerConnectionObject* obj, DelegateOnIceConnectionChange callback)
+    UNITY_INTERFACE_EXPORT void ContextRegisterOnEventsPending(DelegateEventsPending callback)
     {
-        obj->RegisterIceConnectionChange(callback);
+        Context::RegisterOnEventsPending(callback);
     }
 
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterIceGatheringChange(PeerConnectionObject* obj, DelegateOnIceGatheringChange callback)
+    UNITY_INTERFACE_EXPORT int32_t ContextDrainEvents(Context* context, const EventRecord** records)
     {
-        obj->RegisterIceGatheringChange(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterConnectionStateChange(PeerConnectionObject* obj, DelegateOnConnectionStateChange callback)
-    {
-        obj->RegisterConnectionStateChange(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterOnIceCandidate(PeerConnectionObject* obj, DelegateIceCandidate callback)
-    {
-        obj->RegisterIceCandidate(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void StatsCollectorRegisterCallback(DelegateCollectStats callback)
-    {
-        PeerConnectionStatsCollectorCallback::RegisterOnGetStats(callback);
+        return context->DrainEvents(records);
     }
 
     UNITY_INTERFACE_EXPORT void CreateSessionDescriptionObserverRegisterCallback(DelegateCreateSessionDesc callback)
@@ -971,7 +1201,9 @@ extern "C"
     UNITY_INTERFACE_EXPORT bool
     PeerConnectionAddIceCandidate(PeerConnectionObject* obj, const IceCandidateInterface* candidate)
     {
-        return obj->connection->AddIceCandidate(candidate);
+        const bool result = obj->connection->AddIceCandidate(candidate);
+        obj->InvalidateSessionDescriptions();
+        return result;
     }
 
     struct RTCIceCandidateInit
@@ -1076,29 +1308,6 @@ extern "C"
         return obj->connection->ice_gathering_state();
     }
 
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterOnDataChannel(PeerConnectionObject* obj, DelegateOnDataChannel callback)
-    {
-        obj->RegisterOnDataChannel(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterOnRenegotiationNeeded(PeerConnectionObject* obj, DelegateOnRenegotiationNeeded callback)
-    {
-        obj->RegisterOnRenegotiationNeeded(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void PeerConnectionRegisterOnTrack(PeerConnectionObject* obj, DelegateOnTrack callback)
-    {
-        obj->RegisterOnTrack(callback);
-    }
-
-    UNITY_INTERFACE_EXPORT void
-    PeerConnectionRegisterOnRemoveTrack(PeerConnectionObject* obj, DelegateOnRemoveTrack callback)
-    {
-        obj->RegisterOnRemoveTrack(callback);
-    }
-
     UNITY_INTERFACE_EXPORT bool
     TransceiverGetCurrentDirection(RtpTransceiverInterface* transceiver, RtpTransceiverDirection* direction)
     {
@@ -1140,7 +1349,7 @@ extern "C"
             this->mimeType = ConvertString(obj.mime_type());
             this->clockRate = obj.clock_rate;
             this->channels = obj.num_channels;
-            this->sdpFmtpLine = ConvertString(ConvertSdp(obj.parameters));
+            this->sdpFmtpLine = ConvertSdp(obj.parameters);
             return *this;
         }
     };
@@ -1151,11 +1360,11 @@ extern "C"
         std::vector<RtpCodecCapability> _codecs(length);
         for (size_t i = 0; i < length; i++)
         {
-            std::string mimeType = ConvertString(codecs[i].mimeType);
-            std::tie(_codecs[i].kind, _codecs[i].name) = ConvertMimeType(mimeType);
+            std::tie(_codecs[i].kind, _codecs[i].name) = ConvertMimeType(codecs[i].mimeType);
             _codecs[i].clock_rate = ConvertOptional(codecs[i].clockRate);
             _codecs[i].num_channels = ConvertOptional(codecs[i].channels);
-            _codecs[i].parameters = ConvertSdp(codecs[i].sdpFmtpLine);
+            if (codecs[i].sdpFmtpLine)
+                ParseSdpFmtp(codecs[i].sdpFmtpLine, &_codecs[i].parameters);
         }
         auto error = transceiver->SetCodecPreferences(_codecs);
         if (error.type() != RTCErrorType::NONE)
@@ -1173,6 +1382,16 @@ extern "C"
         return ConvertString(mid.value());
     }
 
+    UNITY_INTERFACE_EXPORT const char* ContextTransceiverGetMid(Context* context, RtpTransceiverInterface* transceiver)
+    {
+        auto mid = transceiver->mid();
+        if (!mid.has_value())
+        {
+            return nullptr;
+        }
+        return BeginMarshal(context).CopyString(mid.value());
+    }
+
     UNITY_INTERFACE_EXPORT RtpReceiverInterface* TransceiverGetReceiver(RtpTransceiverInterface* transceiver)
     {
         return transceiver->receiver().get();
@@ -1197,7 +1416,7 @@ extern "C"
             mimeType = ConvertString(src.mime_type());
             clockRate = src.clock_rate;
             channels = src.num_channels;
-            sdpFmtpLine = ConvertString(ConvertSdp(src.parameters));
+            sdpFmtpLine = ConvertSdp(src.parameters);
             return *this;
         }
     };
@@ -1278,6 +1497,42 @@ extern "C"
         return error.type();
     }
 
+    struct RTCOpusEncoderSettings
+    {
+        Optional<int32_t> complexity;
+        Optional<int32_t> ptime;
+        Optional<bool> dtx;
+        Optional<bool> fec;
+        Optional<uint64_t> maxBitrate;
+
+        operator OpusEncoderSettings() const
+        {
+            OpusEncoderSettings dst;
+            dst.complexity = static_cast<absl::optional<int>>(ConvertOptional(complexity));
+            dst.ptimeMs = static_cast<absl::optional<int>>(ConvertOptional(ptime));
+            dst.dtx = ConvertOptional(dtx);
+            dst.fec = ConvertOptional(fec);
+            dst.maxBitrateBps = static_cast<absl::optional<int>>(ConvertOptional(maxBitrate));
+            return dst;
+        }
+    };
+
+    UNITY_INTERFACE_EXPORT RTCErrorType ContextRtpSenderSetOpusEncoderSettings(
+        Context* context,
+        PeerConnectionObject* obj,
+        RtpSenderInterface* sender,
+        UnityAudioTrackSource* source,
+        const RTCOpusEncoderSettings* settings)
+    {
+        if (settings->maxBitrate.hasValue &&
+            settings->maxBitrate.value > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            return RTCErrorType::INVALID_RANGE;
+        const OpusEncoderSettings dst = *settings;
+        if (!ValidateOpusEncoderSettings(dst))
+            return RTCErrorType::INVALID_RANGE;
+        return context->SetOpusEncoderSettings(obj, sender, source, dst);
+    }
+
     UNITY_INTERFACE_EXPORT bool VideoSourceGetSyncApplicationFramerate(UnityVideoTrackSource* source)
     {
         return source->syncApplicationFramerate();
@@ -1439,7 +1694,8 @@ extern "C"
 
     UNITY_INTERFACE_EXPORT void DataChannelSend(DataChannelInterface* channel, const char* data)
     {
-        channel->Send(webrtc::DataBuffer(std::string(data)));
+        rtc::CopyOnWriteBuffer buf(data, std::strlen(data));
+        channel->Send(webrtc::DataBuffer(buf, false));
     }
 
     UNITY_INTERFACE_EXPORT void DataChannelSendBinary(DataChannelInterface* channel, const byte* data, int length)
@@ -1450,28 +1706,103 @@ extern "C"
 
     UNITY_INTERFACE_EXPORT void DataChannelClose(DataChannelInterface* channel) { channel->Close(); }
 
+    UNITY_INTERFACE_EXPORT bool DataChannelSendWithFlowControl(
+        Context* context, DataChannelInterface* channel, const byte* data, int32 length, bool binary)
+    {
+        rtc::CopyOnWriteBuffer buf(data, static_cast<size_t>(length));
+        return context->GetDataChannelObject(channel)->Send(webrtc::DataBuffer(buf, binary));
+    }
+
     UNITY_INTERFACE_EXPORT void
-    DataChannelRegisterOnMessage(Context* context, DataChannelInterface* channel, DelegateOnMessage callback)
+    DataChannelSetBufferedAmountLowThreshold(Context* context, DataChannelInterface* channel, uint64_t threshold)
     {
-        context->GetDataChannelObject(channel)->RegisterOnMessage(callback);
+        context->GetDataChannelObject(channel)->flowControl().SetBufferedAmountLowThreshold(threshold);
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t
+    DataChannelGetBufferedAmountLowThreshold(Context* context, DataChannelInterface* channel)
+    {
+        return context->GetDataChannelObject(channel)->flowControl().bufferedAmountLowThreshold();
     }
 
     UNITY_INTERFACE_EXPORT void
-    DataChannelRegisterOnOpen(Context* context, DataChannelInterface* channel, DelegateOnOpen callback)
+    DataChannelSetSendQueueLimit(Context* context, DataChannelInterface* channel, uint64_t limit)
+    {
+        context->GetDataChannelObject(channel)->flowControl().SetSendQueueLimit(limit);
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t DataChannelGetQueuedAmount(Context* context, DataChannelInterface* channel)
     {
-        context->GetDataChannelObject(channel)->RegisterOnOpen(callback);
+        return context->GetDataChannelObject(channel)->flowControl().queuedAmount();
+    }
+
+    UNITY_INTERFACE_EXPORT int32 DataChannelSendBatch(
+        Context* context,
+        DataChannelInterface* channel,
+        const byte* data,
+        const DataChannelMessageIndex* index,
+        int32 count)
+    {
+        // Goes through the chunker and the flow control like the other sends.
+        DataChannelObject* obj = context->GetDataChannelObject(channel);
+        for (int32 i = 0; i < count; i++)
+        {
+            rtc::CopyOnWriteBuffer buf(data + index[i].offset, static_cast<size_t>(index[i].length));
+            if (!obj->Send(webrtc::DataBuffer(buf, index[i].binary != 0)))
+                return i;
+        }
+        return count;
+    }
+
+    UNITY_INTERFACE_EXPORT void
+    DataChannelSetChunking(Context* context, DataChannelInterface* channel, bool enabled, int32 chunkSize)
+    {
+        context->GetDataChannelObject(channel)->SetChunking(enabled, static_cast<size_t>(std::max(chunkSize, 1)));
     }
 
     UNITY_INTERFACE_EXPORT void
-    DataChannelRegisterOnClose(Context* context, DataChannelInterface* channel, DelegateOnClose callback)
+    DataChannelSetBatchedReceive(Context* context, DataChannelInterface* channel, bool enabled)
+    {
+        context->GetDataChannelObject(channel)->SetBatchedReceive(enabled);
+    }
+
+    UNITY_INTERFACE_EXPORT int32 DataChannelReceiveBatch(
+        Context* context,
+        DataChannelInterface* channel,
+        const uint8_t** data,
+        const DataChannelMessageIndex** index)
+    {
+        return context->GetDataChannelObject(channel)->ReceiveBatch(data, index);
+    }
+
+    UNITY_INTERFACE_EXPORT void
+    DataChannelSetReceiveQueueCapacity(Context* context, DataChannelInterface* channel, uint64_t capacity)
+    {
+        context->GetDataChannelObject(channel)->receiveQueue().SetCapacity(static_cast<size_t>(capacity));
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t
+    DataChannelGetReceiveQueueDroppedCount(Context* context, DataChannelInterface* channel)
+    {
+        return context->GetDataChannelObject(channel)->receiveQueue().droppedCount();
+    }
+
+    UNITY_INTERFACE_EXPORT uint8_t* DataChannelLeaseSendBuffer(
+        Context* context, DataChannelInterface* channel, int32 capacity, rtc::CopyOnWriteBuffer** lease)
     {
-        context->GetDataChannelObject(channel)->RegisterOnClose(callback);
+        return context->GetDataChannelObject(channel)->LeaseSendBuffer(static_cast<size_t>(capacity), lease);
+    }
+
+    UNITY_INTERFACE_EXPORT bool DataChannelCommitSendBuffer(
+        Context* context, DataChannelInterface* channel, rtc::CopyOnWriteBuffer* lease, int32 length)
+    {
+        return context->GetDataChannelObject(channel)->CommitSendBuffer(lease, static_cast<size_t>(length));
     }
 
     UNITY_INTERFACE_EXPORT void
-    DataChannelRegisterOnError(Context* context, DataChannelInterface* channel, DelegateOnError callback)
+    DataChannelCancelSendBuffer(Context* context, DataChannelInterface* channel, rtc::CopyOnWriteBuffer* lease)
     {
-        context->GetDataChannelObject(channel)->RegisterOnError(callback);
+        context->GetDataChannelObject(channel)->CancelSendBuffer(lease);
     }
 
     UNITY_INTERFACE_EXPORT void SetCurrentContext(Context* context)
@@ -1501,6 +1832,12 @@ extern "C"
         return context->CreateAudioTrackSinkAdapter();
     }
 
+    UNITY_INTERFACE_EXPORT AudioTrackSinkAdapter*
+    ContextCreateAudioTrackSinkWithOptions(Context* context, const AudioTrackSinkOptions* options)
+    {
+        return context->CreateAudioTrackSinkAdapter(*options);
+    }
+
     UNITY_INTERFACE_EXPORT void ContextDeleteAudioTrackSink(Context* context, AudioTrackSinkAdapter* sink)
     {
         return context->DeleteAudioTrackSinkAdapter(sink);
@@ -1511,9 +1848,10 @@ extern "C"
         track->AddSink(sink);
     }
 
-    UNITY_INTERFACE_EXPORT void AudioTrackRemoveSink(AudioTrackInterface* track, AudioTrackSinkInterface* sink)
+    UNITY_INTERFACE_EXPORT void AudioTrackRemoveSink(AudioTrackInterface* track, AudioTrackSinkAdapter* sink)
     {
         track->RemoveSink(sink);
+        sink->Flush();
     }
 
     UNITY_INTERFACE_EXPORT void
@@ -1522,6 +1860,47 @@ extern "C"
         sink->ProcessAudio(data, length, static_cast<size_t>(channels), sampleRate);
     }
 
+    UNITY_INTERFACE_EXPORT void
+    AudioTrackSinkGetResampleStats(AudioTrackSinkAdapter* sink, uint64_t* bypassedSamples, uint64_t* resampledSamples)
+    {
+        *bypassedSamples = sink->bypassedSamples();
+        *resampledSamples = sink->resampledSamples();
+    }
+
+    UNITY_INTERFACE_EXPORT void
+    AudioTrackSinkGetDebugCounters(AudioTrackSinkAdapter* sink, AudioTrackSinkCounters* counters)
+    {
+        *counters = sink->GetCounters();
+    }
+
+    UNITY_INTERFACE_EXPORT AudioLevelMeter* AudioTrackSinkGetLevelMeter(AudioTrackSinkAdapter* sink)
+    {
+        return sink->levelMeter();
+    }
+
+    UNITY_INTERFACE_EXPORT AudioLevelMeter* AudioSourceGetLevelMeter(UnityAudioTrackSource* source)
+    {
+        return source->levelMeter();
+    }
+
+    UNITY_INTERFACE_EXPORT void AudioLevelMeterGetLevels(AudioLevelMeter** meters, int32 length, AudioLevel* levels)
+    {
+        for (int32 i = 0; i < length; i++)
+        {
+            if (meters[i] == nullptr)
+            {
+                levels[i] = { AudioLevelMeter::kMinLevelDbfs, AudioLevelMeter::kMinLevelDbfs, false };
+                continue;
+            }
+            levels[i] = meters[i]->GetLevel();
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT void ContextSetAudioPlayoutFormat(Context* context, int32 sampleRate, int32 channels)
+    {
+        context->SetAudioPlayoutFormat(sampleRate, static_cast<size_t>(channels));
+    }
+
     UNITY_INTERFACE_EXPORT uint32_t FrameGetTimestamp(TransformableFrameInterface* frame)
     {
         return frame->GetTimestamp();
@@ -122,22 +122,6 @@ namespace webrtc
         char* sdp;
     };
 
-    struct RTCIceServer
-    {
-        char* credential;
-        char* credentialType;
-        char** urls;
-        int urlsLength;
-        char* username;
-    };
-
-    struct RTCConfiguration
-    {
-        RTCIceServer* iceServers;
-        int iceServersLength;
-        char* iceServerPolicy;
-    };
-
     struct RTCIceCandidate
     {
         char* candidate;
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "AudioSampleConverter.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // 10 ms of 48 kHz stereo audio, the size of one frame pushed to and pulled
+    // from the plugin.
+    constexpr size_t kSamples = 960;
+
+    static void BM_ConvertFloatToS16(benchmark::State& state)
+    {
+        const auto kernel = static_cast<AudioSampleConverterKernel>(state.range(0));
+        if (!IsAudioSampleConverterKernelSupported(kernel))
+        {
+            state.SkipWithError("The kernel is not supported on this CPU.");
+            return;
+        }
+        std::vector<float> src(kSamples);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = static_cast<float>(i % 200) / 100.f - 1.f;
+        std::vector<int16_t> dst(kSamples);
+
+        for (auto _ : state)
+        {
+            ConvertFloatToS16(kernel, src.data(), src.size(), dst.data());
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+    }
+
+    static void BM_ConvertS16ToFloat(benchmark::State& state)
+    {
+        const auto kernel = static_cast<AudioSampleConverterKernel>(state.range(0));
+        if (!IsAudioSampleConverterKernelSupported(kernel))
+        {
+            state.SkipWithError("The kernel is not supported on this CPU.");
+            return;
+        }
+        std::vector<int16_t> src(kSamples);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = static_cast<int16_t>(i * 67);
+        std::vector<float> dst(kSamples);
+
+        for (auto _ : state)
+        {
+            ConvertS16ToFloat(kernel, src.data(), src.size(), dst.data());
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSamples));
+    }
+
+    static void KernelArguments(benchmark::internal::Benchmark* b)
+    {
+        b->ArgName("kernel");
+        for (auto kernel : { AudioSampleConverterKernel::Scalar,
+                             AudioSampleConverterKernel::SSE2,
+                             AudioSampleConverterKernel::AVX2,
+                             AudioSampleConverterKernel::NEON })
+            b->Arg(static_cast<int64_t>(kernel));
+    }
+
+    BENCHMARK(BM_ConvertFloatToS16)->Apply(KernelArguments);
+    BENCHMARK(BM_ConvertS16ToFloat)->Apply(KernelArguments);
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,116 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include "Context.h"
+#include "PeerConnectionTestUtil.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Renegotiates a pair with many transceivers, and reads the descriptions
+    // after each step as the managed code does. A read only receives a copy
+    // when the description has changed since the previous read.
+    static void BM_Renegotiation(benchmark::State& state)
+    {
+        const int transceivers = static_cast<int>(state.range(0));
+        constexpr int kReads = 10;
+
+        SignalingCallbacks::Register();
+
+        ContextDependencies dependencies;
+        auto context = std::make_unique<Context>(dependencies);
+        const PeerConnectionInterface::RTCConfiguration config;
+        const auto offerer = context->CreatePeerConnection(config);
+        const auto answerer = context->CreatePeerConnection(config);
+        for (int i = 0; i < transceivers; i++)
+            offerer->connection->AddTransceiver(cricket::MEDIA_TYPE_VIDEO);
+
+        uint64_t handle = SessionDescriptionCache::kInvalidHandle;
+        int64_t copies = 0;
+        for (auto _ : state)
+        {
+            if (!Negotiate(offerer, answerer))
+            {
+                state.SkipWithError("Negotiation failed.");
+                break;
+            }
+            for (int j = 0; j < kReads; j++)
+            {
+                RTCSessionDescription desc = {};
+                offerer->GetSessionDescription(RTCSessionDescriptionSource::Local, &handle, desc);
+                if (desc.sdp == nullptr)
+                    continue;
+                copies++;
+                CoTaskMemFree(desc.sdp);
+            }
+        }
+        state.counters["copies"] = benchmark::Counter(static_cast<double>(copies), benchmark::Counter::kAvgIterations);
+
+        context->DeletePeerConnection(offerer);
+        context->DeletePeerConnection(answerer);
+        context = nullptr;
+        SignalingCallbacks::Unregister();
+    }
+
+    BENCHMARK(BM_Renegotiation)->ArgName("transceivers")->Arg(1)->Arg(50)->Unit(benchmark::kMillisecond);
+
+    // Measures the time from creating a loopback pair to both connections being
+    // connected, with the connections created on demand or taken from the pool.
+    // The pool is refilled outside of the measured time.
+    static void BM_TimeToConnected(benchmark::State& state)
+    {
+        const bool pooled = state.range(0) != 0;
+        constexpr size_t kPoolSize = 2;
+
+        SignalingCallbacks::Register();
+        ContextDependencies dependencies;
+        auto context = std::make_unique<Context>(dependencies);
+        PeerConnectionInterface::RTCConfiguration config;
+        config.ice_candidate_pool_size = 1;
+        if (pooled)
+            context->SetPeerConnectionPool(config, kPoolSize);
+
+        uint64_t claimed = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (int i = 0; pooled && i < 10000 && context->pooledPeerConnectionCount() < kPoolSize; i++)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            const uint64_t claimCount = context->pooledPeerConnectionClaimCount();
+            state.ResumeTiming();
+
+            const auto offerer = context->CreatePeerConnection(config);
+            const auto answerer = context->CreatePeerConnection(config);
+            DataChannelInit init;
+            const auto channel = context->CreateDataChannel(offerer, "test", init);
+            const bool connected = Negotiate(offerer, answerer) && WaitForConnected(context.get(), offerer, answerer);
+
+            state.PauseTiming();
+            claimed += context->pooledPeerConnectionClaimCount() - claimCount;
+            context->DeleteDataChannel(channel);
+            offerer->Close();
+            answerer->Close();
+            context->DeletePeerConnection(offerer);
+            context->DeletePeerConnection(answerer);
+            state.ResumeTiming();
+            if (!connected)
+            {
+                state.SkipWithError("Connection failed.");
+                break;
+            }
+        }
+        // Tells whether the measured connections were actually pooled.
+        state.counters["claimed"] = benchmark::Counter(static_cast<double>(claimed), benchmark::Counter::kAvgIterations);
+
+        if (pooled)
+            context->SetPeerConnectionPool(config, 0);
+        context = nullptr;
+        SignalingCallbacks::Unregister();
+    }
+
+    BENCHMARK(BM_TimeToConnected)->ArgName("pooled")->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // end namespace webrtc
+} // end namespace unity
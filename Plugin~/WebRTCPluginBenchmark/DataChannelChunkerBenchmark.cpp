@@ -0,0 +1,129 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include "Context.h"
+#include "DataChannelChunker.h"
+#include "DataChannelObject.h"
+#include "PeerConnectionTestUtil.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Sends a message through the framing layer and reassembles it, which is
+    // the work added to a loopback pair of data channels without the network.
+    static void BM_ChunkAndReassemble(benchmark::State& state)
+    {
+        const size_t size = static_cast<size_t>(state.range(0));
+        DataChannelChunker chunker;
+        DataChannelReassembler reassembler;
+        const DataBuffer sent(rtc::CopyOnWriteBuffer(size), true);
+        DataBuffer chunk(rtc::CopyOnWriteBuffer(), true);
+        DataBuffer received(rtc::CopyOnWriteBuffer(), true);
+
+        for (auto _ : state)
+        {
+            chunker.Enqueue(sent);
+            while (chunker.Next(&chunk))
+                reassembler.Push(chunk, &received);
+            benchmark::DoNotOptimize(received.data.cdata());
+            // Release the message so that the buffer is reused as the managed
+            // code does after the message delegate returns.
+            received = DataBuffer(rtc::CopyOnWriteBuffer(), true);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    }
+
+    BENCHMARK(BM_ChunkAndReassemble)->ArgName("size")->RangeMultiplier(8)->Range(1 << 10, 64 << 20);
+
+    // Sends a message over a connected loopback pair of chunked data channels
+    // and waits until the remote peer has reassembled it, so that the SCTP
+    // transport and the flow control are measured along with the framing.
+    static void BM_LoopbackThroughput(benchmark::State& state)
+    {
+        const size_t size = static_cast<size_t>(state.range(0));
+
+        SignalingCallbacks::Register();
+        ContextDependencies dependencies;
+        auto context = std::make_unique<Context>(dependencies);
+        const PeerConnectionInterface::RTCConfiguration config;
+        const auto offerer = context->CreatePeerConnection(config);
+        const auto answerer = context->CreatePeerConnection(config);
+
+        DataChannelInit init;
+        init.negotiated = true;
+        init.id = 1;
+        const auto sender = context->CreateDataChannel(offerer, "throughput", init);
+        const auto receiver = context->CreateDataChannel(answerer, "throughput", init);
+        DataChannelObject* senderObject = context->GetDataChannelObject(sender);
+        DataChannelObject* receiverObject = context->GetDataChannelObject(receiver);
+        senderObject->SetChunking(true, DataChannelChunker::kDefaultChunkSize);
+        receiverObject->SetChunking(true, DataChannelChunker::kDefaultChunkSize);
+        // Messages are drained here instead of through the event queue, and the
+        // largest message is over the default capacity of the receive queue.
+        receiverObject->SetBatchedReceive(true);
+        receiverObject->receiveQueue().SetCapacity(0);
+
+        bool open = Negotiate(offerer, answerer) && WaitForConnected(context.get(), offerer, answerer);
+        for (int i = 0; open && i < 10000 &&
+             (sender->state() != DataChannelInterface::kOpen || receiver->state() != DataChannelInterface::kOpen);
+             i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        open = open && sender->state() == DataChannelInterface::kOpen &&
+            receiver->state() == DataChannelInterface::kOpen;
+        if (!open)
+            state.SkipWithError("Connection failed.");
+
+        const DataBuffer message(rtc::CopyOnWriteBuffer(size), true);
+        const auto timeout = std::chrono::seconds(30);
+        for (auto _ : state)
+        {
+            if (!open)
+                break;
+            if (!senderObject->Send(message))
+            {
+                state.SkipWithError("Send failed.");
+                break;
+            }
+
+            bool received = false;
+            const auto start = std::chrono::steady_clock::now();
+            while (!received && std::chrono::steady_clock::now() - start < timeout)
+            {
+                const uint8_t* data = nullptr;
+                const DataChannelMessageIndex* index = nullptr;
+                received = receiverObject->ReceiveBatch(&data, &index) > 0;
+                // Keep the events of the channels from piling up.
+                const EventRecord* records = nullptr;
+                context->DrainEvents(&records);
+                if (!received)
+                    std::this_thread::yield();
+            }
+            if (!received)
+            {
+                state.SkipWithError("The message was not received.");
+                break;
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+
+        context->DeleteDataChannel(sender);
+        context->DeleteDataChannel(receiver);
+        offerer->Close();
+        answerer->Close();
+        context->DeletePeerConnection(offerer);
+        context->DeletePeerConnection(answerer);
+        context = nullptr;
+        SignalingCallbacks::Unregister();
+    }
+
+    BENCHMARK(BM_LoopbackThroughput)
+        ->ArgName("size")
+        ->RangeMultiplier(8)
+        ->Range(1 << 10, 64 << 20)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "SdpFmtp.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // fmtp lines of a capability list with the given number of codecs, which
+    // resemble the H264 and RTX entries of the video capabilities.
+    static std::vector<std::string> CreateCapabilityLines(size_t count)
+    {
+        std::vector<std::string> lines;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (i % 2)
+                lines.push_back("apt=" + std::to_string(96 + i));
+            else
+                lines.push_back(
+                    "level-asymmetry-allowed=1;packetization-mode=" + std::to_string(i % 3) +
+                    ";profile-level-id=42e01f;sps-pps-idr-in-keyframe=1");
+        }
+        return lines;
+    }
+
+    static void BM_ParseSdpFmtp(benchmark::State& state)
+    {
+        const std::vector<std::string> lines = CreateCapabilityLines(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            for (const auto& line : lines)
+            {
+                SdpFmtpParameters parameters;
+                ParseSdpFmtp(line, &parameters);
+                benchmark::DoNotOptimize(parameters);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lines.size()));
+    }
+
+    static void BM_SerializeSdpFmtp(benchmark::State& state)
+    {
+        std::vector<SdpFmtpParameters> capabilities;
+        for (const auto& line : CreateCapabilityLines(static_cast<size_t>(state.range(0))))
+        {
+            SdpFmtpParameters parameters;
+            ParseSdpFmtp(line, &parameters);
+            capabilities.push_back(std::move(parameters));
+        }
+
+        std::vector<char> buffer;
+        for (auto _ : state)
+        {
+            for (const auto& parameters : capabilities)
+            {
+                // The exports write to a buffer of the exact size in the same way.
+                buffer.resize(SdpFmtpLength(parameters) + 1);
+                WriteSdpFmtp(parameters, buffer.data());
+                benchmark::DoNotOptimize(buffer.data());
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * capabilities.size()));
+    }
+
+    BENCHMARK(BM_ParseSdpFmtp)->ArgName("codecs")->RangeMultiplier(4)->Range(8, 512);
+    BENCHMARK(BM_SerializeSdpFmtp)->ArgName("codecs")->RangeMultiplier(4)->Range(8, 512);
+
+} // end namespace webrtc
+} // end namespace unity
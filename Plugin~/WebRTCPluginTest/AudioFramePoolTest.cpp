@@ -0,0 +1,40 @@
+#include "pch.h"
+
+#include "AudioFramePool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(AudioFramePoolTest, ReuseReleasedFrame)
+    {
+        AudioFramePool pool(2);
+        EXPECT_EQ(2u, pool.size());
+        EXPECT_EQ(2u, pool.availableCount());
+
+        AudioFrame* frame = pool.Acquire();
+        EXPECT_NE(nullptr, frame);
+        EXPECT_EQ(1u, pool.availableCount());
+        pool.Release(frame);
+
+        EXPECT_EQ(frame, pool.Acquire());
+        pool.Release(frame);
+        EXPECT_EQ(0u, pool.allocationCount());
+    }
+
+    TEST(AudioFramePoolTest, GrowWhenExhausted)
+    {
+        AudioFramePool pool(1);
+        AudioFrame* frame1 = pool.Acquire();
+        AudioFrame* frame2 = pool.Acquire();
+        EXPECT_NE(frame1, frame2);
+        EXPECT_EQ(2u, pool.size());
+        EXPECT_EQ(1u, pool.allocationCount());
+
+        pool.Release(frame1);
+        pool.Release(frame2);
+        EXPECT_EQ(2u, pool.availableCount());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,74 @@
+#include "pch.h"
+
+#include <cmath>
+
+#include "AudioLevelMeter.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    constexpr int kSampleRate = 48000;
+    constexpr size_t kChannels = 2;
+    constexpr size_t kFramesFor10ms = kSampleRate / 100;
+
+    TEST(AudioLevelMeterTest, InitialLevelIsSilent)
+    {
+        AudioLevelMeter meter;
+        AudioLevel level = meter.GetLevel();
+        EXPECT_EQ(AudioLevelMeter::kMinLevelDbfs, level.rmsDbfs);
+        EXPECT_EQ(AudioLevelMeter::kMinLevelDbfs, level.peakDbfs);
+        EXPECT_FALSE(level.voiceActive);
+    }
+
+    TEST(AudioLevelMeterTest, Silence)
+    {
+        AudioLevelMeter meter;
+        std::vector<int16_t> audio(kFramesFor10ms * kChannels, 0);
+        meter.Process(audio.data(), kFramesFor10ms, kChannels, kSampleRate);
+
+        AudioLevel level = meter.GetLevel();
+        EXPECT_EQ(AudioLevelMeter::kMinLevelDbfs, level.rmsDbfs);
+        EXPECT_EQ(AudioLevelMeter::kMinLevelDbfs, level.peakDbfs);
+        EXPECT_FALSE(level.voiceActive);
+    }
+
+    TEST(AudioLevelMeterTest, SineWave)
+    {
+        // A 1 kHz sine wave at half of the full scale.
+        AudioLevelMeter meter;
+        std::vector<int16_t> audio(kFramesFor10ms * kChannels);
+        for (size_t i = 0; i < kFramesFor10ms; i++)
+        {
+            const double value = 16384.0 * std::sin(2.0 * M_PI * 1000.0 * i / kSampleRate);
+            audio[i * kChannels] = audio[i * kChannels + 1] = static_cast<int16_t>(std::lround(value));
+        }
+        meter.Process(audio.data(), kFramesFor10ms, kChannels, kSampleRate);
+
+        AudioLevel level = meter.GetLevel();
+        EXPECT_NEAR(-9.03f, level.rmsDbfs, 0.01f);
+        EXPECT_NEAR(-6.02f, level.peakDbfs, 0.01f);
+        EXPECT_TRUE(level.voiceActive);
+    }
+
+    TEST(AudioLevelMeterTest, VoiceActivityHangover)
+    {
+        AudioLevelMeter meter;
+        std::vector<int16_t> voice(kFramesFor10ms * kChannels, 8192);
+        std::vector<int16_t> silence(kFramesFor10ms * kChannels, 0);
+
+        meter.Process(voice.data(), kFramesFor10ms, kChannels, kSampleRate);
+        EXPECT_TRUE(meter.GetLevel().voiceActive);
+
+        const int hangoverFrames = AudioLevelMeter::kVoiceHangoverMs / 10;
+        for (int i = 0; i < hangoverFrames - 1; i++)
+        {
+            meter.Process(silence.data(), kFramesFor10ms, kChannels, kSampleRate);
+            EXPECT_TRUE(meter.GetLevel().voiceActive);
+        }
+        meter.Process(silence.data(), kFramesFor10ms, kChannels, kSampleRate);
+        EXPECT_FALSE(meter.GetLevel().voiceActive);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
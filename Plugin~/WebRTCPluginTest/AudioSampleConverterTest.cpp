@@ -0,0 +1,98 @@
+#include "pch.h"
+
+#include <cmath>
+#include <cstring>
+#include <common_audio/include/audio_util.h>
+
+#include "AudioSampleConverter.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        // Floats around every rounding boundary of S16, plus a sparse sweep over
+        // all bit patterns except NaN which the scalar reference does not define.
+        std::vector<float> CreateFloatSamples()
+        {
+            std::vector<float> samples;
+            for (int k = -32769; k <= 32768; k++)
+            {
+                float value = (static_cast<float>(k) + 0.5f) / 32768.f;
+                for (int j = 0; j < 4; j++)
+                    value = std::nextafter(value, -2.f);
+                for (int j = 0; j < 9; j++)
+                {
+                    samples.push_back(value);
+                    value = std::nextafter(value, 2.f);
+                }
+            }
+            for (uint64_t bits = 0; bits <= UINT32_MAX; bits += 4099)
+            {
+                uint32_t u = static_cast<uint32_t>(bits);
+                float value;
+                std::memcpy(&value, &u, sizeof(value));
+                if (!std::isnan(value))
+                    samples.push_back(value);
+            }
+            samples.insert(samples.end(), { INFINITY, -INFINITY, 0.f, -0.f, 1.f, -1.f });
+            return samples;
+        }
+    }
+
+    class AudioSampleConverterTest : public testing::TestWithParam<AudioSampleConverterKernel>
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!IsAudioSampleConverterKernelSupported(GetParam()))
+                GTEST_SKIP() << "The kernel is not supported on this CPU.";
+        }
+    };
+
+    TEST_P(AudioSampleConverterTest, FloatToS16MatchesReference)
+    {
+        const std::vector<float> src = CreateFloatSamples();
+
+        // Shift the start to cover unaligned loads and every tail length.
+        for (size_t offset = 0; offset < 16; offset++)
+        {
+            std::vector<int16_t> dst(src.size() - offset);
+            ConvertFloatToS16(GetParam(), src.data() + offset, dst.size(), dst.data());
+            for (size_t i = 0; i < dst.size(); i++)
+                ASSERT_EQ(::webrtc::FloatToS16(src[i + offset]), dst[i]) << "sample=" << src[i + offset];
+        }
+    }
+
+    TEST_P(AudioSampleConverterTest, S16ToFloatMatchesReference)
+    {
+        std::vector<int16_t> src(UINT16_MAX + 1);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = static_cast<int16_t>(static_cast<int32_t>(i) + INT16_MIN);
+
+        for (size_t offset = 0; offset < 16; offset++)
+        {
+            std::vector<float> dst(src.size() - offset);
+            ConvertS16ToFloat(GetParam(), src.data() + offset, dst.size(), dst.data());
+            for (size_t i = 0; i < dst.size(); i++)
+                ASSERT_EQ(::webrtc::S16ToFloat(src[i + offset]), dst[i]) << "sample=" << src[i + offset];
+        }
+    }
+
+    TEST(AudioSampleConverter, DetectedKernelIsSupported)
+    {
+        EXPECT_TRUE(IsAudioSampleConverterKernelSupported(GetAudioSampleConverterKernel()));
+    }
+
+    INSTANTIATE_TEST_SUITE_P(
+        Kernel,
+        AudioSampleConverterTest,
+        testing::Values(
+            AudioSampleConverterKernel::Scalar,
+            AudioSampleConverterKernel::SSE2,
+            AudioSampleConverterKernel::AVX2,
+            AudioSampleConverterKernel::NEON));
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,157 @@
+#include "pch.h"
+
+#include <api/task_queue/default_task_queue_factory.h>
+#include <common_audio/include/audio_util.h>
+
+#include "AudioTrackSinkAdapter.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    constexpr int kSampleRate = 48000;
+    constexpr size_t kChannels = 2;
+    constexpr size_t kFramesFor10ms = kSampleRate / 100;
+    constexpr int kBitsPerSample = 16;
+
+    class AudioTrackSinkAdapterTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            // The first call allocates the buffer with the format of Unity's output.
+            std::vector<float> data(kFramesFor10ms * kChannels);
+            sink_.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+        }
+
+        AudioTrackSinkAdapter sink_;
+    };
+
+    TEST_F(AudioTrackSinkAdapterTest, BypassResamplerWhenFormatMatches)
+    {
+        std::vector<int16_t> audio(kFramesFor10ms * kChannels, 1000);
+        sink_.OnData(audio.data(), kBitsPerSample, kSampleRate, kChannels, kFramesFor10ms);
+
+        EXPECT_EQ(audio.size(), sink_.bypassedSamples());
+        EXPECT_EQ(0u, sink_.resampledSamples());
+
+        std::vector<float> data(audio.size());
+        sink_.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+        for (size_t i = 0; i < data.size(); i++)
+            EXPECT_FLOAT_EQ(::webrtc::S16ToFloat(audio[i]), data[i]);
+    }
+
+    TEST_F(AudioTrackSinkAdapterTest, ResampleWhenFormatDiffers)
+    {
+        constexpr int kSourceSampleRate = 16000;
+        constexpr size_t kSourceChannels = 1;
+        constexpr size_t kSourceFrames = kSourceSampleRate / 100;
+
+        std::vector<int16_t> audio(kSourceFrames * kSourceChannels, 1000);
+        sink_.OnData(audio.data(), kBitsPerSample, kSourceSampleRate, kSourceChannels, kSourceFrames);
+
+        EXPECT_EQ(0u, sink_.bypassedSamples());
+        EXPECT_EQ(kFramesFor10ms * kChannels, sink_.resampledSamples());
+    }
+
+    TEST(AudioTrackSinkAdapter, ResampleOnTaskQueue)
+    {
+        constexpr int kSourceSampleRate = 16000;
+        constexpr size_t kSourceChannels = 1;
+        constexpr size_t kSourceFrames = kSourceSampleRate / 100;
+        constexpr int kBatchFrames = 2;
+        constexpr int kFrameCount = 10;
+
+        auto factory = CreateDefaultTaskQueueFactory();
+        AudioTrackSinkOptions options;
+        options.backgroundResample = true;
+        options.batchFrames = kBatchFrames;
+        AudioTrackSinkAdapter sink(factory.get(), options);
+
+        std::vector<float> data(kFramesFor10ms * kChannels);
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+
+        std::vector<int16_t> audio(kSourceFrames * kSourceChannels, 1000);
+        for (int i = 0; i < kFrameCount; i++)
+        {
+            sink.OnData(audio.data(), kBitsPerSample, kSourceSampleRate, kSourceChannels, kSourceFrames);
+            // Keep pace with the audio thread so that the pool does not need to grow.
+            if (i % kBatchFrames == kBatchFrames - 1)
+                sink.WaitForTaskQueue();
+        }
+
+        AudioTrackSinkCounters counters = sink.GetCounters();
+        EXPECT_EQ(0u, counters.bypassedSamples);
+        EXPECT_EQ(kFrameCount * kFramesFor10ms * kChannels, counters.resampledSamples);
+        EXPECT_EQ(static_cast<uint64_t>(kFrameCount), counters.frameCopies);
+        EXPECT_EQ(0u, counters.frameAllocations);
+    }
+
+    TEST(AudioTrackSinkAdapter, FlushIncompleteBatch)
+    {
+        constexpr int kSourceSampleRate = 16000;
+        constexpr size_t kSourceChannels = 1;
+        constexpr size_t kSourceFrames = kSourceSampleRate / 100;
+
+        auto factory = CreateDefaultTaskQueueFactory();
+        AudioTrackSinkOptions options;
+        options.backgroundResample = true;
+        options.batchFrames = 4;
+        AudioTrackSinkAdapter sink(factory.get(), options);
+
+        std::vector<float> data(kFramesFor10ms * kChannels);
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+
+        // The last frames of a track which has stopped never fill a batch.
+        std::vector<int16_t> audio(kSourceFrames * kSourceChannels, 1000);
+        sink.OnData(audio.data(), kBitsPerSample, kSourceSampleRate, kSourceChannels, kSourceFrames);
+        sink.WaitForTaskQueue();
+        EXPECT_EQ(0u, sink.resampledSamples());
+
+        // Running short of audio passes them to the task queue.
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+        sink.WaitForTaskQueue();
+        EXPECT_EQ(kFramesFor10ms * kChannels, sink.resampledSamples());
+
+        sink.OnData(audio.data(), kBitsPerSample, kSourceSampleRate, kSourceChannels, kSourceFrames);
+        sink.Flush();
+        sink.WaitForTaskQueue();
+        EXPECT_EQ(2 * kFramesFor10ms * kChannels, sink.resampledSamples());
+    }
+
+    TEST(AudioTrackSinkAdapter, KeepOrderWhenFormatChanges)
+    {
+        constexpr int kSourceSampleRate = 16000;
+        constexpr size_t kSourceChannels = 1;
+        constexpr size_t kSourceFrames = kSourceSampleRate / 100;
+
+        auto factory = CreateDefaultTaskQueueFactory();
+        AudioTrackSinkOptions options;
+        options.backgroundResample = true;
+        options.batchFrames = 2;
+        AudioTrackSinkAdapter sink(factory.get(), options);
+
+        std::vector<float> data(kFramesFor10ms * kChannels);
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+
+        // The frame in the format of Unity's output waits behind the frame
+        // which is resampled.
+        std::vector<int16_t> resampled(kSourceFrames * kSourceChannels, 1000);
+        sink.OnData(resampled.data(), kBitsPerSample, kSourceSampleRate, kSourceChannels, kSourceFrames);
+        std::vector<int16_t> bypassed(kFramesFor10ms * kChannels, 2000);
+        sink.OnData(bypassed.data(), kBitsPerSample, kSampleRate, kChannels, kFramesFor10ms);
+        sink.WaitForTaskQueue();
+
+        AudioTrackSinkCounters counters = sink.GetCounters();
+        EXPECT_EQ(kFramesFor10ms * kChannels, counters.resampledSamples);
+        EXPECT_EQ(kFramesFor10ms * kChannels, counters.bypassedSamples);
+
+        // The resampled frame is read first.
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+        sink.ProcessAudio(data.data(), data.size(), kChannels, kSampleRate);
+        for (size_t i = 0; i < data.size(); i++)
+            EXPECT_FLOAT_EQ(::webrtc::S16ToFloat(bypassed[i]), data[i]);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
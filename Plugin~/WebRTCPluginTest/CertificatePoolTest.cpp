@@ -0,0 +1,78 @@
+#include "pch.h"
+
+#include <api/task_queue/default_task_queue_factory.h>
+#include <rtc_base/event.h>
+
+#include "CertificatePool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class CertificatePoolTest : public testing::Test
+    {
+    protected:
+        CertificatePoolTest()
+            : factory_(CreateDefaultTaskQueueFactory())
+            , queue_(factory_->CreateTaskQueue("CertificatePoolTest", TaskQueueFactory::Priority::NORMAL))
+            , pool_(std::make_unique<CertificatePool>(queue_.get()))
+        {
+        }
+        ~CertificatePoolTest() override
+        {
+            // The queue stops before the pool whose tasks it runs is destroyed.
+            queue_ = nullptr;
+            pool_ = nullptr;
+        }
+
+        // Waits for the tasks posted before the call.
+        void Flush()
+        {
+            rtc::Event done;
+            queue_->PostTask([&done]() { done.Set(); });
+            ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+        }
+
+        std::unique_ptr<TaskQueueFactory> factory_;
+        std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue_;
+        std::unique_ptr<CertificatePool> pool_;
+    };
+
+    TEST_F(CertificatePoolTest, EmptyWithoutCapacity)
+    {
+        EXPECT_EQ(pool_->Take(), nullptr);
+        Flush();
+        EXPECT_EQ(pool_->size(), 0u);
+    }
+
+    TEST_F(CertificatePoolTest, RefillsTakenCertificates)
+    {
+        pool_->SetCapacity(2);
+        Flush();
+        ASSERT_EQ(pool_->size(), 2u);
+
+        const auto first = pool_->Take();
+        const auto second = pool_->Take();
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        EXPECT_NE(first, second);
+
+        Flush();
+        EXPECT_EQ(pool_->size(), 2u);
+        EXPECT_NE(pool_->Take(), first);
+    }
+
+    TEST_F(CertificatePoolTest, ShrinkReleasesCertificates)
+    {
+        pool_->SetCapacity(3);
+        Flush();
+        EXPECT_EQ(pool_->size(), 3u);
+        pool_->SetCapacity(1);
+        EXPECT_EQ(pool_->size(), 1u);
+        pool_->SetCapacity(0);
+        EXPECT_EQ(pool_->size(), 0u);
+        EXPECT_EQ(pool_->Take(), nullptr);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -1,5 +1,9 @@
 #include "pch.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include <rtc_base/ref_counted_object.h>
 
 #include "Context.h"
@@ -7,6 +11,8 @@
 #include "GraphicsDevice/ITexture2D.h"
 #include "GraphicsDeviceContainer.h"
 #include "GraphicsDeviceTestBase.h"
+#include "PeerConnectionTestUtil.h"
+#include "UnityAudioTrackSource.h"
 #include "VideoFrameUtil.h"
 
 namespace unity
@@ -69,6 +75,33 @@ namespace webrtc
         EXPECT_NE(nullptr, track);
     }
 
+    TEST_P(ContextTest, CreateAndDestroyContextAsync)
+    {
+        auto wait = [](const ContextAsyncOperation& operation)
+        {
+            while (operation.state() == ContextAsyncState::kPending)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return operation.state();
+        };
+
+        ContextDependencies dependencies;
+        dependencies.device = device_;
+        ContextManager* manager = ContextManager::GetInstance();
+        const auto create = manager->CreateContextAsync(101, dependencies, nullptr);
+        EXPECT_EQ(ContextAsyncState::kSucceeded, wait(*create));
+        EXPECT_NE(nullptr, create->context());
+        EXPECT_EQ(create->context(), manager->GetContext(101));
+
+        // The ID is taken.
+        const auto duplicate = manager->CreateContextAsync(101, dependencies, nullptr);
+        EXPECT_EQ(ContextAsyncState::kFailed, wait(*duplicate));
+
+        // The context is unregistered before it is destroyed.
+        const auto destroy = manager->DestroyContextAsync(101, nullptr);
+        EXPECT_EQ(nullptr, manager->GetContext(101));
+        EXPECT_EQ(ContextAsyncState::kSucceeded, wait(*destroy));
+    }
+
     TEST_P(ContextTest, CreateAndDeleteMediaStream)
     {
         const auto stream = context->CreateMediaStream("test");
@@ -83,6 +116,19 @@ namespace webrtc
         EXPECT_NE(nullptr, track);
     }
 
+    TEST_P(ContextTest, RefPtrHandleIsInvalidatedOnRemove)
+    {
+        rtc::scoped_refptr<UnityVideoTrackSource> source = context->CreateVideoSource();
+        context->AddRefPtr(source);
+        const HandleTable::Handle handle = context->GetRefPtrHandle(source.get());
+        EXPECT_NE(HandleTable::kInvalidHandle, handle);
+        EXPECT_TRUE(context->ExistsRefPtr(handle, source.get()));
+
+        context->RemoveRefPtr(source);
+        EXPECT_FALSE(context->ExistsRefPtr(handle, source.get()));
+        EXPECT_EQ(HandleTable::kInvalidHandle, context->GetRefPtrHandle(source.get()));
+    }
+
     TEST_P(ContextTest, CreateAndDeleteAudioTrack)
     {
         const auto source = context->CreateAudioSource();
@@ -91,6 +137,27 @@ namespace webrtc
         EXPECT_NE(nullptr, track);
     }
 
+    TEST_P(ContextTest, CreateAndDeleteAudioTrackSinksOnThreads)
+    {
+        // The managed code may delete sinks from the finalizer thread.
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++)
+        {
+            threads.emplace_back(
+                [this]()
+                {
+                    for (int j = 0; j < 100; j++)
+                    {
+                        AudioTrackSinkAdapter* sink = context->CreateAudioTrackSinkAdapter();
+                        EXPECT_NE(nullptr, sink);
+                        context->DeleteAudioTrackSinkAdapter(sink);
+                    }
+                });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
     TEST_P(ContextTest, AddAndRemoveAudioTrackToMediaStream)
     {
         const auto stream = context->CreateMediaStream("audiostream");
@@ -123,6 +190,96 @@ namespace webrtc
         context->DeletePeerConnection(connection);
     }
 
+    TEST_P(ContextTest, OpusEncoderSettingsPerSender)
+    {
+        const auto source = context->CreateAudioSource();
+        const auto track = context->CreateAudioTrack("audio", source.get());
+        auto* audioSource = static_cast<UnityAudioTrackSource*>(source.get());
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto first = context->CreatePeerConnection(config);
+        const auto second = context->CreatePeerConnection(config);
+        auto firstSender = first->connection->AddTrack(track, { "stream" });
+        auto secondSender = second->connection->AddTrack(track, { "stream" });
+        ASSERT_TRUE(firstSender.ok());
+        ASSERT_TRUE(secondSender.ok());
+
+        OpusEncoderSettings settings;
+        settings.complexity = 5;
+        settings.maxBitrateBps = 32000;
+        EXPECT_EQ(
+            RTCErrorType::NONE,
+            context->SetOpusEncoderSettings(first, firstSender.value().get(), audioSource, settings));
+
+        // The senders of a track share the settings of the encoder.
+        OpusEncoderSettings other = settings;
+        other.complexity = 8;
+        EXPECT_EQ(
+            RTCErrorType::INVALID_MODIFICATION,
+            context->SetOpusEncoderSettings(second, secondSender.value().get(), audioSource, other));
+
+        // The maximum bitrate is kept for each sender.
+        other.complexity = 5;
+        other.maxBitrateBps = 16000;
+        EXPECT_EQ(
+            RTCErrorType::NONE,
+            context->SetOpusEncoderSettings(second, secondSender.value().get(), audioSource, other));
+        EXPECT_EQ(32000, firstSender.value()->GetParameters().encodings[0].max_bitrate_bps);
+        EXPECT_EQ(16000, secondSender.value()->GetParameters().encodings[0].max_bitrate_bps);
+
+        context->DeletePeerConnection(first);
+        context->DeletePeerConnection(second);
+    }
+
+    TEST_P(ContextTest, SeparateNetworkThread)
+    {
+        context = nullptr;
+
+        ContextDependencies dependencies;
+        dependencies.device = device_;
+        dependencies.threads.separateNetworkThread = true;
+        dependencies.threads.network.priority = ThreadPriorityHint::kLow;
+        context = std::make_unique<Context>(dependencies);
+
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto connection = context->CreatePeerConnection(config);
+        EXPECT_NE(nullptr, connection);
+        context->DeletePeerConnection(connection);
+    }
+
+    TEST_P(ContextTest, PeerConnectionsArePlacedOnLeastLoadedShard)
+    {
+        context = nullptr;
+
+        ContextDependencies dependencies;
+        dependencies.device = device_;
+        dependencies.threads.factoryShards = 2;
+        context = std::make_unique<Context>(dependencies);
+        EXPECT_EQ(context->shardCount(), 2u);
+
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        std::vector<PeerConnectionObject*> connections;
+        for (int i = 0; i < 4; i++)
+            connections.push_back(context->CreatePeerConnection(config));
+        EXPECT_EQ(context->GetPeerConnectionCountPerShard(), std::vector<size_t>({ 2, 2 }));
+
+        context->DeletePeerConnection(connections[0]);
+        context->DeletePeerConnection(connections[2]);
+        EXPECT_EQ(context->GetPeerConnectionCountPerShard(), std::vector<size_t>({ 0, 2 }));
+
+        // A track of the first shard is added to a connection of the second shard.
+        const auto source = context->CreateAudioSource();
+        const auto track = context->CreateAudioTrack("audio", source.get());
+        const auto result = connections[1]->connection->AddTrack(track, { "stream" });
+        EXPECT_TRUE(result.ok());
+
+        const auto connection = context->CreatePeerConnection(config);
+        EXPECT_EQ(context->GetPeerConnectionCountPerShard(), std::vector<size_t>({ 1, 2 }));
+
+        context->DeletePeerConnection(connection);
+        context->DeletePeerConnection(connections[1]);
+        context->DeletePeerConnection(connections[3]);
+    }
+
     TEST_P(ContextTest, CreateAndDeleteDataChannel)
     {
         const webrtc::PeerConnectionInterface::RTCConfiguration config;
@@ -136,6 +293,179 @@ namespace webrtc
         context->DeletePeerConnection(connection);
     }
 
+    static std::atomic<int> s_eventsPending { 0 };
+    static void OnEventsPending(Context* context) { s_eventsPending++; }
+
+    TEST_P(ContextTest, ObserverEventsAreQueued)
+    {
+        s_eventsPending = 0;
+        Context::RegisterOnEventsPending(&OnEventsPending);
+
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto connection = context->CreatePeerConnection(config);
+        DataChannelInit init;
+        const auto channel = context->CreateDataChannel(connection, "test", init);
+
+        // Adding the first data channel requires a negotiation.
+        bool negotiationNeeded = false;
+        for (int i = 0; i < 1000 && !negotiationNeeded; i++)
+        {
+            const EventRecord* records = nullptr;
+            int32_t count = context->DrainEvents(&records);
+            for (int32_t j = 0; j < count; j++)
+            {
+                if (records[j].type == EventType::NegotiationNeeded && records[j].sender == connection)
+                    negotiationNeeded = true;
+            }
+            if (!negotiationNeeded)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(negotiationNeeded);
+        EXPECT_GE(s_eventsPending.load(), 1);
+
+        context->DeleteDataChannel(channel);
+        context->DeletePeerConnection(connection);
+        Context::RegisterOnEventsPending(nullptr);
+    }
+
+    // Creates a loopback pair and connects it. The pair takes the pooled
+    // connections when the configuration matches the one of the pool.
+    static void ConnectLoopbackPair(
+        Context* context, const PeerConnectionInterface::RTCConfiguration& config, bool expectPooled)
+    {
+        const uint64_t claimed = context->pooledPeerConnectionClaimCount();
+        const auto offerer = context->CreatePeerConnection(config);
+        const auto answerer = context->CreatePeerConnection(config);
+        ASSERT_NE(offerer, nullptr);
+        ASSERT_NE(answerer, nullptr);
+        EXPECT_EQ(context->pooledPeerConnectionClaimCount() - claimed, expectPooled ? 2u : 0u);
+
+        // Only the connections prepared by the pool have their certificate
+        // attached by the context in this test.
+        EXPECT_EQ(!offerer->connection->GetConfiguration().certificates.empty(), expectPooled);
+        EXPECT_EQ(!answerer->connection->GetConfiguration().certificates.empty(), expectPooled);
+
+        DataChannelInit init;
+        const auto channel = context->CreateDataChannel(offerer, "test", init);
+        EXPECT_TRUE(Negotiate(offerer, answerer));
+        EXPECT_TRUE(WaitForConnected(context, offerer, answerer));
+
+        context->DeleteDataChannel(channel);
+        offerer->Close();
+        answerer->Close();
+        context->DeletePeerConnection(offerer);
+        context->DeletePeerConnection(answerer);
+    }
+
+    TEST_P(ContextTest, ConnectPeerConnectionsTakenFromPool)
+    {
+        SignalingCallbacks::Register();
+
+        PeerConnectionInterface::RTCConfiguration config;
+        config.ice_candidate_pool_size = 1;
+        ConnectLoopbackPair(context.get(), config, false);
+
+        constexpr size_t kPoolSize = 2;
+        context->SetPeerConnectionPool(config, kPoolSize);
+        for (int i = 0; i < 10000 && context->pooledPeerConnectionCount() < kPoolSize; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_EQ(context->pooledPeerConnectionCount(), kPoolSize);
+        ConnectLoopbackPair(context.get(), config, true);
+
+        // A different configuration does not take the pooled connections.
+        PeerConnectionInterface::RTCConfiguration other = config;
+        other.ice_candidate_pool_size = 0;
+        const uint64_t claimed = context->pooledPeerConnectionClaimCount();
+        const auto connection = context->CreatePeerConnection(other);
+        EXPECT_EQ(connection->connection->GetConfiguration().ice_candidate_pool_size, 0);
+        EXPECT_EQ(context->pooledPeerConnectionClaimCount(), claimed);
+        context->DeletePeerConnection(connection);
+
+        context->SetPeerConnectionPool(config, 0);
+        EXPECT_EQ(context->pooledPeerConnectionCount(), 0u);
+
+        SignalingCallbacks::Unregister();
+    }
+
+    TEST_P(ContextTest, SendChunkedMessagesOverLoopbackPair)
+    {
+        SignalingCallbacks::Register();
+
+        const PeerConnectionInterface::RTCConfiguration config;
+        const auto offerer = context->CreatePeerConnection(config);
+        const auto answerer = context->CreatePeerConnection(config);
+
+        // Negotiated channels are created on both sides without waiting for
+        // the data channel event.
+        DataChannelInit init;
+        init.negotiated = true;
+        init.id = 1;
+        const auto sender = context->CreateDataChannel(offerer, "chunked", init);
+        const auto receiver = context->CreateDataChannel(answerer, "chunked", init);
+        context->GetDataChannelObject(sender)->SetChunking(true, 1024);
+        context->GetDataChannelObject(receiver)->SetChunking(true, 1024);
+
+        ASSERT_TRUE(Negotiate(offerer, answerer));
+        ASSERT_TRUE(WaitForConnected(context.get(), offerer, answerer));
+        for (int i = 0; i < 10000 && (sender->state() != DataChannelInterface::kOpen ||
+                                      receiver->state() != DataChannelInterface::kOpen);
+             i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_EQ(sender->state(), DataChannelInterface::kOpen);
+        ASSERT_EQ(receiver->state(), DataChannelInterface::kOpen);
+
+        // The large message exceeds the message size limit of SCTP.
+        std::string large(512 * 1024, '\0');
+        for (size_t i = 0; i < large.size(); i++)
+            large[i] = static_cast<char>(i * 31);
+        const std::string small = "small";
+        DataChannelObject* object = context->GetDataChannelObject(sender);
+        ASSERT_TRUE(object->Send(DataBuffer(rtc::CopyOnWriteBuffer(large.data(), large.size()), true)));
+        ASSERT_TRUE(object->Send(DataBuffer(small)));
+
+        std::vector<std::pair<std::string, bool>> messages;
+        for (int i = 0; i < 10000 && messages.size() < 2; i++)
+        {
+            const EventRecord* records = nullptr;
+            int32_t count = context->DrainEvents(&records);
+            for (int32_t j = 0; j < count; j++)
+            {
+                if (records[j].type == EventType::DataChannelMessage && records[j].sender == receiver)
+                    messages.emplace_back(std::string(records[j].data, records[j].length), records[j].value != 0);
+            }
+            if (messages.size() < 2)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_EQ(messages.size(), 2u);
+        std::sort(
+            messages.begin(),
+            messages.end(),
+            [](const auto& a, const auto& b) { return a.first.size() < b.first.size(); });
+        EXPECT_EQ(messages[0].first, small);
+        EXPECT_FALSE(messages[0].second);
+        EXPECT_EQ(messages[1].first, large);
+        EXPECT_TRUE(messages[1].second);
+
+        // Messages over the send queue limit are rejected instead of being
+        // kept by the chunker.
+        object->flowControl().SetSendQueueLimit(large.size() - 1);
+        EXPECT_FALSE(object->Send(DataBuffer(rtc::CopyOnWriteBuffer(large.data(), large.size()), true)));
+        object->flowControl().SetSendQueueLimit(0);
+
+        sender->Close();
+        for (int i = 0; i < 10000 && sender->state() != DataChannelInterface::kClosed; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_FALSE(object->Send(DataBuffer(small)));
+
+        context->DeleteDataChannel(sender);
+        context->DeleteDataChannel(receiver);
+        offerer->Close();
+        answerer->Close();
+        context->DeletePeerConnection(offerer);
+        context->DeletePeerConnection(answerer);
+        SignalingCallbacks::Unregister();
+    }
+
     TEST_P(ContextTest, AddTrackAndRemoveTrack)
     {
         const webrtc::PeerConnectionInterface::RTCConfiguration config;
@@ -175,6 +505,64 @@ namespace webrtc
         context->DeleteVideoRenderer(renderer);
     }
 
+    TEST_P(ContextTest, TryGetVideoRendererAfterDelete)
+    {
+        const auto renderer = context->CreateVideoRenderer(callback_videoframeresize, true);
+        const auto rendererId = renderer->GetId();
+        std::shared_ptr<UnityVideoRenderer> rendererGetById;
+        EXPECT_TRUE(context->TryGetVideoRenderer(rendererId, &rendererGetById));
+        EXPECT_EQ(renderer, rendererGetById.get());
+        context->DeleteVideoRenderer(renderer);
+        EXPECT_TRUE(context->TryGetVideoRenderer(rendererId, &rendererGetById));
+        EXPECT_EQ(nullptr, rendererGetById);
+        EXPECT_EQ(0u, context->skippedRenderEventCount());
+    }
+
+    TEST_P(ContextTest, RefPtrIsReleasedAfterRenderEvent)
+    {
+        class Object : public rtc::RefCountInterface
+        {
+        public:
+            explicit Object(bool* released)
+                : released_(released)
+            {
+            }
+            ~Object() override { *released_ = true; }
+
+        private:
+            bool* released_;
+        };
+
+        ContextDependencies dependencies;
+        dependencies.device = device_;
+        ContextManager* manager = ContextManager::GetInstance();
+        Context* registered = manager->CreateContext(100, dependencies);
+        ASSERT_NE(nullptr, registered);
+        const HandleTable::Handle contextHandle = registered->handle();
+
+        bool released = false;
+        rtc::RefCountInterface* object = rtc::make_ref_counted<Object>(&released).release();
+        registered->AddRefPtr(object);
+        object->Release();
+        const HandleTable::Handle handle = registered->GetRefPtrHandle(object);
+
+        // The object is kept while a render event which may use it is in flight.
+        EXPECT_TRUE(manager->BeginRenderEvent(contextHandle, registered));
+        EXPECT_TRUE(registered->ExistsRefPtr(handle, object));
+        registered->RemoveRefPtr(object);
+        EXPECT_FALSE(registered->ExistsRefPtr(handle, object));
+        EXPECT_FALSE(released);
+        manager->EndRenderEvent();
+
+        const auto source = registered->CreateVideoSource();
+        registered->AddRefPtr(source);
+        EXPECT_TRUE(released);
+        registered->RemoveRefPtr(source.get());
+
+        manager->DestroyContext(100);
+        EXPECT_FALSE(manager->BeginRenderEvent(contextHandle, registered));
+    }
+
     TEST_P(ContextTest, AddAndRemoveVideoRendererToVideoTrack)
     {
         const auto source = context->CreateVideoSource();
@@ -0,0 +1,183 @@
+#include "pch.h"
+
+#include <algorithm>
+
+#include "DataChannelChunker.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        DataBuffer CreateMessage(size_t size, bool binary)
+        {
+            rtc::CopyOnWriteBuffer buffer(size);
+            for (size_t i = 0; i < size; i++)
+                buffer.MutableData()[i] = static_cast<uint8_t>(i * 31 + size);
+            return DataBuffer(buffer, binary);
+        }
+
+        // Passes all chunks to the reassembler as a loopback pair does.
+        std::vector<DataBuffer> Loopback(DataChannelChunker& chunker, DataChannelReassembler& reassembler)
+        {
+            std::vector<DataBuffer> messages;
+            DataBuffer chunk(rtc::CopyOnWriteBuffer(), true);
+            DataBuffer message(rtc::CopyOnWriteBuffer(), true);
+            while (chunker.Next(&chunk))
+            {
+                EXPECT_LE(chunk.size(), chunker.chunkSize() + kChunkHeaderSize);
+                if (reassembler.Push(chunk, &message))
+                    messages.push_back(message);
+            }
+            return messages;
+        }
+    }
+
+    class DataChannelChunkerTest : public testing::TestWithParam<size_t>
+    {
+    };
+
+    TEST_P(DataChannelChunkerTest, Reassemble)
+    {
+        DataChannelChunker chunker(1024);
+        DataChannelReassembler reassembler;
+        const DataBuffer binary = CreateMessage(GetParam(), true);
+        const DataBuffer text = CreateMessage(GetParam(), false);
+        chunker.Enqueue(binary);
+        chunker.Enqueue(text);
+
+        std::vector<DataBuffer> messages = Loopback(chunker, reassembler);
+        ASSERT_EQ(2u, messages.size());
+        EXPECT_EQ(binary.data, messages[0].data);
+        EXPECT_TRUE(messages[0].binary);
+        EXPECT_EQ(text.data, messages[1].data);
+        EXPECT_FALSE(messages[1].binary);
+        EXPECT_EQ(0u, reassembler.pendingMessages());
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Size, DataChannelChunkerTest, testing::Values(0, 1, 1023, 1024, 1025, 64 * 1024 + 7));
+
+    TEST(DataChannelChunker, InterleaveSmallMessage)
+    {
+        DataChannelChunker chunker(1024);
+        DataChannelReassembler reassembler;
+        chunker.Enqueue(CreateMessage(16 * 1024, true));
+        chunker.Enqueue(CreateMessage(10, true));
+
+        std::vector<DataBuffer> messages = Loopback(chunker, reassembler);
+        ASSERT_EQ(2u, messages.size());
+        // The small message is received after the first chunk of the large one.
+        EXPECT_EQ(10u, messages[0].size());
+        EXPECT_EQ(16u * 1024, messages[1].size());
+    }
+
+    TEST(DataChannelChunker, CountPendingBytes)
+    {
+        DataChannelChunker chunker(1024);
+        chunker.Enqueue(CreateMessage(1500, true));
+        EXPECT_EQ(1500u, chunker.pendingBytes());
+
+        DataBuffer chunk(rtc::CopyOnWriteBuffer(), true);
+        ASSERT_TRUE(chunker.Next(&chunk));
+        EXPECT_EQ(476u, chunker.pendingBytes());
+        ASSERT_TRUE(chunker.Next(&chunk));
+        EXPECT_EQ(0u, chunker.pendingBytes());
+    }
+
+    TEST(DataChannelChunker, ReassembleOutOfOrder)
+    {
+        DataChannelChunker chunker(100);
+        DataChannelReassembler reassembler;
+        const DataBuffer sent = CreateMessage(1000, true);
+        chunker.Enqueue(sent);
+
+        std::vector<DataBuffer> chunks;
+        DataBuffer chunk(rtc::CopyOnWriteBuffer(), true);
+        while (chunker.Next(&chunk))
+            chunks.push_back(chunk);
+        std::reverse(chunks.begin(), chunks.end());
+
+        DataBuffer message(rtc::CopyOnWriteBuffer(), true);
+        for (size_t i = 0; i < chunks.size() - 1; i++)
+            EXPECT_FALSE(reassembler.Push(chunks[i], &message));
+        ASSERT_TRUE(reassembler.Push(chunks.back(), &message));
+        EXPECT_EQ(sent.data, message.data);
+    }
+
+    TEST(DataChannelChunker, ReuseBuffer)
+    {
+        DataChannelChunker chunker(1024);
+        DataChannelReassembler reassembler;
+        chunker.Enqueue(CreateMessage(4096, true));
+        std::vector<DataBuffer> messages = Loopback(chunker, reassembler);
+        ASSERT_EQ(1u, messages.size());
+        const uint8_t* data = messages[0].data.cdata();
+        messages.clear();
+
+        chunker.Enqueue(CreateMessage(4096, true));
+        messages = Loopback(chunker, reassembler);
+        ASSERT_EQ(1u, messages.size());
+        EXPECT_EQ(data, messages[0].data.cdata());
+    }
+
+    TEST(DataChannelChunker, KeepBufferInUse)
+    {
+        DataChannelChunker chunker(1024);
+        DataChannelReassembler reassembler;
+        const DataBuffer first = CreateMessage(4096, true);
+        chunker.Enqueue(first);
+        std::vector<DataBuffer> messages = Loopback(chunker, reassembler);
+        ASSERT_EQ(1u, messages.size());
+
+        chunker.Enqueue(CreateMessage(4096, false));
+        std::vector<DataBuffer> next = Loopback(chunker, reassembler);
+        ASSERT_EQ(1u, next.size());
+        EXPECT_EQ(first.data, messages[0].data);
+        EXPECT_NE(messages[0].data.cdata(), next[0].data.cdata());
+    }
+
+    TEST(DataChannelChunker, RejectTooLargeMessage)
+    {
+        DataChannelChunker chunker(1024);
+        DataChannelReassembler reassembler(4096);
+        chunker.Enqueue(CreateMessage(4097, true));
+        EXPECT_TRUE(Loopback(chunker, reassembler).empty());
+        EXPECT_EQ(0u, reassembler.pendingMessages());
+
+        chunker.Enqueue(CreateMessage(4096, true));
+        EXPECT_EQ(1u, Loopback(chunker, reassembler).size());
+    }
+
+    TEST(DataChannelChunker, IgnoreDuplicateChunk)
+    {
+        DataChannelChunker chunker(100);
+        DataChannelReassembler reassembler;
+        const DataBuffer sent = CreateMessage(300, true);
+        chunker.Enqueue(sent);
+
+        std::vector<DataBuffer> chunks;
+        DataBuffer chunk(rtc::CopyOnWriteBuffer(), true);
+        while (chunker.Next(&chunk))
+            chunks.push_back(chunk);
+        ASSERT_EQ(3u, chunks.size());
+
+        // The duplicate does not complete the message with a chunk missing.
+        DataBuffer message(rtc::CopyOnWriteBuffer(), true);
+        EXPECT_FALSE(reassembler.Push(chunks[0], &message));
+        EXPECT_FALSE(reassembler.Push(chunks[1], &message));
+        EXPECT_FALSE(reassembler.Push(chunks[1], &message));
+        ASSERT_TRUE(reassembler.Push(chunks[2], &message));
+        EXPECT_EQ(sent.data, message.data);
+    }
+
+    TEST(DataChannelChunker, RejectInvalidChunk)
+    {
+        DataChannelReassembler reassembler;
+        DataBuffer message(rtc::CopyOnWriteBuffer(), true);
+        EXPECT_FALSE(reassembler.Push(DataBuffer("invalid"), &message));
+        EXPECT_EQ(0u, reassembler.pendingMessages());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
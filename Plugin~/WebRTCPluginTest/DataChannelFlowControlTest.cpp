@@ -0,0 +1,208 @@
+#include "pch.h"
+
+#include <thread>
+
+#include <rtc_base/event.h>
+#include <rtc_base/ref_counted_object.h>
+#include <rtc_base/thread.h>
+
+#include "DataChannelFlowControl.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Emulates the send buffer of SCTP which is drained by `Transmit`.
+    class FakeDataChannel : public DataChannelInterface
+    {
+    public:
+        void RegisterObserver(DataChannelObserver* observer) override { }
+        void UnregisterObserver() override { }
+        std::string label() const override { return "test"; }
+        bool reliable() const override { return true; }
+        int id() const override { return 0; }
+        DataState state() const override { return kOpen; }
+        RTCError error() const override { return RTCError::OK(); }
+        uint32_t messages_sent() const override { return static_cast<uint32_t>(sent_.size()); }
+        uint64_t bytes_sent() const override { return 0; }
+        uint32_t messages_received() const override { return 0; }
+        uint64_t bytes_received() const override { return 0; }
+        uint64_t buffered_amount() const override { return bufferedAmount_; }
+        void Close() override { }
+        bool Send(const DataBuffer& buffer) override
+        {
+            if (bufferedAmount_ + buffer.size() > MaxSendQueueSize())
+                return false;
+            bufferedAmount_ += buffer.size();
+            sent_.push_back(buffer.size());
+            return true;
+        }
+
+        uint64_t Transmit(uint64_t size)
+        {
+            size = std::min(size, bufferedAmount_);
+            bufferedAmount_ -= size;
+            return size;
+        }
+        const std::vector<size_t>& sent() const { return sent_; }
+
+    private:
+        uint64_t bufferedAmount_ = 0;
+        std::vector<size_t> sent_;
+    };
+
+    // Runs the methods on a signaling thread like the proxy of a data channel
+    // does, and transmits each message on that thread after it is sent.
+    class ThreadedFakeDataChannel : public FakeDataChannel
+    {
+    public:
+        explicit ThreadedFakeDataChannel(rtc::Thread* thread)
+            : thread_(thread)
+        {
+        }
+
+        void SetFlowControl(DataChannelFlowControl* flowControl) { flowControl_ = flowControl; }
+
+        uint64_t buffered_amount() const override
+        {
+            return thread_->BlockingCall([this]() { return FakeDataChannel::buffered_amount(); });
+        }
+        bool Send(const DataBuffer& buffer) override
+        {
+            return thread_->BlockingCall(
+                [this, &buffer]()
+                {
+                    const bool result = FakeDataChannel::Send(buffer);
+                    thread_->PostTask([this, size = buffer.size()]()
+                                      { flowControl_->OnBufferedAmountChange(Transmit(size)); });
+                    return result;
+                });
+        }
+        size_t sentCount() const
+        {
+            return thread_->BlockingCall([this]() { return sent().size(); });
+        }
+
+    private:
+        rtc::Thread* thread_;
+        DataChannelFlowControl* flowControl_ = nullptr;
+    };
+
+    class DataChannelFlowControlTest : public testing::Test
+    {
+    protected:
+        DataChannelFlowControlTest()
+            : channel_(new rtc::RefCountedObject<FakeDataChannel>())
+            , flowControl_(channel_.get())
+        {
+        }
+
+        static DataBuffer CreateMessage(size_t size)
+        {
+            return DataBuffer(rtc::CopyOnWriteBuffer(size), true);
+        }
+
+        rtc::scoped_refptr<FakeDataChannel> channel_;
+        DataChannelFlowControl flowControl_;
+    };
+
+    TEST_F(DataChannelFlowControlTest, SendDirectlyWithoutQueue)
+    {
+        const size_t size = DataChannelInterface::MaxSendQueueSize();
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        // The send buffer of the channel overflows.
+        EXPECT_FALSE(flowControl_.Send(CreateMessage(1)));
+        EXPECT_EQ(0u, flowControl_.queuedAmount());
+    }
+
+    TEST_F(DataChannelFlowControlTest, QueueWhenSendBufferIsFull)
+    {
+        const size_t size = DataChannelInterface::MaxSendQueueSize() / 2;
+        flowControl_.SetSendQueueLimit(size * 2);
+
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_EQ(2u, channel_->sent().size());
+        EXPECT_EQ(size, flowControl_.queuedAmount());
+
+        flowControl_.OnBufferedAmountChange(channel_->Transmit(size));
+        EXPECT_EQ(3u, channel_->sent().size());
+        EXPECT_EQ(0u, flowControl_.queuedAmount());
+    }
+
+    TEST_F(DataChannelFlowControlTest, RejectWhenQueueIsFull)
+    {
+        const size_t size = DataChannelInterface::MaxSendQueueSize();
+        flowControl_.SetSendQueueLimit(size);
+
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_FALSE(flowControl_.Send(CreateMessage(1)));
+        EXPECT_EQ(size, flowControl_.queuedAmount());
+    }
+
+    TEST_F(DataChannelFlowControlTest, KeepMessageOrder)
+    {
+        const size_t size = DataChannelInterface::MaxSendQueueSize();
+        flowControl_.SetSendQueueLimit(size);
+
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(size)));
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(10)));
+        // Fits in the send buffer, but must wait for the queued message.
+        flowControl_.OnBufferedAmountChange(channel_->Transmit(5));
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(1)));
+        EXPECT_EQ(1u, channel_->sent().size());
+
+        flowControl_.OnBufferedAmountChange(channel_->Transmit(size));
+        ASSERT_EQ(3u, channel_->sent().size());
+        EXPECT_EQ(10u, channel_->sent()[1]);
+        EXPECT_EQ(1u, channel_->sent()[2]);
+    }
+
+    TEST_F(DataChannelFlowControlTest, BufferedAmountLow)
+    {
+        flowControl_.SetBufferedAmountLowThreshold(100);
+        EXPECT_TRUE(flowControl_.Send(CreateMessage(300)));
+
+        EXPECT_FALSE(flowControl_.OnBufferedAmountChange(channel_->Transmit(100)));
+        EXPECT_TRUE(flowControl_.OnBufferedAmountChange(channel_->Transmit(100)));
+        // Fired only when the amount crosses the threshold.
+        EXPECT_FALSE(flowControl_.OnBufferedAmountChange(channel_->Transmit(100)));
+    }
+
+    TEST(DataChannelFlowControlThreadTest, CallbackOnSignalingThread)
+    {
+        std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+        thread->Start();
+        auto channel = rtc::make_ref_counted<ThreadedFakeDataChannel>(thread.get());
+        DataChannelFlowControl flowControl(channel.get());
+        channel->SetFlowControl(&flowControl);
+
+        const size_t size = DataChannelInterface::MaxSendQueueSize() / 4;
+        const size_t count = 64;
+        flowControl.SetSendQueueLimit(size * count);
+
+        // The flow control must not hold its lock while the sending thread
+        // waits for the signaling thread, which handles the callbacks.
+        rtc::Event done;
+        std::thread sender(
+            [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                    EXPECT_TRUE(flowControl.Send(DataBuffer(rtc::CopyOnWriteBuffer(size), true)));
+                done.Set();
+            });
+        EXPECT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+        sender.join();
+
+        // Every queued message is sent by the callbacks of the transmitted ones.
+        for (int i = 0; i < 1000 && flowControl.queuedAmount() > 0; i++)
+            thread->BlockingCall([]() {});
+        EXPECT_EQ(count, channel->sentCount());
+        EXPECT_EQ(0u, flowControl.queuedAmount());
+        thread->Stop();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,80 @@
+#include "pch.h"
+
+#include "DataChannelMessageQueue.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(DataChannelMessageQueueTest, DrainEmpty)
+    {
+        DataChannelMessageQueue queue;
+        const uint8_t* data = nullptr;
+        const DataChannelMessageIndex* index = nullptr;
+        EXPECT_EQ(0, queue.Drain(&data, &index));
+    }
+
+    TEST(DataChannelMessageQueueTest, DrainPackedMessages)
+    {
+        DataChannelMessageQueue queue;
+        queue.Push(DataBuffer("hello"));
+        const uint8_t binary[] = { 1, 2, 3 };
+        queue.Push(DataBuffer(rtc::CopyOnWriteBuffer(binary, sizeof(binary)), true));
+        EXPECT_EQ(2u, queue.size());
+
+        const uint8_t* data = nullptr;
+        const DataChannelMessageIndex* index = nullptr;
+        ASSERT_EQ(2, queue.Drain(&data, &index));
+        EXPECT_EQ(0u, queue.size());
+
+        EXPECT_EQ(0, index[0].offset);
+        EXPECT_EQ(5, index[0].length);
+        EXPECT_EQ(0, index[0].binary);
+        EXPECT_EQ("hello", std::string(reinterpret_cast<const char*>(data + index[0].offset), index[0].length));
+
+        EXPECT_EQ(5, index[1].offset);
+        EXPECT_EQ(3, index[1].length);
+        EXPECT_EQ(1, index[1].binary);
+        EXPECT_EQ(0, std::memcmp(binary, data + index[1].offset, sizeof(binary)));
+    }
+
+    TEST(DataChannelMessageQueueTest, DrainedBatchIsValidUntilNextDrain)
+    {
+        DataChannelMessageQueue queue;
+        queue.Push(DataBuffer("first"));
+
+        const uint8_t* data = nullptr;
+        const DataChannelMessageIndex* index = nullptr;
+        ASSERT_EQ(1, queue.Drain(&data, &index));
+
+        // Messages received while reading the batch go to the other one.
+        queue.Push(DataBuffer("second"));
+        EXPECT_EQ("first", std::string(reinterpret_cast<const char*>(data), index[0].length));
+
+        ASSERT_EQ(1, queue.Drain(&data, &index));
+        EXPECT_EQ("second", std::string(reinterpret_cast<const char*>(data), index[0].length));
+    }
+
+    TEST(DataChannelMessageQueueTest, DropMessagesOverCapacity)
+    {
+        DataChannelMessageQueue queue;
+        EXPECT_EQ(DataChannelMessageQueue::kDefaultCapacity, queue.capacity());
+        queue.SetCapacity(8);
+        EXPECT_TRUE(queue.Push(DataBuffer("first")));
+        EXPECT_FALSE(queue.Push(DataBuffer("second")));
+        EXPECT_EQ(1u, queue.size());
+        EXPECT_EQ(1u, queue.droppedCount());
+
+        // Draining makes room for new messages.
+        const uint8_t* data = nullptr;
+        const DataChannelMessageIndex* index = nullptr;
+        ASSERT_EQ(1, queue.Drain(&data, &index));
+        EXPECT_TRUE(queue.Push(DataBuffer("second")));
+
+        queue.SetCapacity(0);
+        EXPECT_TRUE(queue.Push(DataBuffer("third")));
+        EXPECT_EQ(2u, queue.size());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
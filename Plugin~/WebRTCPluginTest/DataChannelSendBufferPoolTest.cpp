@@ -0,0 +1,71 @@
+#include "pch.h"
+
+#include <api/data_channel_interface.h>
+
+#include "DataChannelSendBufferPool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(DataChannelSendBufferPoolTest, ReuseReturnedBuffer)
+    {
+        DataChannelSendBufferPool pool;
+        rtc::CopyOnWriteBuffer* buffer = pool.Lease(1024);
+        EXPECT_EQ(1024u, buffer->size());
+        EXPECT_TRUE(pool.IsLeased(buffer));
+        const uint8_t* storage = buffer->cdata();
+        pool.Return(buffer);
+        EXPECT_FALSE(pool.IsLeased(buffer));
+        EXPECT_EQ(1u, pool.pooledCount());
+
+        buffer = pool.Lease(512);
+        EXPECT_EQ(512u, buffer->size());
+        EXPECT_EQ(storage, buffer->cdata());
+        EXPECT_EQ(1u, pool.allocationCount());
+        pool.Return(buffer);
+    }
+
+    TEST(DataChannelSendBufferPoolTest, SendWithoutCopy)
+    {
+        DataChannelSendBufferPool pool;
+        rtc::CopyOnWriteBuffer* buffer = pool.Lease(16);
+        std::memset(buffer->MutableData(), 0x5a, buffer->size());
+
+        // The data buffer passed to the data channel shares the storage.
+        DataBuffer message(*buffer, true);
+        EXPECT_EQ(buffer->cdata(), message.data.cdata());
+        pool.Return(buffer);
+    }
+
+    TEST(DataChannelSendBufferPoolTest, DetachStorageInUse)
+    {
+        DataChannelSendBufferPool pool;
+        rtc::CopyOnWriteBuffer* buffer = pool.Lease(16);
+        std::memset(buffer->MutableData(), 0x5a, buffer->size());
+
+        // Keep the storage referenced as if the message is queued.
+        rtc::CopyOnWriteBuffer queued = *buffer;
+        pool.Return(buffer);
+
+        buffer = pool.Lease(16);
+        EXPECT_NE(queued.cdata(), buffer->cdata());
+        std::memset(buffer->MutableData(), 0, buffer->size());
+        EXPECT_EQ(0x5a, queued.cdata()[0]);
+        EXPECT_EQ(2u, pool.allocationCount());
+        pool.Return(buffer);
+    }
+
+    TEST(DataChannelSendBufferPoolTest, LimitPooledBuffers)
+    {
+        DataChannelSendBufferPool pool;
+        std::vector<rtc::CopyOnWriteBuffer*> buffers;
+        for (size_t i = 0; i < DataChannelSendBufferPool::kMaxPooledBuffers + 1; i++)
+            buffers.push_back(pool.Lease(16));
+        for (auto buffer : buffers)
+            pool.Return(buffer);
+        EXPECT_EQ(DataChannelSendBufferPool::kMaxPooledBuffers, pool.pooledCount());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
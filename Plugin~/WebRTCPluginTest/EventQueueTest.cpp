@@ -0,0 +1,90 @@
+#include "pch.h"
+
+#include <thread>
+
+#include "EventQueue.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    static EventRecord MakeRecord(EventType type, int32_t value)
+    {
+        EventRecord record = {};
+        record.type = type;
+        record.value = value;
+        return record;
+    }
+
+    TEST(EventQueueTest, DrainInOrder)
+    {
+        EventQueue queue;
+        const EventRecord* records = nullptr;
+        EXPECT_EQ(queue.Drain(&records), 0);
+
+        EXPECT_TRUE(queue.Push(MakeRecord(EventType::IceCandidate, 1), "candidate", "0"));
+        EXPECT_FALSE(queue.Push(MakeRecord(EventType::NegotiationNeeded, 2)));
+        EXPECT_FALSE(queue.Push(MakeRecord(EventType::DataChannelMessage, 1), std::string_view("a\0b", 3)));
+
+        ASSERT_EQ(queue.Drain(&records), 3);
+        EXPECT_EQ(records[0].type, EventType::IceCandidate);
+        EXPECT_STREQ(records[0].data, "candidate");
+        EXPECT_STREQ(records[0].text, "0");
+        EXPECT_EQ(records[1].type, EventType::NegotiationNeeded);
+        EXPECT_EQ(records[1].value, 2);
+        EXPECT_EQ(records[1].length, 0);
+        EXPECT_EQ(records[2].length, 3);
+        EXPECT_EQ(std::string(records[2].data, records[2].length), std::string("a\0b", 3));
+
+        // The first push after a drain notifies the consumer again.
+        EXPECT_TRUE(queue.Push(MakeRecord(EventType::Track, 0)));
+        ASSERT_EQ(queue.Drain(&records), 1);
+        EXPECT_EQ(records[0].type, EventType::Track);
+        EXPECT_EQ(queue.Drain(&records), 0);
+    }
+
+    TEST(EventQueueTest, ConcurrentProducers)
+    {
+        constexpr int kProducers = 4;
+        constexpr int kEvents = 20000;
+        EventQueue queue;
+        std::atomic<int> notified { 0 };
+        std::vector<std::thread> producers;
+        for (int i = 0; i < kProducers; i++)
+        {
+            producers.emplace_back(
+                [&queue, &notified, i]()
+                {
+                    for (int j = 0; j < kEvents; j++)
+                    {
+                        if (queue.Push(MakeRecord(static_cast<EventType>(i), j), std::to_string(j)))
+                            notified++;
+                    }
+                });
+        }
+
+        // Events of each producer arrive in order, and none is lost.
+        std::vector<int32_t> next(kProducers, 0);
+        int received = 0;
+        while (received < kProducers * kEvents)
+        {
+            const EventRecord* records = nullptr;
+            int32_t count = queue.Drain(&records);
+            for (int32_t k = 0; k < count; k++)
+            {
+                int32_t producer = static_cast<int32_t>(records[k].type);
+                EXPECT_EQ(records[k].value, next[producer]);
+                EXPECT_EQ(std::to_string(records[k].value), records[k].data);
+                next[producer] = records[k].value + 1;
+            }
+            received += count;
+        }
+        for (auto& producer : producers)
+            producer.join();
+        const EventRecord* records = nullptr;
+        EXPECT_EQ(queue.Drain(&records), 0);
+        EXPECT_GE(notified.load(), 1);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,99 @@
+#include "pch.h"
+
+#include <thread>
+
+#include "HandleTable.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(HandleTableTest, AddAndGet)
+    {
+        HandleTable table;
+        int a = 0, b = 0;
+        HandleTable::Handle ha = table.Add(&a);
+        HandleTable::Handle hb = table.Add(&b);
+        EXPECT_NE(ha, HandleTable::kInvalidHandle);
+        EXPECT_NE(ha, hb);
+        EXPECT_EQ(table.Get(ha), &a);
+        EXPECT_EQ(table.Get(hb), &b);
+        EXPECT_TRUE(table.Contains(ha, &a));
+        EXPECT_FALSE(table.Contains(ha, &b));
+        EXPECT_EQ(table.size(), 2u);
+    }
+
+    TEST(HandleTableTest, InvalidHandles)
+    {
+        HandleTable table;
+        int a = 0;
+        EXPECT_EQ(table.Add(nullptr), HandleTable::kInvalidHandle);
+        EXPECT_EQ(table.Get(HandleTable::kInvalidHandle), nullptr);
+        EXPECT_FALSE(table.Contains(HandleTable::kInvalidHandle, nullptr));
+        // Index which has never been allocated.
+        EXPECT_EQ(table.Get(static_cast<HandleTable::Handle>(1) << 32 | 12345), nullptr);
+        EXPECT_EQ(table.Get(~static_cast<HandleTable::Handle>(0)), nullptr);
+        EXPECT_FALSE(table.Remove(static_cast<HandleTable::Handle>(1) << 32 | 12345));
+        table.Add(&a);
+        EXPECT_EQ(table.size(), 1u);
+    }
+
+    TEST(HandleTableTest, StaleHandleAfterReuse)
+    {
+        HandleTable table;
+        int a = 0, b = 0;
+        HandleTable::Handle ha = table.Add(&a);
+        EXPECT_TRUE(table.Remove(ha));
+        EXPECT_FALSE(table.Remove(ha));
+        EXPECT_EQ(table.Get(ha), nullptr);
+
+        // The slot is reused with a new generation.
+        HandleTable::Handle hb = table.Add(&b);
+        EXPECT_EQ(HandleTable::IndexOf(ha), HandleTable::IndexOf(hb));
+        EXPECT_NE(HandleTable::GenerationOf(ha), HandleTable::GenerationOf(hb));
+        EXPECT_EQ(table.Get(ha), nullptr);
+        EXPECT_EQ(table.Get(hb), &b);
+        EXPECT_EQ(table.size(), 1u);
+    }
+
+    TEST(HandleTableTest, GrowsAcrossChunks)
+    {
+        HandleTable table;
+        std::vector<int> values(5000);
+        std::vector<HandleTable::Handle> handles;
+        for (auto& value : values)
+            handles.push_back(table.Add(&value));
+        for (size_t i = 0; i < values.size(); i++)
+            EXPECT_EQ(table.Get(handles[i]), &values[i]);
+        EXPECT_EQ(table.size(), values.size());
+    }
+
+    TEST(HandleTableTest, ConcurrentGet)
+    {
+        HandleTable table;
+        int a = 0, b = 0;
+        HandleTable::Handle ha = table.Add(&a);
+        std::atomic<bool> done { false };
+
+        // The handle of `a` never resolves to another object while the slots
+        // are removed and reused on another thread.
+        std::thread reader([&]() {
+            while (!done.load())
+            {
+                const void* ptr = table.Get(ha);
+                EXPECT_TRUE(ptr == nullptr || ptr == &a);
+            }
+        });
+        table.Remove(ha);
+        for (int i = 0; i < 100000; i++)
+        {
+            HandleTable::Handle hb = table.Add(&b);
+            table.Remove(hb);
+        }
+        done.store(true);
+        reader.join();
+        EXPECT_EQ(table.size(), 0u);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,62 @@
+#include "pch.h"
+
+#include "MarshalArena.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(MarshalArenaTest, CopyString)
+    {
+        MarshalArena arena;
+        char* str = arena.CopyString("audio");
+        EXPECT_STREQ(str, "audio");
+        char* empty = arena.CopyString("");
+        EXPECT_STREQ(empty, "");
+        EXPECT_EQ(arena.bytesAllocated(), 7u);
+        EXPECT_EQ(arena.blockCount(), 1u);
+    }
+
+    TEST(MarshalArenaTest, AllocateAligned)
+    {
+        MarshalArena arena;
+        arena.CopyString("a");
+        uint64_t* values = arena.AllocateArray<uint64_t>(4);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(values) % alignof(uint64_t), 0u);
+        for (size_t i = 0; i < 4; i++)
+            values[i] = i;
+        EXPECT_EQ(values[3], 3u);
+    }
+
+    TEST(MarshalArenaTest, LargeAllocation)
+    {
+        MarshalArena arena(64);
+        arena.CopyString("mid");
+        std::string str(1000, 'x');
+        char* large = arena.CopyString(str);
+        EXPECT_EQ(std::string(large), str);
+        EXPECT_EQ(arena.blockCount(), 2u);
+        EXPECT_GE(arena.capacity(), 1064u);
+    }
+
+    TEST(MarshalArenaTest, ResetReusesMemory)
+    {
+        MarshalArena arena(64);
+        for (int i = 0; i < 10; i++)
+            arena.CopyString("0123456789abcdef");
+        EXPECT_GT(arena.blockCount(), 1u);
+        const size_t capacity = arena.capacity();
+
+        arena.Reset();
+        EXPECT_EQ(arena.bytesAllocated(), 0u);
+        EXPECT_EQ(arena.blockCount(), 1u);
+        EXPECT_EQ(arena.capacity(), capacity);
+
+        // The same amount of values fit without allocating a block.
+        for (int i = 0; i < 10; i++)
+            arena.CopyString("0123456789abcdef");
+        EXPECT_EQ(arena.blockCount(), 1u);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
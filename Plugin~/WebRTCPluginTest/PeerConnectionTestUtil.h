@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <rtc_base/event.h>
+
+#include "Context.h"
+#include "CreateSessionDescriptionObserver.h"
+#include "SetLocalDescriptionObserver.h"
+#include "SetRemoteDescriptionObserver.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Signaling helpers shared by the tests and the benchmarks which connect
+    // peer connections of a context to each other.
+    //
+    // The observers report to static callbacks, so the helpers wait for one
+    // signaling step at a time and are not thread safe.
+    class SignalingCallbacks
+    {
+    public:
+        static void Register()
+        {
+            CreateSessionDescriptionObserver::RegisterCallback(&OnSessionDescriptionCreated);
+            SetLocalDescriptionObserver::RegisterCallback(&OnLocalDescriptionSet);
+            SetRemoteDescriptionObserver::RegisterCallback(&OnRemoteDescriptionSet);
+        }
+
+        static void Unregister()
+        {
+            CreateSessionDescriptionObserver::RegisterCallback(nullptr);
+            SetLocalDescriptionObserver::RegisterCallback(nullptr);
+            SetRemoteDescriptionObserver::RegisterCallback(nullptr);
+        }
+
+        // Returns false when the step fails or does not complete in time.
+        static bool Wait() { return s_done.Wait(TimeDelta::Seconds(10)) && s_error == RTCErrorType::NONE; }
+
+        // The description created by the last step.
+        static const std::string& createdSdp() { return s_createdSdp; }
+
+    private:
+        static void OnSessionDescriptionCreated(
+            PeerConnectionObject*, CreateSessionDescriptionObserver*, RTCSdpType, const char* sdp, RTCErrorType error, const char*)
+        {
+            s_createdSdp = sdp ? sdp : "";
+            s_error = error;
+            s_done.Set();
+        }
+
+        static void OnLocalDescriptionSet(PeerConnectionObject*, SetLocalDescriptionObserver*, RTCErrorType error, const char*)
+        {
+            s_error = error;
+            s_done.Set();
+        }
+
+        static void OnRemoteDescriptionSet(PeerConnectionObject*, SetRemoteDescriptionObserver*, RTCErrorType error, const char*)
+        {
+            s_error = error;
+            s_done.Set();
+        }
+
+        inline static rtc::Event s_done;
+        inline static RTCErrorType s_error = RTCErrorType::NONE;
+        inline static std::string s_createdSdp;
+    };
+
+    // Runs an offer and answer exchange in the same order as the managed code.
+    // Requires `SignalingCallbacks::Register`.
+    inline bool Negotiate(PeerConnectionObject* offerer, PeerConnectionObject* answerer)
+    {
+        const RTCOfferAnswerOptions options = { false, true };
+        std::string error;
+
+        auto createOffer = CreateSessionDescriptionObserver::Create(offerer);
+        offerer->CreateOffer(options, createOffer.get());
+        if (!SignalingCallbacks::Wait())
+            return false;
+        std::string offer = SignalingCallbacks::createdSdp();
+        RTCSessionDescription desc = { RTCSdpType::Offer, offer.data() };
+        offerer->SetLocalDescription(desc, SetLocalDescriptionObserver::Create(offerer), error);
+        if (!SignalingCallbacks::Wait())
+            return false;
+        answerer->SetRemoteDescription(desc, SetRemoteDescriptionObserver::Create(answerer), error);
+        if (!SignalingCallbacks::Wait())
+            return false;
+
+        auto createAnswer = CreateSessionDescriptionObserver::Create(answerer);
+        answerer->CreateAnswer(options, createAnswer.get());
+        if (!SignalingCallbacks::Wait())
+            return false;
+        std::string answer = SignalingCallbacks::createdSdp();
+        desc = { RTCSdpType::Answer, answer.data() };
+        answerer->SetLocalDescription(desc, SetLocalDescriptionObserver::Create(answerer), error);
+        if (!SignalingCallbacks::Wait())
+            return false;
+        offerer->SetRemoteDescription(desc, SetRemoteDescriptionObserver::Create(offerer), error);
+        return SignalingCallbacks::Wait();
+    }
+
+    // Exchanges the candidates of a pair which has negotiated until both are
+    // connected. The other events of the context are drained and dropped.
+    inline bool WaitForConnected(Context* context, PeerConnectionObject* a, PeerConnectionObject* b)
+    {
+        for (int i = 0; i < 10000; i++)
+        {
+            const EventRecord* records = nullptr;
+            int32_t count = context->DrainEvents(&records);
+            for (int32_t j = 0; j < count; j++)
+            {
+                if (records[j].type != EventType::IceCandidate)
+                    continue;
+                PeerConnectionObject* remote = records[j].sender == a ? b : a;
+                SdpParseError error;
+                std::unique_ptr<IceCandidateInterface> candidate(
+                    CreateIceCandidate(records[j].text, records[j].value, records[j].data, &error));
+                if (!candidate || !remote->connection->AddIceCandidate(candidate.get()))
+                    return false;
+            }
+            if (a->connection->peer_connection_state() == PeerConnectionInterface::PeerConnectionState::kConnected &&
+                b->connection->peer_connection_state() == PeerConnectionInterface::PeerConnectionState::kConnected)
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include <random>
+
+#include "SdpFmtp.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        // The implementation which the helpers replaced, used as the reference
+        // for lines where every pair has a key and '='.
+        std::vector<std::string> LegacySplit(const std::string& str, const std::string& delimiter)
+        {
+            std::vector<std::string> dst;
+            std::string s = str;
+            if (str.empty())
+                return dst;
+            while (true)
+            {
+                size_t pos = s.find(delimiter);
+                dst.push_back(s.substr(0, pos));
+                if (pos == std::string::npos)
+                    break;
+                s.erase(0, pos + delimiter.length());
+            }
+            return dst;
+        }
+
+        SdpFmtpParameters LegacyParse(const std::string& src)
+        {
+            SdpFmtpParameters map;
+            for (const auto& str : LegacySplit(src, ";"))
+            {
+                std::vector<std::string> pair = LegacySplit(str, "=");
+                map.emplace(pair[0], pair[1]);
+            }
+            return map;
+        }
+
+        std::string LegacySerialize(const SdpFmtpParameters& map)
+        {
+            std::string str = "";
+            for (const auto& pair : map)
+            {
+                if (!str.empty())
+                    str += ";";
+                str += pair.first + "=" + pair.second;
+            }
+            return str;
+        }
+
+        std::string RandomString(std::mt19937& random, const std::string& alphabet, size_t maxLength)
+        {
+            std::uniform_int_distribution<size_t> length(0, maxLength);
+            std::uniform_int_distribution<size_t> index(0, alphabet.size() - 1);
+            std::string str(length(random), ' ');
+            for (auto& c : str)
+                c = alphabet[index(random)];
+            return str;
+        }
+
+        SdpFmtpParameters RandomParameters(std::mt19937& random)
+        {
+            SdpFmtpParameters parameters;
+            std::uniform_int_distribution<int> count(0, 8);
+            for (int i = count(random); i > 0; i--)
+            {
+                std::string key = RandomString(random, "abcdefghijklmnopqrstuvwxyz-", 16);
+                if (key.empty())
+                    key = "x";
+                parameters.emplace(key, RandomString(random, "0123456789abcdef-,", 24));
+            }
+            return parameters;
+        }
+    } // namespace
+
+    TEST(SdpFmtpTest, Parse)
+    {
+        SdpFmtpParameters parameters;
+        ParseSdpFmtp("level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f", &parameters);
+        ASSERT_EQ(parameters.size(), 3u);
+        EXPECT_EQ(parameters["level-asymmetry-allowed"], "1");
+        EXPECT_EQ(parameters["packetization-mode"], "1");
+        EXPECT_EQ(parameters["profile-level-id"], "42e01f");
+    }
+
+    TEST(SdpFmtpTest, ParseMalformed)
+    {
+        SdpFmtpParameters parameters;
+        ParseSdpFmtp(";;apt=96;;stereo;a=b=c;apt=97;", &parameters);
+        ASSERT_EQ(parameters.size(), 3u);
+        EXPECT_EQ(parameters["apt"], "96");
+        EXPECT_EQ(parameters["stereo"], "");
+        EXPECT_EQ(parameters["a"], "b");
+    }
+
+    TEST(SdpFmtpTest, Serialize)
+    {
+        EXPECT_EQ(SerializeSdpFmtp({}), "");
+        EXPECT_EQ(SerializeSdpFmtp({ { "minptime", "10" }, { "useinbandfec", "1" } }), "minptime=10;useinbandfec=1");
+
+        SdpFmtpParameters parameters = { { "apt", "96" } };
+        std::vector<char> buffer(SdpFmtpLength(parameters) + 1, 'x');
+        char* end = WriteSdpFmtp(parameters, buffer.data());
+        EXPECT_EQ(end, buffer.data() + buffer.size() - 1);
+        EXPECT_STREQ(buffer.data(), "apt=96");
+    }
+
+    TEST(SdpFmtpTest, RoundTripMatchesLegacy)
+    {
+        std::mt19937 random(20231019);
+        for (int i = 0; i < 10000; i++)
+        {
+            const SdpFmtpParameters parameters = RandomParameters(random);
+            const std::string line = SerializeSdpFmtp(parameters);
+            ASSERT_EQ(line, LegacySerialize(parameters));
+            ASSERT_EQ(line.size(), SdpFmtpLength(parameters));
+
+            SdpFmtpParameters parsed;
+            ParseSdpFmtp(line, &parsed);
+            ASSERT_EQ(parsed, parameters);
+            ASSERT_EQ(parsed, LegacyParse(line));
+        }
+    }
+
+    TEST(SdpFmtpTest, FuzzParse)
+    {
+        std::mt19937 random(42);
+        for (int i = 0; i < 10000; i++)
+        {
+            const std::string line = RandomString(random, "ab1;=", 32);
+            SdpFmtpParameters parsed;
+            ParseSdpFmtp(line, &parsed);
+
+            // The legacy implementation is defined only when each pair has '='.
+            bool wellFormed = true;
+            for (const auto& pair : LegacySplit(line, ";"))
+                wellFormed &= pair.find('=') != std::string::npos;
+            if (wellFormed && !line.empty())
+                ASSERT_EQ(parsed, LegacyParse(line)) << line;
+
+            // Serializing the parsed parameters is stable.
+            SdpFmtpParameters reparsed;
+            ParseSdpFmtp(SerializeSdpFmtp(parsed), &reparsed);
+            ASSERT_EQ(reparsed, parsed) << line;
+        }
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,85 @@
+#include "pch.h"
+
+#include "SessionDescriptionCache.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    static const char kSdp[] = "v=0\r\n"
+                               "o=- 0 2 IN IP4 127.0.0.1\r\n"
+                               "s=-\r\n"
+                               "t=0 0\r\n"
+                               "a=group:BUNDLE 0\r\n"
+                               "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+                               "c=IN IP4 0.0.0.0\r\n"
+                               "a=ice-ufrag:abcd\r\n"
+                               "a=ice-pwd:abcdefghijklmnopqrstuvwx\r\n"
+                               "a=setup:actpass\r\n"
+                               "a=mid:0\r\n"
+                               "a=sctp-port:5000\r\n";
+
+    static std::unique_ptr<SessionDescriptionInterface> CreateDescription()
+    {
+        auto description = CreateSessionDescription(SdpType::kOffer, kSdp);
+        EXPECT_NE(description, nullptr);
+        return description;
+    }
+
+    TEST(SessionDescriptionCacheTest, SerializesOnce)
+    {
+        SessionDescriptionCache cache;
+        auto description = CreateDescription();
+        const auto entry = cache.Get(RTCSessionDescriptionSource::Local, description.get());
+        ASSERT_NE(entry, nullptr);
+        EXPECT_NE(entry->handle, SessionDescriptionCache::kInvalidHandle);
+        EXPECT_EQ(entry->type, SdpType::kOffer);
+        EXPECT_EQ(cache.Get(RTCSessionDescriptionSource::Local, description.get()), entry);
+        EXPECT_EQ(cache.serializeCount(), 1u);
+
+        // Each source has its own entry.
+        const auto current = cache.Get(RTCSessionDescriptionSource::CurrentLocal, description.get());
+        EXPECT_NE(current, entry);
+        EXPECT_EQ(cache.serializeCount(), 2u);
+
+        EXPECT_EQ(cache.Get(RTCSessionDescriptionSource::Local, nullptr), nullptr);
+        EXPECT_NE(cache.Get(RTCSessionDescriptionSource::Local, description.get()), entry);
+    }
+
+    TEST(SessionDescriptionCacheTest, KeepsHandleOfSameString)
+    {
+        SessionDescriptionCache cache;
+        auto description = CreateDescription();
+        const auto entry = cache.Get(RTCSessionDescriptionSource::Remote, description.get());
+
+        // A replaced description is serialized again, but keeps the handle.
+        auto replaced = CreateDescription();
+        const auto replacedEntry = cache.Get(RTCSessionDescriptionSource::Remote, replaced.get());
+        EXPECT_EQ(cache.serializeCount(), 2u);
+        EXPECT_EQ(replacedEntry->handle, entry->handle);
+
+        cache.Invalidate();
+        EXPECT_EQ(cache.Get(RTCSessionDescriptionSource::Remote, replaced.get())->handle, entry->handle);
+        EXPECT_EQ(cache.serializeCount(), 3u);
+    }
+
+    TEST(SessionDescriptionCacheTest, InvalidateAfterModification)
+    {
+        SessionDescriptionCache cache;
+        auto description = CreateDescription();
+        const auto entry = cache.Get(RTCSessionDescriptionSource::Local, description.get());
+
+        SdpParseError error;
+        std::unique_ptr<IceCandidateInterface> candidate(
+            CreateIceCandidate("0", 0, "candidate:1 1 udp 2122260223 192.168.0.1 50000 typ host", &error));
+        ASSERT_NE(candidate, nullptr);
+        ASSERT_TRUE(description->AddCandidate(candidate.get()));
+        cache.Invalidate();
+
+        const auto modified = cache.Get(RTCSessionDescriptionSource::Local, description.get());
+        EXPECT_NE(modified->handle, entry->handle);
+        EXPECT_NE(modified->sdp.find("192.168.0.1"), std::string::npos);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,109 @@
+#include "pch.h"
+
+#include <api/stats/rtcstats_objects.h>
+
+#include "StatsReportRegistry.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class StatsReportRegistryTest : public testing::Test
+    {
+    protected:
+        StatsReportRegistryTest()
+            : clock_(Timestamp::Seconds(1000))
+            , registry_(&clock_)
+        {
+        }
+
+        rtc::scoped_refptr<RTCStatsReport> CreateReport()
+        {
+            auto report = RTCStatsReport::Create(clock_.CurrentTime());
+            auto codec = std::make_unique<RTCCodecStats>("codec", clock_.CurrentTime());
+            codec->mime_type = "video/VP8";
+            report->AddStats(std::move(codec));
+            return report;
+        }
+
+        SimulatedClock clock_;
+        StatsReportRegistry registry_;
+    };
+
+    TEST_F(StatsReportRegistryTest, AddAndRemove)
+    {
+        auto report = CreateReport();
+        registry_.Add(report);
+        EXPECT_EQ(1u, registry_.size());
+        ASSERT_NE(nullptr, registry_.Find(report.get()));
+        EXPECT_EQ(report, registry_.Find(report.get())->report);
+        EXPECT_GT(registry_.memoryUsage(), 0u);
+
+        EXPECT_TRUE(registry_.Remove(report.get()));
+        EXPECT_FALSE(registry_.Remove(report.get()));
+        EXPECT_EQ(nullptr, registry_.Find(report.get()));
+        EXPECT_EQ(0u, registry_.memoryUsage());
+    }
+
+    TEST_F(StatsReportRegistryTest, CountSnapshotMemory)
+    {
+        auto report = CreateReport();
+        registry_.Add(report);
+        const size_t size = registry_.memoryUsage();
+
+        registry_.Find(report.get())->snapshot.resize(1024);
+        EXPECT_GE(registry_.memoryUsage(), size + 1024);
+    }
+
+    TEST_F(StatsReportRegistryTest, ReleaseExpiredReports)
+    {
+        registry_.SetTimeToLive(TimeDelta::Seconds(10));
+        auto abandoned = CreateReport();
+        auto accessed = CreateReport();
+        registry_.Add(abandoned);
+        registry_.Add(accessed);
+
+        clock_.AdvanceTime(TimeDelta::Seconds(6));
+        registry_.Find(accessed.get());
+        clock_.AdvanceTime(TimeDelta::Seconds(6));
+        registry_.Add(CreateReport());
+
+        EXPECT_EQ(nullptr, registry_.Find(abandoned.get()));
+        EXPECT_NE(nullptr, registry_.Find(accessed.get()));
+        EXPECT_EQ(2u, registry_.size());
+        EXPECT_EQ(1u, registry_.expiredCount());
+    }
+
+    TEST_F(StatsReportRegistryTest, ReadMemberAfterDefaultTimeToLive)
+    {
+        EXPECT_TRUE(registry_.timeToLive().IsPlusInfinity());
+
+        // The managed code holds the member without the report, and reading it
+        // does not access the registry.
+        auto report = CreateReport();
+        registry_.Add(report);
+        const RTCStatsMemberInterface* member = &report->Get("codec")->cast_to<RTCCodecStats>().mime_type;
+        report = nullptr;
+
+        clock_.AdvanceTime(TimeDelta::Minutes(10));
+        registry_.Add(CreateReport());
+        EXPECT_EQ(2u, registry_.size());
+        EXPECT_EQ(0u, registry_.expiredCount());
+        ASSERT_TRUE(member->is_defined());
+        EXPECT_EQ("video/VP8", member->ValueToString());
+    }
+
+    TEST_F(StatsReportRegistryTest, KeepReportsWithInfiniteTimeToLive)
+    {
+        registry_.SetTimeToLive(TimeDelta::PlusInfinity());
+        auto report = CreateReport();
+        registry_.Add(report);
+
+        clock_.AdvanceTime(TimeDelta::Seconds(3600));
+        registry_.Add(CreateReport());
+        EXPECT_NE(nullptr, registry_.Find(report.get()));
+        EXPECT_EQ(0u, registry_.expiredCount());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include <api/stats/rtcstats_objects.h>
+#include <cstring>
+
+#include "StatsSnapshot.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class StatsSnapshotTest : public testing::Test
+    {
+    protected:
+        template<typename T>
+        T Read(size_t offset) const
+        {
+            T value;
+            std::memcpy(&value, snapshot_.data() + offset, sizeof(T));
+            return value;
+        }
+
+        StatsSnapshotHeader header() const { return Read<StatsSnapshotHeader>(0); }
+
+        StatsSnapshotStats stats(uint32_t i) const
+        {
+            return Read<StatsSnapshotStats>(header().statsOffset + sizeof(StatsSnapshotStats) * i);
+        }
+
+        StatsSnapshotMember member(const StatsSnapshotStats& stats, const std::string& name) const
+        {
+            for (uint32_t i = 0; i < stats.memberCount; i++)
+            {
+                auto entry = Read<StatsSnapshotMember>(
+                    header().membersOffset + sizeof(StatsSnapshotMember) * (stats.firstMember + i));
+                if (string(entry.name) == name)
+                    return entry;
+            }
+            ADD_FAILURE() << "The member is not found: " << name;
+            return {};
+        }
+
+        std::string string(uint32_t i) const
+        {
+            auto entry = Read<StatsSnapshotString>(header().stringsOffset + sizeof(StatsSnapshotString) * i);
+            return std::string(
+                reinterpret_cast<const char*>(snapshot_.data() + header().charsOffset + entry.offset), entry.length);
+        }
+
+        uint64_t value(uint64_t i) const { return Read<uint64_t>(header().valuesOffset + sizeof(uint64_t) * i); }
+
+        StatsSnapshotWriter writer_;
+        std::vector<uint8_t> snapshot_;
+    };
+
+    TEST_F(StatsSnapshotTest, EmptyReport)
+    {
+        auto report = RTCStatsReport::Create(Timestamp::Micros(0));
+        writer_.Write(*report, &snapshot_);
+
+        ASSERT_GE(snapshot_.size(), sizeof(StatsSnapshotHeader));
+        EXPECT_EQ(kStatsSnapshotMagic, header().magic);
+        EXPECT_EQ(kStatsSnapshotVersion, header().version);
+        EXPECT_EQ(snapshot_.size(), header().size);
+        EXPECT_EQ(0u, header().statsCount);
+    }
+
+    TEST_F(StatsSnapshotTest, WriteMembers)
+    {
+        auto report = RTCStatsReport::Create(Timestamp::Micros(0));
+        auto codec = std::make_unique<RTCCodecStats>("codec", Timestamp::Micros(1234));
+        codec->payload_type = 111;
+        codec->mime_type = "audio/opus";
+        report->AddStats(std::move(codec));
+        auto outbound = std::make_unique<RTCOutboundRtpStreamStats>("outbound", Timestamp::Micros(5678));
+        outbound->mid = "0";
+        outbound->total_encode_time = 1.5;
+        outbound->quality_limitation_durations = std::map<std::string, double> { { "cpu", 0.25 }, { "none", 2.0 } };
+        report->AddStats(std::move(outbound));
+        writer_.Write(*report, &snapshot_);
+
+        ASSERT_EQ(2u, header().statsCount);
+        EXPECT_EQ(0u, header().valuesOffset % 8);
+
+        const StatsSnapshotStats codecStats = stats(0);
+        EXPECT_EQ("codec", string(codecStats.id));
+        EXPECT_EQ(0u, codecStats.type);
+        EXPECT_EQ(1234, codecStats.timestampUs);
+        EXPECT_EQ(111u, member(codecStats, "payloadType").value);
+        EXPECT_EQ("audio/opus", string(static_cast<uint32_t>(member(codecStats, "mimeType").value)));
+        EXPECT_FALSE(member(codecStats, "clockRate").defined);
+
+        const StatsSnapshotStats outboundStats = stats(1);
+        EXPECT_EQ(2u, outboundStats.type);
+        const StatsSnapshotMember encodeTime = member(outboundStats, "totalEncodeTime");
+        EXPECT_EQ(RTCStatsMemberInterface::kDouble, encodeTime.type);
+        double seconds;
+        std::memcpy(&seconds, &encodeTime.value, sizeof(seconds));
+        EXPECT_EQ(1.5, seconds);
+
+        const StatsSnapshotMember durations = member(outboundStats, "qualityLimitationDurations");
+        ASSERT_EQ(2u, durations.count);
+        EXPECT_EQ("cpu", string(static_cast<uint32_t>(value(durations.value))));
+        uint64_t bits = value(durations.value + 1);
+        std::memcpy(&seconds, &bits, sizeof(seconds));
+        EXPECT_EQ(0.25, seconds);
+    }
+
+    TEST_F(StatsSnapshotTest, ShareStrings)
+    {
+        auto report = RTCStatsReport::Create(Timestamp::Micros(0));
+        for (const char* id : { "codec1", "codec2" })
+        {
+            auto codec = std::make_unique<RTCCodecStats>(id, Timestamp::Micros(0));
+            codec->mime_type = "video/VP8";
+            report->AddStats(std::move(codec));
+        }
+        writer_.Write(*report, &snapshot_);
+
+        ASSERT_EQ(2u, header().statsCount);
+        EXPECT_EQ(member(stats(0), "mimeType").value, member(stats(1), "mimeType").value);
+        EXPECT_EQ(member(stats(0), "mimeType").name, member(stats(1), "mimeType").name);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
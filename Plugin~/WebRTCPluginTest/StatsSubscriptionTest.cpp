@@ -0,0 +1,150 @@
+#include "pch.h"
+
+#include <api/stats/rtcstats_objects.h>
+
+#include "StatsSubscription.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        constexpr uint32_t kOutboundRtp = 2;
+        constexpr uint32_t kRemoteInboundRtp = 3;
+
+        rtc::scoped_refptr<RTCStatsReport> CreateReport(
+            int64_t timestampUs, uint64_t bytesSent, double roundTripTime, uint32_t frameWidth = 640)
+        {
+            auto report = RTCStatsReport::Create(Timestamp::Micros(timestampUs));
+            auto outbound = std::make_unique<RTCOutboundRtpStreamStats>("outbound", Timestamp::Micros(timestampUs));
+            outbound->bytes_sent = bytesSent;
+            outbound->frames_encoded = 30;
+            outbound->frame_width = frameWidth;
+            report->AddStats(std::move(outbound));
+            auto remote =
+                std::make_unique<RTCRemoteInboundRtpStreamStats>("remote", Timestamp::Micros(timestampUs));
+            remote->round_trip_time = roundTripTime;
+            report->AddStats(std::move(remote));
+            auto codec = std::make_unique<RTCCodecStats>("codec", Timestamp::Micros(timestampUs));
+            codec->payload_type = 96;
+            report->AddStats(std::move(codec));
+            return report;
+        }
+    }
+
+    TEST(StatsSubscriptionTest, FilterMembers)
+    {
+        auto subscription = StatsSubscription::Create(
+            { kOutboundRtp, kRemoteInboundRtp }, { "bytesSent", "roundTripTime", "payloadType" });
+        subscription->Update(*CreateReport(1000000, 100, 0.05));
+
+        const StatsDelta* deltas = nullptr;
+        ASSERT_EQ(2, subscription->Poll(&deltas));
+        EXPECT_STREQ("outbound", deltas[0].id);
+        EXPECT_EQ(kOutboundRtp, deltas[0].type);
+        EXPECT_EQ(0u, deltas[0].member);
+        EXPECT_EQ(100.0, deltas[0].value);
+        EXPECT_FALSE(deltas[0].hasRate);
+        EXPECT_STREQ("remote", deltas[1].id);
+        EXPECT_EQ(1u, deltas[1].member);
+        EXPECT_EQ(0.05, deltas[1].value);
+
+        EXPECT_EQ(0, subscription->Poll(&deltas));
+    }
+
+    TEST(StatsSubscriptionTest, QueueChangedValues)
+    {
+        auto subscription = StatsSubscription::Create({}, { "bytesSent", "framesEncoded", "roundTripTime" });
+        subscription->Update(*CreateReport(1000000, 100, 0.05));
+        const StatsDelta* deltas = nullptr;
+        ASSERT_EQ(3, subscription->Poll(&deltas));
+        const uint32_t key = deltas[0].key;
+
+        // bytesSent changes by 500 bytes in 250 ms, and framesEncoded stops.
+        subscription->Update(*CreateReport(1250000, 600, 0.05));
+        ASSERT_EQ(2, subscription->Poll(&deltas));
+        EXPECT_EQ(key, deltas[0].key);
+        EXPECT_EQ(600.0, deltas[0].value);
+        EXPECT_TRUE(deltas[0].hasRate);
+        EXPECT_DOUBLE_EQ(2000.0, deltas[0].rate);
+        EXPECT_EQ(1u, deltas[1].member);
+        EXPECT_EQ(30.0, deltas[1].value);
+        EXPECT_TRUE(deltas[1].hasRate);
+        EXPECT_EQ(0.0, deltas[1].rate);
+
+        // The counters which stay at the rate of zero are not queued again.
+        subscription->Update(*CreateReport(1500000, 600, 0.05));
+        ASSERT_EQ(1, subscription->Poll(&deltas));
+        EXPECT_EQ(0u, deltas[0].member);
+        EXPECT_EQ(0.0, deltas[0].rate);
+        subscription->Update(*CreateReport(1750000, 600, 0.05));
+        EXPECT_EQ(0, subscription->Poll(&deltas));
+    }
+
+    TEST(StatsSubscriptionTest, RateOfSignedCounter)
+    {
+        auto subscription = StatsSubscription::Create({}, { "packetsLost" });
+        auto report = [](int64_t timestampUs, int32_t packetsLost)
+        {
+            auto report = RTCStatsReport::Create(Timestamp::Micros(timestampUs));
+            auto inbound = std::make_unique<RTCInboundRtpStreamStats>("inbound", Timestamp::Micros(timestampUs));
+            inbound->packets_lost = packetsLost;
+            report->AddStats(std::move(inbound));
+            return report;
+        };
+        subscription->Update(*report(1000000, 2));
+        subscription->Update(*report(2000000, 5));
+
+        const StatsDelta* deltas = nullptr;
+        ASSERT_EQ(2, subscription->Poll(&deltas));
+        EXPECT_TRUE(deltas[1].hasRate);
+        EXPECT_DOUBLE_EQ(3.0, deltas[1].rate);
+    }
+
+    TEST(StatsSubscriptionTest, NoRateForGauge)
+    {
+        auto subscription = StatsSubscription::Create({}, { "roundTripTime", "frameWidth" });
+        subscription->Update(*CreateReport(1000000, 100, 0.05, 640));
+        const StatsDelta* deltas = nullptr;
+        ASSERT_EQ(2, subscription->Poll(&deltas));
+
+        subscription->Update(*CreateReport(2000000, 100, 0.08, 1280));
+        ASSERT_EQ(2, subscription->Poll(&deltas));
+        for (int i = 0; i < 2; i++)
+            EXPECT_FALSE(deltas[i].hasRate);
+        // frameWidth is an integer, but not a counter.
+        EXPECT_EQ(1u, deltas[0].member);
+        EXPECT_EQ(1280.0, deltas[0].value);
+        EXPECT_EQ(0u, deltas[1].member);
+        EXPECT_EQ(0.08, deltas[1].value);
+    }
+
+    TEST(StatsSubscriptionTest, RemoveMissingStats)
+    {
+        auto subscription = StatsSubscription::Create({ kRemoteInboundRtp }, { "roundTripTime" });
+        subscription->Update(*CreateReport(1000000, 100, 0.05));
+        const StatsDelta* deltas = nullptr;
+        ASSERT_EQ(1, subscription->Poll(&deltas));
+        const uint32_t key = deltas[0].key;
+        const uint32_t* keys = nullptr;
+        EXPECT_EQ(0, subscription->RemovedKeys(&keys));
+
+        // The remote stats are missing from the report.
+        auto report = RTCStatsReport::Create(Timestamp::Micros(2000000));
+        report->AddStats(std::make_unique<RTCOutboundRtpStreamStats>("outbound", Timestamp::Micros(2000000)));
+        subscription->Update(*report);
+        EXPECT_EQ(0, subscription->Poll(&deltas));
+        ASSERT_EQ(1, subscription->RemovedKeys(&keys));
+        EXPECT_EQ(key, keys[0]);
+
+        // The stats reported again get a new key, and the same value is queued.
+        subscription->Update(*CreateReport(3000000, 100, 0.05));
+        ASSERT_EQ(1, subscription->Poll(&deltas));
+        EXPECT_NE(key, deltas[0].key);
+        EXPECT_STREQ("remote", deltas[0].id);
+        EXPECT_EQ(0, subscription->RemovedKeys(&keys));
+    }
+
+} // end namespace webrtc
+} // end namespace unity
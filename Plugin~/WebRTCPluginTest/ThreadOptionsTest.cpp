@@ -0,0 +1,27 @@
+#include "pch.h"
+
+#include <rtc_base/thread.h>
+
+#include "ThreadOptions.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(ThreadOptionsTest, DefaultOptionsDoNothing) { EXPECT_TRUE(ApplyThreadOptions(ThreadOptions())); }
+
+    TEST(ThreadOptionsTest, ApplyOnThread)
+    {
+        auto thread = rtc::Thread::Create();
+        thread->SetName("ThreadOptionsTest", nullptr);
+        thread->Start();
+
+        // Lowering the priority needs no permission on any platform.
+        ThreadOptions options;
+        options.priority = ThreadPriorityHint::kLow;
+        EXPECT_TRUE(thread->BlockingCall([&]() { return ApplyThreadOptions(options); }));
+        thread->Stop();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,92 @@
+#include "pch.h"
+
+#include <media/base/media_constants.h>
+
+#include "UnityAudioEncoderFactory.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(UnityAudioEncoderFactoryTest, SerializeOpusEncoderSettings)
+    {
+        OpusEncoderSettings settings;
+        settings.complexity = 5;
+        settings.ptimeMs = 40;
+        settings.dtx = true;
+        settings.fec = false;
+        settings.maxBitrateBps = 32000;
+
+        absl::optional<OpusEncoderSettings> parsed =
+            ParseOpusEncoderSettings(SerializeOpusEncoderSettings(settings));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_EQ(5, parsed->complexity);
+        EXPECT_EQ(40, parsed->ptimeMs);
+        EXPECT_EQ(true, parsed->dtx);
+        EXPECT_EQ(false, parsed->fec);
+        EXPECT_EQ(32000, parsed->maxBitrateBps);
+
+        parsed = ParseOpusEncoderSettings(SerializeOpusEncoderSettings(OpusEncoderSettings()));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_FALSE(parsed->complexity.has_value());
+        EXPECT_FALSE(parsed->maxBitrateBps.has_value());
+    }
+
+    TEST(UnityAudioEncoderFactoryTest, RejectInvalidOpusEncoderSettings)
+    {
+        OpusEncoderSettings settings;
+        settings.complexity = 11;
+        EXPECT_FALSE(ValidateOpusEncoderSettings(settings));
+        EXPECT_FALSE(ParseOpusEncoderSettings(SerializeOpusEncoderSettings(settings)).has_value());
+
+        settings = OpusEncoderSettings();
+        settings.ptimeMs = 30;
+        EXPECT_FALSE(ValidateOpusEncoderSettings(settings));
+
+        EXPECT_FALSE(ParseOpusEncoderSettings("").has_value());
+        EXPECT_FALSE(ParseOpusEncoderSettings("x-unity-opus;unknown=1").has_value());
+    }
+
+    TEST(UnityAudioEncoderFactoryTest, ApplyOpusEncoderSettings)
+    {
+        auto factory = CreateAudioEncoderFactory();
+        std::unique_ptr<AudioEncoder> encoder =
+            factory->MakeAudioEncoder(111, SdpAudioFormat(cricket::kOpusCodecName, 48000, 2), absl::nullopt);
+        ASSERT_NE(nullptr, encoder);
+        EXPECT_EQ(2u, encoder->Max10MsFramesInAPacket());
+        EXPECT_FALSE(encoder->GetDtx());
+
+        OpusEncoderSettings settings;
+        settings.complexity = 5;
+        settings.ptimeMs = 40;
+        settings.dtx = true;
+        settings.maxBitrateBps = 16000;
+        EXPECT_TRUE(encoder->EnableAudioNetworkAdaptor(SerializeOpusEncoderSettings(settings), nullptr));
+        EXPECT_EQ(4u, encoder->Max10MsFramesInAPacket());
+        EXPECT_TRUE(encoder->GetDtx());
+        EXPECT_LE(encoder->GetTargetBitrate(), 16000);
+
+        encoder->OnReceivedTargetAudioBitrate(64000);
+        EXPECT_LE(encoder->GetTargetBitrate(), 16000);
+
+        // The negotiated configuration is used again without the settings.
+        encoder->DisableAudioNetworkAdaptor();
+        EXPECT_EQ(2u, encoder->Max10MsFramesInAPacket());
+        EXPECT_FALSE(encoder->GetDtx());
+        encoder->OnReceivedTargetAudioBitrate(64000);
+        EXPECT_GT(encoder->GetTargetBitrate(), 16000);
+    }
+
+    TEST(UnityAudioEncoderFactoryTest, KeepEncoderWithInvalidSettings)
+    {
+        auto factory = CreateAudioEncoderFactory();
+        std::unique_ptr<AudioEncoder> encoder =
+            factory->MakeAudioEncoder(111, SdpAudioFormat(cricket::kOpusCodecName, 48000, 2), absl::nullopt);
+        ASSERT_NE(nullptr, encoder);
+
+        EXPECT_FALSE(encoder->EnableAudioNetworkAdaptor("x-unity-opus;complexity=11", nullptr));
+        EXPECT_EQ(2u, encoder->Max10MsFramesInAPacket());
+    }
+
+} // end namespace webrtc
+} // end namespace unity
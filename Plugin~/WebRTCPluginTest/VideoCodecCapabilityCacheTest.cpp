@@ -0,0 +1,107 @@
+#include "pch.h"
+
+#include "Codec/VideoCodecCapabilityCache.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    static std::vector<SdpVideoFormat> H264Formats()
+    {
+        return { SdpVideoFormat(
+                     "H264",
+                     { { "profile-level-id", "42e033" },
+                       { "level-asymmetry-allowed", "1" },
+                       { "packetization-mode", "1" } }),
+                 SdpVideoFormat("H264", { { "profile-level-id", "64e033" } }) };
+    }
+
+    TEST(VideoCodecCapabilityCacheTest, ProbesOnce)
+    {
+        VideoCodecCapabilityCache cache("1.0.0");
+        int count = 0;
+        auto probe = [&count]()
+        {
+            count++;
+            return H264Formats();
+        };
+        EXPECT_EQ(cache.GetOrProbe("device", false, probe), H264Formats());
+        EXPECT_EQ(cache.GetOrProbe("device", false, probe), H264Formats());
+        EXPECT_EQ(count, 1);
+        EXPECT_EQ(cache.probeCount(), 1u);
+
+        cache.GetOrProbe("other", false, probe);
+        EXPECT_EQ(count, 2);
+
+        cache.Clear();
+        cache.GetOrProbe("device", false, probe);
+        EXPECT_EQ(count, 3);
+    }
+
+    TEST(VideoCodecCapabilityCacheTest, ProbesAgainAfterEmptyResult)
+    {
+        VideoCodecCapabilityCache cache("1.0.0");
+        std::vector<SdpVideoFormat> result;
+        int count = 0;
+        auto probe = [&count, &result]()
+        {
+            count++;
+            return result;
+        };
+        EXPECT_TRUE(cache.GetOrProbe("device", true, probe).empty());
+        EXPECT_EQ(cache.Serialize(), "version\t1.0.0\n");
+
+        result = H264Formats();
+        EXPECT_EQ(cache.GetOrProbe("device", true, probe), H264Formats());
+        EXPECT_EQ(cache.GetOrProbe("device", true, probe), H264Formats());
+        EXPECT_EQ(count, 2);
+    }
+
+    TEST(VideoCodecCapabilityCacheTest, RestoresPersistentEntries)
+    {
+        VideoCodecCapabilityCache cache("1.0.0");
+        cache.GetOrProbe("device", true, []() { return H264Formats(); });
+        cache.GetOrProbe("unsupported", true, []() { return std::vector<SdpVideoFormat>(); });
+        cache.GetOrProbe("internal", false, []() { return std::vector<SdpVideoFormat> { SdpVideoFormat("VP8") }; });
+        const std::string data = cache.Serialize();
+
+        // Only the non-empty persistent entry is restored, others are probed.
+        VideoCodecCapabilityCache restored("1.0.0");
+        EXPECT_TRUE(restored.Deserialize(data));
+        int count = 0;
+        auto probe = [&count]()
+        {
+            count++;
+            return std::vector<SdpVideoFormat>();
+        };
+        EXPECT_EQ(restored.GetOrProbe("device", true, probe), H264Formats());
+        EXPECT_EQ(count, 0);
+        restored.GetOrProbe("unsupported", true, probe);
+        restored.GetOrProbe("internal", false, probe);
+        EXPECT_EQ(count, 2);
+    }
+
+    TEST(VideoCodecCapabilityCacheTest, IgnoresOtherVersion)
+    {
+        VideoCodecCapabilityCache cache("1.0.0");
+        cache.GetOrProbe("device", true, []() { return H264Formats(); });
+
+        VideoCodecCapabilityCache restored("1.0.1");
+        EXPECT_FALSE(restored.Deserialize(cache.Serialize()));
+        EXPECT_FALSE(restored.Deserialize(""));
+        EXPECT_FALSE(restored.Deserialize("version\t1.0.1\nunknown\n"));
+
+        int count = 0;
+        restored.GetOrProbe(
+            "device",
+            true,
+            [&count]()
+            {
+                count++;
+                return H264Formats();
+            });
+        EXPECT_EQ(count, 1);
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using Unity.Collections;
 using Unity.Collections.LowLevel.Unsafe;
@@ -25,6 +26,48 @@ namespace Unity.WebRTC
     /// <seealso cref="AudioStreamTrack.OnReceived"/>
     public delegate void AudioReadEventHandler(float[] data, int channels, int sampleRate);
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct AudioTrackSinkOptions
+    {
+        [MarshalAs(UnmanagedType.U1)]
+        public bool backgroundResample;
+        public int batchFrames;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct AudioTrackSinkCounters
+    {
+        public ulong bypassedSamples;
+        public ulong resampledSamples;
+        public ulong frameAllocations;
+        public ulong frameCopies;
+        public ulong pooledFrames;
+    }
+
+    /// <summary>
+    /// Represents the level of audio passing through an <see cref="AudioStreamTrack"/>.
+    /// </summary>
+    /// <seealso cref="AudioStreamTrack.GetAudioLevels"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct AudioLevel
+    {
+        /// <summary>
+        /// Root mean square level of the latest audio frame in dBFS, from -127 to 0.
+        /// </summary>
+        public float rmsDbfs;
+
+        /// <summary>
+        /// Peak level of the latest audio frame in dBFS, from -127 to 0.
+        /// </summary>
+        public float peakDbfs;
+
+        /// <summary>
+        /// Whether the track is estimated to contain voice.
+        /// </summary>
+        [MarshalAs(UnmanagedType.U1)]
+        public bool voiceActive;
+    }
+
     /// <summary>
     /// Provides extension methods for the <see cref="AudioSource"/> class to facilitate integration with <see cref="AudioStreamTrack"/>.
     /// </summary>
@@ -142,7 +185,11 @@ namespace Unity.WebRTC
             }
 
             public AudioStreamRenderer(AudioStreamTrack track)
-                : this(WebRTC.Context.CreateAudioTrackSink())
+                : this(WebRTC.Context.CreateAudioTrackSink(new AudioTrackSinkOptions
+                {
+                    backgroundResample = ResampleInBackground,
+                    batchFrames = ResampleBatchFrames
+                }))
             {
                 _track = track;
                 _track?.AddSink(this);
@@ -199,6 +246,35 @@ namespace Unity.WebRTC
             internal event AudioReadEventHandler onReceived;
         }
 
+        private static int s_resampleBatchFrames = 1;
+
+        /// <summary>
+        ///     Whether received audio is remixed and resampled on a background thread instead of the thread which decodes it.
+        /// </summary>
+        /// <remarks>
+        ///     Applies to the tracks received after it is set. Audio which arrives in the format of Unity's output
+        ///     is not resampled either way.
+        /// </remarks>
+        public static bool ResampleInBackground { get; set; }
+
+        /// <summary>
+        ///     Number of 10 ms frames passed to the background thread at once when <see cref="ResampleInBackground"/> is set.
+        /// </summary>
+        /// <remarks>
+        ///     Larger batches wake the background thread less often. Frames which wait for a full batch are
+        ///     processed when the track runs out of audio, so the end of the audio is still played.
+        /// </remarks>
+        public static int ResampleBatchFrames
+        {
+            get { return s_resampleBatchFrames; }
+            set
+            {
+                if (value < 1)
+                    throw new ArgumentOutOfRangeException(nameof(value), value, "The batch must have at least one frame.");
+                s_resampleBatchFrames = value;
+            }
+        }
+
         readonly AudioCustomFilter _audioCapturer;
         internal AudioStreamRenderer _streamRenderer;
         internal AudioTrackSource _trackSource;
@@ -272,11 +348,49 @@ namespace Unity.WebRTC
             : base(WebRTC.Context.CreateAudioTrack(label, source.self))
         {
             _trackSource = source;
+            _levelMeter = NativeMethods.AudioSourceGetLevelMeter(source.self);
         }
 
         internal AudioStreamTrack(IntPtr ptr) : base(ptr)
         {
             _streamRenderer = new AudioStreamRenderer(this);
+            _levelMeter = NativeMethods.AudioTrackSinkGetLevelMeter(_streamRenderer.self);
+        }
+
+        // Owned by the source or the sink of the track, and cleared when they are disposed.
+        private IntPtr _levelMeter;
+
+        private static IntPtr[] s_levelMeters = new IntPtr[0];
+
+        /// <summary>
+        /// Gets the audio levels of the tracks at once.
+        /// </summary>
+        /// <remarks>
+        ///     The levels are measured natively while audio passes through the tracks,
+        ///     so audio does not need to be read into managed code only to meter it.
+        /// </remarks>
+        /// <param name="tracks">Sender or receiver side tracks.</param>
+        /// <param name="levels">Array to receive the level of each track.</param>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         AudioLevel[] levels = new AudioLevel[tracks.Count];
+        ///         AudioStreamTrack.GetAudioLevels(tracks, levels);
+        ///     ]]></code>
+        /// </example>
+        public static void GetAudioLevels(IReadOnlyList<AudioStreamTrack> tracks, AudioLevel[] levels)
+        {
+            if (tracks == null)
+                throw new ArgumentNullException(nameof(tracks));
+            if (levels == null)
+                throw new ArgumentNullException(nameof(levels));
+            if (levels.Length < tracks.Count)
+                throw new ArgumentException("levels is shorter than tracks.", nameof(levels));
+
+            if (s_levelMeters.Length < tracks.Count)
+                s_levelMeters = new IntPtr[tracks.Count];
+            for (int i = 0; i < tracks.Count; i++)
+                s_levelMeters[i] = tracks[i]._levelMeter;
+            NativeMethods.AudioLevelMeterGetLevels(s_levelMeters, tracks.Count, levels);
         }
 
         internal void AddSink(AudioStreamRenderer renderer)
@@ -324,6 +438,7 @@ namespace Unity.WebRTC
                 _trackSource?.Dispose();
                 _trackSource = null;
             }
+            _levelMeter = IntPtr.Zero;
             base.Dispose();
         }
 
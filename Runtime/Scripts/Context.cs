@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using System.Threading;
 using UnityEngine;
@@ -135,6 +136,7 @@ namespace Unity.WebRTC
         private IntPtr batchUpdateFunction;
         private int batchUpdateEventID = -1;
         private IntPtr textureUpdateFunction;
+        private readonly object m_marshalLock = new object();
 
         internal Batch batch;
 
@@ -144,6 +146,25 @@ namespace Unity.WebRTC
             return new Context(ptr, id);
         }
 
+        public static Context Create(int id, ContextThreadOptions options)
+        {
+            var ptr = NativeMethods.ContextCreateWithThreadOptions(id, ref options);
+            return new Context(ptr, id);
+        }
+
+        internal static ContextAsyncOperation CreateAsync(int id, ContextThreadOptions options)
+        {
+            return new ContextAsyncOperation(NativeMethods.ContextCreateAsync(id, ref options, null));
+        }
+
+        internal static Context Create(int id, ContextAsyncOperation operation)
+        {
+            operation.Wait();
+            if (operation.IsError)
+                throw new InvalidOperationException(operation.Error.message);
+            return new Context(operation.context, id);
+        }
+
         public bool IsNull
         {
             get { return self == IntPtr.Zero; }
@@ -163,6 +184,18 @@ namespace Unity.WebRTC
         }
 
         public void Dispose()
+        {
+            Dispose(false);
+        }
+
+        // The native context is destroyed on a background thread. A context
+        // created with the same ID later is created after the destruction.
+        internal void DisposeAsync()
+        {
+            Dispose(true);
+        }
+
+        private void Dispose(bool destroyAsync)
         {
             if (this.disposed)
             {
@@ -182,7 +215,10 @@ namespace Unity.WebRTC
                 // Release buffers on the rendering thread
                 batch.Submit(true);
 
-                NativeMethods.ContextDestroy(id);
+                if (destroyAsync)
+                    NativeMethods.ContextAsyncOperationRelease(NativeMethods.ContextDestroyAsync(id, null));
+                else
+                    NativeMethods.ContextDestroy(id);
                 self = IntPtr.Zero;
             }
             this.disposed = true;
@@ -199,6 +235,11 @@ namespace Unity.WebRTC
             NativeMethods.ContextDeleteRefPtr(self, ptr);
         }
 
+        public ulong GetRefPtrHandle(IntPtr ptr)
+        {
+            return NativeMethods.ContextGetRefPtrHandle(self, ptr);
+        }
+
         public IntPtr CreateFrameTransformer()
         {
             return NativeMethods.ContextCreateFrameTransformer(self);
@@ -214,6 +255,35 @@ namespace Unity.WebRTC
             return NativeMethods.ContextCreatePeerConnectionWithConfig(self, conf);
         }
 
+        public IntPtr CreatePeerConnection(ref RTCConfigurationInternal configuration)
+        {
+            return NativeMethods.ContextCreatePeerConnectionWithRTCConfiguration(self, ref configuration);
+        }
+
+        public bool SetPeerConnectionPool(ref RTCConfigurationInternal configuration, int size)
+        {
+            return NativeMethods.ContextSetPeerConnectionPool(self, ref configuration, size);
+        }
+
+        public int GetPooledPeerConnectionCount()
+        {
+            return NativeMethods.ContextGetPooledPeerConnectionCount(self);
+        }
+
+        public ulong GetPooledPeerConnectionClaimCount()
+        {
+            return NativeMethods.ContextGetPooledPeerConnectionClaimCount(self);
+        }
+
+        public RTCConfiguration PeerConnectionGetConfiguration(IntPtr ptr)
+        {
+            lock (m_marshalLock)
+            {
+                NativeMethods.ContextPeerConnectionGetRTCConfiguration(self, ptr, out RTCConfigurationInternal configuration);
+                return new RTCConfiguration(ref configuration);
+            }
+        }
+
         public void DeletePeerConnection(IntPtr ptr)
         {
             NativeMethods.ContextDeletePeerConnection(self, ptr);
@@ -244,6 +314,12 @@ namespace Unity.WebRTC
             return NativeMethods.PeerConnectionCreateAnswer(self, ptr, ref options);
         }
 
+        public RTCErrorType RtpSenderSetOpusEncoderSettings(
+            IntPtr ptr, IntPtr sender, IntPtr source, ref RTCOpusEncoderSettingsInternal settings)
+        {
+            return NativeMethods.ContextRtpSenderSetOpusEncoderSettings(self, ptr, sender, source, ref settings);
+        }
+
         public IntPtr CreateDataChannel(IntPtr ptr, string label, ref RTCDataChannelInitInternal options)
         {
             return NativeMethods.ContextCreateDataChannel(self, ptr, label, ref options);
@@ -254,22 +330,76 @@ namespace Unity.WebRTC
             NativeMethods.ContextDeleteDataChannel(self, ptr);
         }
 
-        public void DataChannelRegisterOnMessage(IntPtr channel, DelegateNativeOnMessage callback)
+        public void DataChannelSetChunking(IntPtr channel, bool enabled, int chunkSize)
+        {
+            NativeMethods.DataChannelSetChunking(self, channel, enabled, chunkSize);
+        }
+
+        public void DataChannelSetBatchedReceive(IntPtr channel, bool enabled)
+        {
+            NativeMethods.DataChannelSetBatchedReceive(self, channel, enabled);
+        }
+
+        public int DataChannelReceiveBatch(IntPtr channel, out IntPtr data, out IntPtr index)
+        {
+            return NativeMethods.DataChannelReceiveBatch(self, channel, out data, out index);
+        }
+
+        public int DataChannelSendBatch(IntPtr channel, byte[] data, RTCDataChannelMessageIndex[] index, int count)
+        {
+            return NativeMethods.DataChannelSendBatch(self, channel, data, index, count);
+        }
+
+        public void DataChannelSetReceiveQueueCapacity(IntPtr channel, ulong capacity)
+        {
+            NativeMethods.DataChannelSetReceiveQueueCapacity(self, channel, capacity);
+        }
+
+        public ulong DataChannelGetReceiveQueueDroppedCount(IntPtr channel)
         {
-            NativeMethods.DataChannelRegisterOnMessage(self, channel, callback);
+            return NativeMethods.DataChannelGetReceiveQueueDroppedCount(self, channel);
         }
-        public void DataChannelRegisterOnOpen(IntPtr channel, DelegateNativeOnOpen callback)
+
+        public IntPtr DataChannelLeaseSendBuffer(IntPtr channel, int capacity, out IntPtr lease)
         {
-            NativeMethods.DataChannelRegisterOnOpen(self, channel, callback);
+            return NativeMethods.DataChannelLeaseSendBuffer(self, channel, capacity, out lease);
         }
-        public void DataChannelRegisterOnClose(IntPtr channel, DelegateNativeOnClose callback)
+
+        public bool DataChannelCommitSendBuffer(IntPtr channel, IntPtr lease, int length)
         {
-            NativeMethods.DataChannelRegisterOnClose(self, channel, callback);
+            return NativeMethods.DataChannelCommitSendBuffer(self, channel, lease, length);
         }
-        public void DataChannelRegisterOnError(IntPtr channel, DelegateNativeOnError callback)
+
+        public void DataChannelCancelSendBuffer(IntPtr channel, IntPtr lease)
+        {
+            NativeMethods.DataChannelCancelSendBuffer(self, channel, lease);
+        }
+
+        public bool DataChannelSendWithFlowControl(IntPtr channel, IntPtr data, int length, bool binary)
+        {
+            return NativeMethods.DataChannelSendWithFlowControl(self, channel, data, length, binary);
+        }
+
+        public void DataChannelSetBufferedAmountLowThreshold(IntPtr channel, ulong threshold)
+        {
+            NativeMethods.DataChannelSetBufferedAmountLowThreshold(self, channel, threshold);
+        }
+
+        public ulong DataChannelGetBufferedAmountLowThreshold(IntPtr channel)
+        {
+            return NativeMethods.DataChannelGetBufferedAmountLowThreshold(self, channel);
+        }
+
+        public void DataChannelSetSendQueueLimit(IntPtr channel, ulong limit)
         {
-            NativeMethods.DataChannelRegisterOnError(self, channel, callback);
+            NativeMethods.DataChannelSetSendQueueLimit(self, channel, limit);
         }
+
+        public ulong DataChannelGetQueuedAmount(IntPtr channel)
+        {
+            return NativeMethods.DataChannelGetQueuedAmount(self, channel);
+        }
+
         public IntPtr CreateMediaStream(string label)
         {
             return NativeMethods.ContextCreateMediaStream(self, label);
@@ -300,11 +430,21 @@ namespace Unity.WebRTC
             return NativeMethods.ContextCreateAudioTrackSink(self);
         }
 
+        public IntPtr CreateAudioTrackSink(AudioTrackSinkOptions options)
+        {
+            return NativeMethods.ContextCreateAudioTrackSinkWithOptions(self, ref options);
+        }
+
         public void DeleteAudioTrackSink(IntPtr sink)
         {
             NativeMethods.ContextDeleteAudioTrackSink(self, sink);
         }
 
+        public void SetAudioPlayoutFormat(int sampleRate, int channels)
+        {
+            NativeMethods.ContextSetAudioPlayoutFormat(self, sampleRate, channels);
+        }
+
         public IntPtr GetBatchUpdateEventFunc()
         {
             return NativeMethods.GetBatchUpdateEventFunc(self);
@@ -315,6 +455,16 @@ namespace Unity.WebRTC
             return NativeMethods.GetBatchUpdateEventID();
         }
 
+        public int DrainEvents(out IntPtr records)
+        {
+            return NativeMethods.ContextDrainEvents(self, out records);
+        }
+
+        public ulong GetSkippedRenderEventCount()
+        {
+            return NativeMethods.ContextGetSkippedRenderEventCount(self);
+        }
+
         public IntPtr GetUpdateTextureFunc()
         {
             return NativeMethods.GetUpdateTextureFunc(self);
@@ -361,6 +511,100 @@ namespace Unity.WebRTC
             return NativeMethods.ContextGetStatsList(self, report, out length, ref types);
         }
 
+        public IntPtr GetStatsSnapshot(IntPtr report, out ulong length)
+        {
+            return NativeMethods.ContextGetStatsSnapshot(self, report, out length);
+        }
+
+        public void SetStatsReportTimeToLive(long timeToLiveMs)
+        {
+            NativeMethods.ContextSetStatsReportTimeToLive(self, timeToLiveMs);
+        }
+
+        public RTCStatsReportUsage GetStatsReportUsage()
+        {
+            NativeMethods.ContextGetStatsReportUsage(self, out RTCStatsReportUsage usage);
+            return usage;
+        }
+
+        public IntPtr CreateStatsSubscription(uint[] types, string[] members)
+        {
+            return NativeMethods.ContextCreateStatsSubscription(self, types, types.Length, members, members.Length);
+        }
+
+        // Strings and arrays returned through the arena of the native context are
+        // valid until the next call which uses the arena, so the call and the copy
+        // are done under the lock.
+        public string TransceiverGetMid(IntPtr transceiver)
+        {
+            lock (m_marshalLock)
+            {
+                IntPtr ptr = NativeMethods.ContextTransceiverGetMid(self, transceiver);
+                return ptr == IntPtr.Zero ? null : ptr.AsAnsiStringWithoutFreeMem();
+            }
+        }
+
+        public string MediaStreamTrackGetID(IntPtr track)
+        {
+            lock (m_marshalLock)
+            {
+                return NativeMethods.ContextMediaStreamTrackGetID(self, track).AsAnsiStringWithoutFreeMem();
+            }
+        }
+
+        public string StatsGetId(IntPtr stats)
+        {
+            lock (m_marshalLock)
+            {
+                return NativeMethods.ContextStatsGetId(self, stats).AsAnsiStringWithoutFreeMem();
+            }
+        }
+
+        public string StatsMemberGetName(IntPtr member)
+        {
+            lock (m_marshalLock)
+            {
+                return NativeMethods.ContextStatsMemberGetName(self, member).AsAnsiStringWithoutFreeMem();
+            }
+        }
+
+        public string StatsMemberGetString(IntPtr member)
+        {
+            lock (m_marshalLock)
+            {
+                return NativeMethods.ContextStatsMemberGetString(self, member).AsAnsiStringWithoutFreeMem();
+            }
+        }
+
+        public string[] StatsMemberGetStringArray(IntPtr member)
+        {
+            lock (m_marshalLock)
+            {
+                IntPtr ptr = NativeMethods.ContextStatsMemberGetStringArray(self, member, out ulong length);
+                return ptr.AsArray<string>((int)length, false);
+            }
+        }
+
+        public Dictionary<string, ulong> StatsMemberGetMapStringUint64(IntPtr member)
+        {
+            lock (m_marshalLock)
+            {
+                IntPtr ptr = NativeMethods.ContextStatsMemberGetMapStringUint64(
+                    self, member, out IntPtr values, out ulong length);
+                return ptr.AsMap<ulong>(values, (int)length, false);
+            }
+        }
+
+        public Dictionary<string, double> StatsMemberGetMapStringDouble(IntPtr member)
+        {
+            lock (m_marshalLock)
+            {
+                IntPtr ptr = NativeMethods.ContextStatsMemberGetMapStringDouble(
+                    self, member, out IntPtr values, out ulong length);
+                return ptr.AsMap<double>(values, (int)length, false);
+            }
+        }
+
         public void DeleteStatsReport(IntPtr report)
         {
             NativeMethods.ContextDeleteStatsReport(self, report);
@@ -34,14 +34,22 @@ namespace Unity.WebRTC
     {
         private DelegateOnAddTrack onAddTrack;
         private DelegateOnRemoveTrack onRemoveTrack;
+        private string _id;
 
         private HashSet<MediaStreamTrack> cacheTracks = new HashSet<MediaStreamTrack>();
 
         /// <summary>
         ///     String containing 36 characters denoting a unique identifier for the object.
         /// </summary>
-        public string Id =>
-            NativeMethods.MediaStreamGetID(GetSelfOrThrow()).AsAnsiStringWithFreeMem();
+        public string Id
+        {
+            get
+            {
+                IntPtr ptr = GetSelfOrThrow();
+                // The ID never changes, so it is read from the native object once.
+                return _id ?? (_id = NativeMethods.MediaStreamGetID(ptr).AsAnsiStringWithFreeMem());
+            }
+        }
 
         /// <summary>
         ///     Finalizer for <see cref="MediaStream"/>.
@@ -19,6 +19,8 @@ namespace Unity.WebRTC
     /// <seealso cref="MediaStream"/>
     public class MediaStreamTrack : RefCountedObject
     {
+        private string _id;
+
         /// <summary>
         ///     Boolean value that indicates whether the track is allowed to render the source stream.
         /// </summary>
@@ -52,8 +54,15 @@ namespace Unity.WebRTC
         /// <summary>
         ///     String containing a unique identifier (GUID) for the track.
         /// </summary>
-        public string Id =>
-            NativeMethods.MediaStreamTrackGetID(GetSelfOrThrow()).AsAnsiStringWithFreeMem();
+        public string Id
+        {
+            get
+            {
+                IntPtr ptr = GetSelfOrThrow();
+                // The ID never changes, so it is read from the native object once.
+                return _id ?? (_id = WebRTC.Context.MediaStreamTrackGetID(ptr));
+            }
+        }
 
         internal MediaStreamTrack(IntPtr ptr) : base(ptr)
         {
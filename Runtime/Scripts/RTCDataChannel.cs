@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using Unity.Collections;
 using Unity.Collections.LowLevel.Unsafe;
@@ -255,6 +256,107 @@ namespace Unity.WebRTC
 
     public delegate void DelegateOnError(RTCError error);
 
+    /// <summary>
+    /// Delegate to be called when the amount of data buffered for sending falls to or below
+    /// <see cref="RTCDataChannel.BufferedAmountLowThreshold"/>.
+    /// </summary>
+    /// <seealso cref="RTCDataChannel.OnBufferedAmountLow"/>
+    public delegate void DelegateOnBufferedAmountLow();
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct RTCDataChannelMessageIndex
+    {
+        public int offset;
+        public int length;
+        public int binary;
+    }
+
+    /// <summary>
+    /// Represents messages received by a data channel in batched receive mode.
+    /// </summary>
+    /// <remarks>
+    /// The messages are stored in native memory which stays valid until the next call of
+    /// <see cref="RTCDataChannel.ReceiveBatch"/> for the same data channel.
+    /// </remarks>
+    /// <seealso cref="RTCDataChannel.BatchedReceive"/>
+    public readonly struct RTCDataChannelMessageBatch
+    {
+        private readonly IntPtr data;
+        private readonly IntPtr index;
+
+        /// <summary>
+        /// The number of messages in the batch.
+        /// </summary>
+        public readonly int Count;
+
+        internal RTCDataChannelMessageBatch(IntPtr data, IntPtr index, int count)
+        {
+            this.data = data;
+            this.index = index;
+            Count = count;
+        }
+
+        /// <summary>
+        /// Gets the location of a message in the batch.
+        /// </summary>
+        /// <param name="i">The index of the message.</param>
+        /// <param name="ptr">A pointer to the first byte of the message.</param>
+        /// <param name="length">The length of the message, in bytes.</param>
+        /// <returns>True if the message is binary, false if it is text.</returns>
+        public unsafe bool GetMessage(int i, out IntPtr ptr, out int length)
+        {
+            if (i < 0 || i >= Count)
+                throw new ArgumentOutOfRangeException(nameof(i));
+            RTCDataChannelMessageIndex entry = ((RTCDataChannelMessageIndex*)index)[i];
+            ptr = IntPtr.Add(data, entry.offset);
+            length = entry.length;
+            return entry.binary != 0;
+        }
+
+        /// <summary>
+        /// Copies a message in the batch to a new array.
+        /// </summary>
+        /// <param name="i">The index of the message.</param>
+        /// <returns>The copied message.</returns>
+        public byte[] ToArray(int i)
+        {
+            GetMessage(i, out IntPtr ptr, out int length);
+            byte[] bytes = new byte[length];
+            Marshal.Copy(ptr, bytes, 0, length);
+            return bytes;
+        }
+    }
+
+    /// <summary>
+    /// Represents a native buffer leased from a data channel to write a message in place.
+    /// </summary>
+    /// <remarks>
+    /// The message written into the buffer is sent without being copied by <see cref="RTCDataChannel.Send(RTCDataChannelSendBuffer, int)"/>.
+    /// The buffer must be either sent or cancelled once, and must not be accessed after that.
+    /// </remarks>
+    /// <seealso cref="RTCDataChannel.LeaseSendBuffer"/>
+    public readonly struct RTCDataChannelSendBuffer
+    {
+        internal readonly IntPtr lease;
+
+        /// <summary>
+        /// A pointer to the memory of the buffer.
+        /// </summary>
+        public readonly IntPtr Data;
+
+        /// <summary>
+        /// The size of the buffer, in bytes.
+        /// </summary>
+        public readonly int Capacity;
+
+        internal RTCDataChannelSendBuffer(IntPtr lease, IntPtr data, int capacity)
+        {
+            this.lease = lease;
+            Data = data;
+            Capacity = capacity;
+        }
+    }
+
     /// <summary>
     /// Creates a new RTCDataChannel for peer-to-peer data exchange, using the specified label and options.
     /// </summary>
@@ -290,6 +392,14 @@ namespace Unity.WebRTC
         private DelegateOnOpen onOpen;
         private DelegateOnClose onClose;
         private DelegateOnError onError;
+        private DelegateOnBufferedAmountLow onBufferedAmountLow;
+        private bool batchedReceive;
+        private ulong receiveQueueCapacity = 16 * 1024 * 1024;
+        private int chunkSize;
+        private string _label;
+        private string _protocol;
+        private byte[] sendBatchData = new byte[0];
+        private RTCDataChannelMessageIndex[] sendBatchIndex = new RTCDataChannelMessageIndex[0];
 
         /// <summary>
         /// Delegate to be called when a message has been received from the remote peer.
@@ -427,6 +537,60 @@ namespace Unity.WebRTC
             set => onError = value;
         }
 
+        /// <summary>
+        /// Delegate to be called when the amount of data buffered for sending falls to or below
+        /// <see cref="BufferedAmountLowThreshold"/>.
+        /// </summary>
+        /// <remarks>
+        /// The amount includes the messages kept in the native send queue. Bulk transfers can send
+        /// the next chunk from this delegate instead of polling <see cref="BufferedAmount"/>.
+        /// </remarks>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         dataChannel.BufferedAmountLowThreshold = 1024 * 1024;
+        ///         dataChannel.OnBufferedAmountLow = () => SendNextChunks();
+        ///     ]]></code>
+        /// </example>
+        public DelegateOnBufferedAmountLow OnBufferedAmountLow
+        {
+            get => onBufferedAmountLow;
+            set => onBufferedAmountLow = value;
+        }
+
+        /// <summary>
+        /// The threshold of the buffered amount at which <see cref="OnBufferedAmountLow"/> is called.
+        /// </summary>
+        public ulong BufferedAmountLowThreshold
+        {
+            get => WebRTC.Context.DataChannelGetBufferedAmountLowThreshold(GetSelfOrThrow());
+            set => WebRTC.Context.DataChannelSetBufferedAmountLowThreshold(GetSelfOrThrow(), value);
+        }
+
+        /// <summary>
+        /// The maximum amount of data, in bytes, kept in the native send queue.
+        /// </summary>
+        /// <remarks>
+        /// When the value is greater than zero, sent messages which do not fit in the send buffer of the channel
+        /// are queued natively, and are sent as the buffered amount falls. Messages which do not fit in the queue
+        /// either are dropped, which <see cref="TrySend(byte[])"/> and <see cref="SendBatch"/> report.
+        /// The default value is zero, which disables the queue.
+        /// </remarks>
+        public ulong SendQueueLimit
+        {
+            get => sendQueueLimit;
+            set
+            {
+                WebRTC.Context.DataChannelSetSendQueueLimit(GetSelfOrThrow(), value);
+                sendQueueLimit = value;
+            }
+        }
+        private ulong sendQueueLimit;
+
+        /// <summary>
+        /// The amount of data, in bytes, kept in the native send queue.
+        /// </summary>
+        public ulong QueuedAmount => WebRTC.Context.DataChannelGetQueuedAmount(GetSelfOrThrow());
+
         /// <summary>
         /// Returns an ID number (between 0 and 65,534) which uniquely identifies the RTCDataChannel.
         /// </summary>
@@ -483,7 +647,15 @@ namespace Unity.WebRTC
         ///         }
         ///     ]]></code>
         /// </example>
-        public string Label => NativeMethods.DataChannelGetLabel(GetSelfOrThrow()).AsAnsiStringWithFreeMem();
+        public string Label
+        {
+            get
+            {
+                IntPtr ptr = GetSelfOrThrow();
+                // The label never changes, so it is read from the native object once.
+                return _label ?? (_label = NativeMethods.DataChannelGetLabel(ptr).AsAnsiStringWithFreeMem());
+            }
+        }
 
         /// <summary>
         /// Returns the subprotocol being used by the data channel to transmit and process messages.
@@ -511,7 +683,14 @@ namespace Unity.WebRTC
         ///         }
         ///     ]]></code>
         /// </example>
-        public string Protocol => NativeMethods.DataChannelGetProtocol(GetSelfOrThrow()).AsAnsiStringWithFreeMem();
+        public string Protocol
+        {
+            get
+            {
+                IntPtr ptr = GetSelfOrThrow();
+                return _protocol ?? (_protocol = NativeMethods.DataChannelGetProtocol(ptr).AsAnsiStringWithFreeMem());
+            }
+        }
 
         /// <summary>
         /// Returns the maximum number of times the browser should try to retransmit a message before giving up.
@@ -741,63 +920,50 @@ namespace Unity.WebRTC
         /// </example>
         public RTCDataChannelState ReadyState => NativeMethods.DataChannelGetReadyState(GetSelfOrThrow());
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnMessage))]
-        static void DataChannelNativeOnMessage(IntPtr ptr, byte[] msg, int size)
+        internal static void DataChannelNativeOnMessage(IntPtr ptr, byte[] msg)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCDataChannel channel)
             {
-                if (WebRTC.Table[ptr] is RTCDataChannel channel)
-                {
-                    channel.onMessage?.Invoke(msg);
-                }
-            });
+                channel.onMessage?.Invoke(msg);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnOpen))]
-        static void DataChannelNativeOnOpen(IntPtr ptr)
+        internal static void DataChannelNativeOnOpen(IntPtr ptr)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCDataChannel channel)
             {
-                if (WebRTC.Table[ptr] is RTCDataChannel channel)
-                {
-                    channel.onOpen?.Invoke();
-                }
-            });
+                channel.onOpen?.Invoke();
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnClose))]
-        static void DataChannelNativeOnClose(IntPtr ptr)
+        internal static void DataChannelNativeOnClose(IntPtr ptr)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCDataChannel channel)
             {
-                if (WebRTC.Table[ptr] is RTCDataChannel channel)
-                {
-                    channel.onClose?.Invoke();
-                }
-            });
+                channel.onClose?.Invoke();
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnError))]
-        static void DataChannelNativeOnError(IntPtr ptr, RTCErrorType errorType, byte[] message, int size)
+        internal static void DataChannelNativeOnError(IntPtr ptr, RTCErrorType errorType, string message)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCDataChannel channel)
             {
-                if (WebRTC.Table[ptr] is RTCDataChannel channel)
-                {
-                    channel.onError?.Invoke(new RTCError() { errorType = errorType, message = System.Text.Encoding.UTF8.GetString(message) });
-                }
-            });
+                channel.onError?.Invoke(new RTCError() { errorType = errorType, message = message });
+            }
         }
 
+        internal static void DataChannelNativeOnBufferedAmountLow(IntPtr ptr)
+        {
+            if (WebRTC.Table[ptr] is RTCDataChannel channel)
+            {
+                channel.onBufferedAmountLow?.Invoke();
+            }
+        }
 
         internal RTCDataChannel(IntPtr ptr, RTCPeerConnection peerConnection)
             : base(ptr)
         {
             WebRTC.Table.Add(self, this);
-            WebRTC.Context.DataChannelRegisterOnMessage(self, DataChannelNativeOnMessage);
-            WebRTC.Context.DataChannelRegisterOnOpen(self, DataChannelNativeOnOpen);
-            WebRTC.Context.DataChannelRegisterOnClose(self, DataChannelNativeOnClose);
-            WebRTC.Context.DataChannelRegisterOnError(self, DataChannelNativeOnError);
         }
 
         /// <summary>
@@ -947,6 +1113,12 @@ namespace Unity.WebRTC
             {
                 throw new InvalidOperationException("DataChannel is not open");
             }
+            if (UseFlowControl)
+            {
+                byte[] bytes = System.Text.Encoding.UTF8.GetBytes(msg);
+                SendWithFlowControl(bytes, 0, bytes.Length, false);
+                return;
+            }
             NativeMethods.DataChannelSend(GetSelfOrThrow(), msg);
         }
 
@@ -1028,6 +1200,11 @@ namespace Unity.WebRTC
             {
                 throw new InvalidOperationException("DataChannel is not open");
             }
+            if (UseFlowControl)
+            {
+                SendWithFlowControl(msg, 0, msg.Length, true);
+                return;
+            }
             NativeMethods.DataChannelSendBinary(GetSelfOrThrow(), msg, msg.Length);
         }
 
@@ -1118,7 +1295,7 @@ namespace Unity.WebRTC
             {
                 throw new ArgumentException("Message array has not been created.", nameof(msg));
             }
-            NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
+            SendPtr(new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
         }
 
         /// <summary>
@@ -1206,7 +1383,7 @@ namespace Unity.WebRTC
             {
                 throw new InvalidOperationException("DataChannel is not open");
             }
-            NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
+            SendPtr(new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
         }
 
 #if UNITY_2020_1_OR_NEWER // ReadOnly support was introduced in 2020.1
@@ -1295,7 +1472,7 @@ namespace Unity.WebRTC
             {
                 throw new InvalidOperationException("DataChannel is not open");
             }
-            NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
+            SendPtr(new IntPtr(msg.GetUnsafeReadOnlyPtr()), msg.Length * UnsafeUtility.SizeOf<T>());
         }
 #endif
 
@@ -1319,7 +1496,7 @@ namespace Unity.WebRTC
             {
                 throw new InvalidOperationException("DataChannel is not open");
             }
-            NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), new IntPtr(msgPtr), length);
+            SendPtr(new IntPtr(msgPtr), length);
         }
 
         /// <summary>
@@ -1397,10 +1574,262 @@ namespace Unity.WebRTC
             }
             if (msgPtr != IntPtr.Zero && length > 0)
             {
-                NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), msgPtr, length);
+                SendPtr(msgPtr, length);
             }
         }
 
+        /// <summary>
+        /// Sends data to the remote peer through the native flow control.
+        /// </summary>
+        /// <remarks>
+        /// Unlike <see cref="Send(byte[])"/>, the result tells whether the message is sent or queued
+        /// when <see cref="SendQueueLimit"/> is set.
+        /// </remarks>
+        /// <param name="msg">The message to send.</param>
+        /// <returns>False if the message is neither sent nor queued because the queue is full.</returns>
+        /// <seealso cref="SendQueueLimit"/>
+        public bool TrySend(byte[] msg)
+        {
+            if (msg == null)
+                throw new ArgumentNullException(nameof(msg));
+            return TrySend(msg, 0, msg.Length);
+        }
+
+        /// <summary>
+        /// Sends a part of an array to the remote peer through the native flow control.
+        /// </summary>
+        /// <param name="msg">The array containing the message.</param>
+        /// <param name="offset">The offset of the message in the array.</param>
+        /// <param name="length">The length of the message, in bytes.</param>
+        /// <returns>False if the message is neither sent nor queued because the queue is full.</returns>
+        /// <seealso cref="SendQueueLimit"/>
+        public unsafe bool TrySend(byte[] msg, int offset, int length)
+        {
+            if (msg == null)
+                throw new ArgumentNullException(nameof(msg));
+            if (offset < 0 || length < 0 || offset + length > msg.Length)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            if (ReadyState != RTCDataChannelState.Open)
+            {
+                throw new InvalidOperationException("DataChannel is not open");
+            }
+            fixed (byte* ptr = msg)
+            {
+                return WebRTC.Context.DataChannelSendWithFlowControl(GetSelfOrThrow(), new IntPtr(ptr + offset), length, true);
+            }
+        }
+
+        /// <summary>
+        /// The size of chunks, in bytes, which messages are split into. Zero disables chunking.
+        /// </summary>
+        /// <remarks>
+        /// When chunking is enabled, messages larger than the chunk size are split natively, and chunks of
+        /// large messages are interleaved with small messages so that the small ones are not delayed until the
+        /// large ones are sent. Received chunks are reassembled into a single message before <see cref="OnMessage"/>.
+        /// Both peers need to set the same mode before sending messages.
+        /// </remarks>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         dataChannel.ChunkSize = 16 * 1024;
+        ///         dataChannel.Send(largeMessage);
+        ///     ]]></code>
+        /// </example>
+        public int ChunkSize
+        {
+            get => chunkSize;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+                WebRTC.Context.DataChannelSetChunking(GetSelfOrThrow(), value > 0, value);
+                chunkSize = value;
+            }
+        }
+
+        // Chunks and the send queue are handled by the native flow control.
+        private bool UseFlowControl => chunkSize > 0 || sendQueueLimit > 0;
+
+        private unsafe bool SendWithFlowControl(byte[] msg, int offset, int length, bool binary)
+        {
+            fixed (byte* ptr = msg)
+            {
+                return WebRTC.Context.DataChannelSendWithFlowControl(GetSelfOrThrow(), new IntPtr(ptr + offset), length, binary);
+            }
+        }
+
+        private void SendPtr(IntPtr msgPtr, int length)
+        {
+            if (UseFlowControl)
+            {
+                WebRTC.Context.DataChannelSendWithFlowControl(GetSelfOrThrow(), msgPtr, length, true);
+                return;
+            }
+            NativeMethods.DataChannelSendPtr(GetSelfOrThrow(), msgPtr, length);
+        }
+
+        /// <summary>
+        /// Whether received messages are queued natively instead of being passed to <see cref="OnMessage"/>.
+        /// </summary>
+        /// <remarks>
+        /// In batched receive mode, <see cref="ReceiveBatch"/> drains all of the messages received
+        /// since the previous call at once, which is expected to be called once per frame.
+        /// Messages queued when the mode is disabled are discarded.
+        /// </remarks>
+        /// <seealso cref="ReceiveBatch"/>
+        public bool BatchedReceive
+        {
+            get => batchedReceive;
+            set
+            {
+                WebRTC.Context.DataChannelSetBatchedReceive(GetSelfOrThrow(), value);
+                batchedReceive = value;
+            }
+        }
+
+        /// <summary>
+        /// The maximum amount of data, in bytes, queued between two calls of <see cref="ReceiveBatch"/>.
+        /// </summary>
+        /// <remarks>
+        /// Messages received in batched receive mode which do not fit in the queue are dropped,
+        /// and counted by <see cref="ReceiveQueueDroppedCount"/>. The default value is 16 MB.
+        /// Zero removes the limit.
+        /// </remarks>
+        /// <seealso cref="BatchedReceive"/>
+        public ulong ReceiveQueueCapacity
+        {
+            get => receiveQueueCapacity;
+            set
+            {
+                WebRTC.Context.DataChannelSetReceiveQueueCapacity(GetSelfOrThrow(), value);
+                receiveQueueCapacity = value;
+            }
+        }
+
+        /// <summary>
+        /// The number of received messages dropped because the receive queue is full.
+        /// </summary>
+        /// <seealso cref="ReceiveQueueCapacity"/>
+        public ulong ReceiveQueueDroppedCount => WebRTC.Context.DataChannelGetReceiveQueueDroppedCount(GetSelfOrThrow());
+
+        /// <summary>
+        /// Drains the messages received since the previous call in batched receive mode.
+        /// </summary>
+        /// <returns>The received messages, valid until the next call.</returns>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         dataChannel.BatchedReceive = true;
+        ///
+        ///         void Update()
+        ///         {
+        ///             var batch = dataChannel.ReceiveBatch();
+        ///             for (int i = 0; i < batch.Count; i++)
+        ///             {
+        ///                 batch.GetMessage(i, out IntPtr ptr, out int length);
+        ///                 Process(ptr, length);
+        ///             }
+        ///         }
+        ///     ]]></code>
+        /// </example>
+        /// <seealso cref="BatchedReceive"/>
+        public RTCDataChannelMessageBatch ReceiveBatch()
+        {
+            int count = WebRTC.Context.DataChannelReceiveBatch(GetSelfOrThrow(), out IntPtr data, out IntPtr index);
+            return new RTCDataChannelMessageBatch(data, index, count);
+        }
+
+        /// <summary>
+        /// Sends binary messages to the remote peer with one native call.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">
+        /// Thrown when the <see cref="ReadyState"/> is not <b>Open</b>.
+        /// </exception>
+        /// <param name="messages">The messages to send.</param>
+        /// <returns>The number of messages sent. It is less than the count of the messages when sending fails.</returns>
+        public int SendBatch(IReadOnlyList<byte[]> messages)
+        {
+            if (messages == null)
+                throw new ArgumentNullException(nameof(messages));
+            if (ReadyState != RTCDataChannelState.Open)
+            {
+                throw new InvalidOperationException("DataChannel is not open");
+            }
+
+            int total = 0;
+            for (int i = 0; i < messages.Count; i++)
+                total += messages[i].Length;
+            if (sendBatchData.Length < total)
+                sendBatchData = new byte[total];
+            if (sendBatchIndex.Length < messages.Count)
+                sendBatchIndex = new RTCDataChannelMessageIndex[messages.Count];
+
+            int offset = 0;
+            for (int i = 0; i < messages.Count; i++)
+            {
+                Buffer.BlockCopy(messages[i], 0, sendBatchData, offset, messages[i].Length);
+                sendBatchIndex[i] = new RTCDataChannelMessageIndex { offset = offset, length = messages[i].Length, binary = 1 };
+                offset += messages[i].Length;
+            }
+            return WebRTC.Context.DataChannelSendBatch(GetSelfOrThrow(), sendBatchData, sendBatchIndex, messages.Count);
+        }
+
+        /// <summary>
+        /// Leases a native buffer to write a message in place.
+        /// </summary>
+        /// <remarks>
+        /// Buffers are pooled per data channel, so the steady state of sending messages
+        /// through leased buffers neither allocates nor copies the messages.
+        /// </remarks>
+        /// <param name="capacity">The size of the buffer, in bytes.</param>
+        /// <returns>The leased buffer.</returns>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         var buffer = dataChannel.LeaseSendBuffer(1024);
+        ///         int length = WriteState(buffer.Data, buffer.Capacity);
+        ///         dataChannel.Send(buffer, length);
+        ///     ]]></code>
+        /// </example>
+        /// <seealso cref="Send(RTCDataChannelSendBuffer, int)"/>
+        /// <seealso cref="CancelSendBuffer"/>
+        public RTCDataChannelSendBuffer LeaseSendBuffer(int capacity)
+        {
+            if (capacity <= 0)
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+            IntPtr data = WebRTC.Context.DataChannelLeaseSendBuffer(GetSelfOrThrow(), capacity, out IntPtr lease);
+            return new RTCDataChannelSendBuffer(lease, data, capacity);
+        }
+
+        /// <summary>
+        /// Sends the message written into the leased buffer to the remote peer.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">
+        /// Thrown when the <see cref="ReadyState"/> is not <b>Open</b>. The buffer is returned in this case.
+        /// </exception>
+        /// <param name="buffer">The buffer returned by <see cref="LeaseSendBuffer"/>.</param>
+        /// <param name="length">The length of the message, in bytes.</param>
+        /// <returns>False if the message is neither sent nor queued. The buffer is returned in this case too.</returns>
+        /// <seealso cref="LeaseSendBuffer"/>
+        public bool Send(RTCDataChannelSendBuffer buffer, int length)
+        {
+            if (length < 0 || length > buffer.Capacity)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            if (ReadyState != RTCDataChannelState.Open)
+            {
+                WebRTC.Context.DataChannelCancelSendBuffer(GetSelfOrThrow(), buffer.lease);
+                throw new InvalidOperationException("DataChannel is not open");
+            }
+            return WebRTC.Context.DataChannelCommitSendBuffer(GetSelfOrThrow(), buffer.lease, length);
+        }
+
+        /// <summary>
+        /// Returns the leased buffer without sending it.
+        /// </summary>
+        /// <param name="buffer">The buffer returned by <see cref="LeaseSendBuffer"/>.</param>
+        /// <seealso cref="LeaseSendBuffer"/>
+        public void CancelSendBuffer(RTCDataChannelSendBuffer buffer)
+        {
+            WebRTC.Context.DataChannelCancelSendBuffer(GetSelfOrThrow(), buffer.lease);
+        }
+
         /// <summary>
         /// Closes the RTCDataChannel. Either peer is permitted to call this method to initiate closure of the channel.
         /// </summary>
@@ -414,112 +414,80 @@ namespace Unity.WebRTC
             return self;
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnIceCandidate))]
-        static void PCOnIceCandidate(IntPtr ptr, string sdp, string sdpMid, int sdpMlineIndex)
+        internal static void PCOnIceCandidate(IntPtr ptr, string sdp, string sdpMid, int sdpMlineIndex)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
+                var options = new RTCIceCandidateInit
                 {
-                    var options = new RTCIceCandidateInit
-                    {
-                        candidate = sdp,
-                        sdpMid = sdpMid,
-                        sdpMLineIndex = sdpMlineIndex
-                    };
-                    var candidate = new RTCIceCandidate(options);
-                    connection.OnIceCandidate?.Invoke(candidate);
-                }
-            });
+                    candidate = sdp,
+                    sdpMid = sdpMid,
+                    sdpMLineIndex = sdpMlineIndex
+                };
+                var candidate = new RTCIceCandidate(options);
+                connection.OnIceCandidate?.Invoke(candidate);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnIceConnectionChange))]
-        static void PCOnIceConnectionChange(IntPtr ptr, RTCIceConnectionState state)
+        internal static void PCOnIceConnectionChange(IntPtr ptr, RTCIceConnectionState state)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    connection.OnIceConnectionChange?.Invoke(state);
-                }
-            });
+                connection.OnIceConnectionChange?.Invoke(state);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnConnectionStateChange))]
-        static void PCOnConnectionStateChange(IntPtr ptr, RTCPeerConnectionState state)
+        internal static void PCOnConnectionStateChange(IntPtr ptr, RTCPeerConnectionState state)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    connection.OnConnectionStateChange?.Invoke(state);
-                }
-            });
+                connection.OnConnectionStateChange?.Invoke(state);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnIceGatheringChange))]
-        static void PCOnIceGatheringChange(IntPtr ptr, RTCIceGatheringState state)
+        internal static void PCOnIceGatheringChange(IntPtr ptr, RTCIceGatheringState state)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    connection.OnIceGatheringStateChange?.Invoke(state);
-                }
-            });
+                connection.OnIceGatheringStateChange?.Invoke(state);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnNegotiationNeeded))]
-        static void PCOnNegotiationNeeded(IntPtr ptr)
+        internal static void PCOnNegotiationNeeded(IntPtr ptr)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    connection.OnNegotiationNeeded?.Invoke();
-                }
-            });
+                connection.OnNegotiationNeeded?.Invoke();
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnDataChannel))]
-        static void PCOnDataChannel(IntPtr ptr, IntPtr ptrChannel)
+        internal static void PCOnDataChannel(IntPtr ptr, IntPtr ptrChannel)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    connection.OnDataChannel?.Invoke(new RTCDataChannel(ptrChannel, connection));
-                }
-            });
+                connection.OnDataChannel?.Invoke(new RTCDataChannel(ptrChannel, connection));
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnTrack))]
-        static void PCOnTrack(IntPtr ptr, IntPtr transceiver)
+        internal static void PCOnTrack(IntPtr ptr, IntPtr transceiver)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    var e = new RTCTrackEvent(transceiver, connection);
-                    connection.OnTrack?.Invoke(e);
-                    connection.cacheTracks.Add(e.Track);
-                }
-            });
+                var e = new RTCTrackEvent(transceiver, connection);
+                connection.OnTrack?.Invoke(e);
+                connection.cacheTracks.Add(e.Track);
+            }
         }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnRemoveTrack))]
-        static void PCOnRemoveTrack(IntPtr ptr, IntPtr receiverPtr)
+        internal static void PCOnRemoveTrack(IntPtr ptr, IntPtr receiverPtr)
         {
-            WebRTC.Sync(ptr, () =>
+            if (WebRTC.Table[ptr] is RTCPeerConnection connection)
             {
-                if (WebRTC.Table[ptr] is RTCPeerConnection connection)
-                {
-                    var receiver = WebRTC.FindOrCreate(
-                        receiverPtr, _ptr => new RTCRtpReceiver(_ptr, connection));
-                    if (receiver != null)
-                        connection.cacheTracks.Remove(receiver.Track);
-                }
-            });
+                var receiver = WebRTC.FindOrCreate(
+                    receiverPtr, _ptr => new RTCRtpReceiver(_ptr, connection));
+                if (receiver != null)
+                    connection.cacheTracks.Remove(receiver.Track);
+            }
         }
 
         /// <summary>
@@ -542,10 +510,7 @@ namespace Unity.WebRTC
         /// <seealso cref="SetConfiguration(ref RTCConfiguration)"/>
         public RTCConfiguration GetConfiguration()
         {
-            IntPtr ptr = NativeMethods.PeerConnectionGetConfiguration(GetSelfOrThrow());
-            string str = ptr.AsAnsiStringWithFreeMem();
-            var conf = JsonUtility.FromJson<RTCConfigurationInternal>(str);
-            return new RTCConfiguration(ref conf);
+            return WebRTC.Context.PeerConnectionGetConfiguration(GetSelfOrThrow());
         }
 
         /// <summary>
@@ -586,8 +551,14 @@ namespace Unity.WebRTC
         public RTCErrorType SetConfiguration(ref RTCConfiguration configuration)
         {
             var conf_ = configuration.Cast();
-            string str = JsonUtility.ToJson(conf_);
-            return NativeMethods.PeerConnectionSetConfiguration(GetSelfOrThrow(), str);
+            try
+            {
+                return NativeMethods.PeerConnectionSetRTCConfiguration(GetSelfOrThrow(), ref conf_);
+            }
+            finally
+            {
+                conf_.Dispose();
+            }
         }
 
         /// <summary>
@@ -611,7 +582,6 @@ namespace Unity.WebRTC
             }
 
             WebRTC.Table.Add(self, this);
-            InitCallback();
         }
 
         /// <summary>
@@ -631,27 +601,14 @@ namespace Unity.WebRTC
         public RTCPeerConnection(ref RTCConfiguration configuration)
         {
             var conf_ = configuration.Cast();
-            string configStr = JsonUtility.ToJson(conf_);
-            self = WebRTC.Context.CreatePeerConnection(configStr);
+            self = WebRTC.Context.CreatePeerConnection(ref conf_);
+            conf_.Dispose();
             if (self == IntPtr.Zero)
             {
                 throw new ArgumentException("Could not instantiate RTCPeerConnection");
             }
 
             WebRTC.Table.Add(self, this);
-            InitCallback();
-        }
-
-        void InitCallback()
-        {
-            NativeMethods.PeerConnectionRegisterIceConnectionChange(self, PCOnIceConnectionChange);
-            NativeMethods.PeerConnectionRegisterConnectionStateChange(self, PCOnConnectionStateChange);
-            NativeMethods.PeerConnectionRegisterIceGatheringChange(self, PCOnIceGatheringChange);
-            NativeMethods.PeerConnectionRegisterOnIceCandidate(self, PCOnIceCandidate);
-            NativeMethods.PeerConnectionRegisterOnDataChannel(self, PCOnDataChannel);
-            NativeMethods.PeerConnectionRegisterOnRenegotiationNeeded(self, PCOnNegotiationNeeded);
-            NativeMethods.PeerConnectionRegisterOnTrack(self, PCOnTrack);
-            NativeMethods.PeerConnectionRegisterOnRemoveTrack(self, PCOnRemoveTrack);
         }
 
         /// <summary>
@@ -1116,6 +1073,31 @@ namespace Unity.WebRTC
             return GetStats(callback);
         }
 
+        /// <summary>
+        ///     Creates a subscription which collects only the specified members of the stats.
+        /// </summary>
+        /// <remarks>
+        ///     Unlike <see cref="GetStats()"/>, the report is filtered natively and only the values which have
+        ///     changed since the previous report are returned, with rates computed for counters.
+        /// </remarks>
+        /// <param name="types">The types of the stats objects to collect. All types are collected when empty.</param>
+        /// <param name="members">The names of the members to collect, such as "bytesSent".</param>
+        /// <returns>The subscription, which is disposed by the caller.</returns>
+        /// <seealso cref="RTCStatsSubscription"/>
+        public RTCStatsSubscription CreateStatsSubscription(RTCStatsType[] types, string[] members)
+        {
+            if (types == null)
+                throw new ArgumentNullException(nameof(types));
+            if (members == null)
+                throw new ArgumentNullException(nameof(members));
+            GetSelfOrThrow();
+
+            uint[] _types = Array.ConvertAll(types, type => (uint)type);
+            string[] _members = (string[])members.Clone();
+            IntPtr ptr = WebRTC.Context.CreateStatsSubscription(_types, _members);
+            return new RTCStatsSubscription(this, ptr, _members);
+        }
+
         internal RTCStatsReportAsyncOperation GetStats(RTCRtpSender sender)
         {
             RTCStatsCollectorCallback callback = NativeMethods.PeerConnectionSenderGetStats(GetSelfOrThrow(), sender.self);
@@ -1157,15 +1139,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription LocalDescription
         {
-            get
-            {
-                RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetLocalDescription(GetSelfOrThrow(), ref desc))
-                {
-                    return desc;
-                }
-                throw new InvalidOperationException("LocalDescription is not exist");
-            }
+            get { return GetSessionDescription(RTCSessionDescriptionSource.Local, "LocalDescription"); }
         }
 
         /// <summary>
@@ -1173,15 +1147,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription RemoteDescription
         {
-            get
-            {
-                RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetRemoteDescription(GetSelfOrThrow(), ref desc))
-                {
-                    return desc;
-                }
-                throw new InvalidOperationException("RemoteDescription is not exist");
-            }
+            get { return GetSessionDescription(RTCSessionDescriptionSource.Remote, "RemoteDescription"); }
         }
 
         /// <summary>
@@ -1190,15 +1156,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription CurrentLocalDescription
         {
-            get
-            {
-                RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetCurrentLocalDescription(GetSelfOrThrow(), ref desc))
-                {
-                    return desc;
-                }
-                throw new InvalidOperationException("CurrentLocalDescription is not exist");
-            }
+            get { return GetSessionDescription(RTCSessionDescriptionSource.CurrentLocal, "CurrentLocalDescription"); }
         }
 
         /// <summary>
@@ -1207,15 +1165,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription CurrentRemoteDescription
         {
-            get
-            {
-                RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetCurrentRemoteDescription(GetSelfOrThrow(), ref desc))
-                {
-                    return desc;
-                }
-                throw new InvalidOperationException("CurrentRemoteDescription is not exist");
-            }
+            get { return GetSessionDescription(RTCSessionDescriptionSource.CurrentRemote, "CurrentRemoteDescription"); }
         }
 
         /// <summary>
@@ -1223,15 +1173,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription PendingLocalDescription
         {
-            get
-            {
-                RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetPendingLocalDescription(GetSelfOrThrow(), ref desc))
-                {
-                    return desc;
-                }
-                throw new InvalidOperationException("PendingLocalDescription is not exist");
-            }
+            get { return GetSessionDescription(RTCSessionDescriptionSource.PendingLocal, "PendingLocalDescription"); }
         }
 
         /// <summary>
@@ -1239,14 +1181,31 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCSessionDescription PendingRemoteDescription
         {
-            get
+            get { return GetSessionDescription(RTCSessionDescriptionSource.PendingRemote, "PendingRemoteDescription"); }
+        }
+
+        // The descriptions copied from the native code, indexed by RTCSessionDescriptionSource.
+        // The native code only copies a description again when its handle has changed.
+        readonly ulong[] descriptionHandles = new ulong[6];
+        readonly RTCSessionDescription[] descriptions = new RTCSessionDescription[6];
+
+        RTCSessionDescription GetSessionDescription(RTCSessionDescriptionSource source, string name)
+        {
+            int index = (int)source;
+            lock (descriptions)
             {
                 RTCSessionDescription desc = default;
-                if (NativeMethods.PeerConnectionGetPendingRemoteDescription(GetSelfOrThrow(), ref desc))
+                ulong handle = descriptionHandles[index];
+                if (!NativeMethods.PeerConnectionGetSessionDescription(GetSelfOrThrow(), source, ref handle, ref desc))
+                {
+                    throw new InvalidOperationException($"{name} is not exist");
+                }
+                if (desc.sdp != null)
                 {
-                    return desc;
+                    descriptionHandles[index] = handle;
+                    descriptions[index] = desc;
                 }
-                throw new InvalidOperationException("PendingRemoteDescription is not exist");
+                return descriptions[index];
             }
         }
 
@@ -223,6 +223,37 @@ namespace Unity.WebRTC
             return parameters;
         }
 
+        /// <summary>
+        ///     Sets the settings of the Opus encoder of the sender.
+        /// </summary>
+        /// <remarks>
+        ///     The settings are applied to the encoder of the sender without changing the session descriptions,
+        ///     so they take effect both when the connection sends the offer and when it answers.
+        ///     `maxBitrate` applies to the encodings of this sender only and can be changed at any time.
+        ///     The other settings are used by the encoder when the sender is negotiated, so changing them afterwards
+        ///     returns `RTCErrorType.InvalidState`. Senders which share an audio track must use the same values
+        ///     for them, and different values return `RTCErrorType.InvalidModification`.
+        /// </remarks>
+        /// <param name="settings">`RTCOpusEncoderSettings` object.</param>
+        /// <returns>`RTCError` value.</returns>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         RTCRtpSender sender = peerConnection.GetSenders().First();
+        ///         RTCError error = sender.SetOpusEncoderSettings(new RTCOpusEncoderSettings { complexity = 5, ptime = 40 });
+        ///     ]]></code>
+        /// </example>
+        public RTCError SetOpusEncoderSettings(RTCOpusEncoderSettings settings)
+        {
+            if (settings == null)
+                throw new ArgumentNullException(nameof(settings));
+            if (!(Track is AudioStreamTrack audioTrack) || audioTrack._trackSource == null)
+                throw new InvalidOperationException("The sender has no local audio track.");
+            RTCOpusEncoderSettingsInternal settingsInternal = settings.Cast();
+            RTCErrorType type = WebRTC.Context.RtpSenderSetOpusEncoderSettings(
+                peer.GetSelfOrThrow(), GetSelfOrThrow(), audioTrack._trackSource.self, ref settingsInternal);
+            return new RTCError { errorType = type };
+        }
+
         /// <summary>
         ///     Updates the configuration of the sender's track.
         /// </summary>
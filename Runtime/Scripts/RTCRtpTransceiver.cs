@@ -70,13 +70,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string Mid
         {
-            get
-            {
-                IntPtr ptr = NativeMethods.TransceiverGetMid(GetSelfOrThrow());
-                if (ptr == IntPtr.Zero)
-                    return null;
-                return ptr.AsAnsiStringWithFreeMem();
-            }
+            get { return WebRTC.Context.TransceiverGetMid(GetSelfOrThrow()); }
         }
 
         /// <summary>
@@ -1,6 +1,8 @@
 using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
 
 namespace Unity.WebRTC
 {
@@ -147,7 +149,7 @@ namespace Unity.WebRTC
 
         internal string GetName()
         {
-            return NativeMethods.StatsMemberGetName(self).AsAnsiStringWithFreeMem();
+            return WebRTC.Context.StatsMemberGetName(self);
         }
 
         internal StatsMemberType GetValueType()
@@ -164,7 +166,6 @@ namespace Unity.WebRTC
                 return null;
             }
 
-            IntPtr values;
             ulong length = 0;
             switch (type)
             {
@@ -181,7 +182,7 @@ namespace Unity.WebRTC
                 case StatsMemberType.Double:
                     return NativeMethods.StatsMemberGetDouble(self);
                 case StatsMemberType.String:
-                    return NativeMethods.StatsMemberGetString(self).AsAnsiStringWithFreeMem();
+                    return WebRTC.Context.StatsMemberGetString(self);
                 case StatsMemberType.SequenceBool:
                     return NativeMethods.StatsMemberGetBoolArray(self, out length).AsArray<bool>((int)length);
                 case StatsMemberType.SequenceInt32:
@@ -195,11 +196,11 @@ namespace Unity.WebRTC
                 case StatsMemberType.SequenceDouble:
                     return NativeMethods.StatsMemberGetDoubleArray(self, out length).AsArray<double>((int)length);
                 case StatsMemberType.SequenceString:
-                    return NativeMethods.StatsMemberGetStringArray(self, out length).AsArray<string>((int)length);
+                    return WebRTC.Context.StatsMemberGetStringArray(self);
                 case StatsMemberType.MapStringUint64:
-                    return NativeMethods.StatsMemberGetMapStringUint64(self, out values, out length).AsMap<ulong>(values, (int)length);
+                    return WebRTC.Context.StatsMemberGetMapStringUint64(self);
                 case StatsMemberType.MapStringDouble:
-                    return NativeMethods.StatsMemberGetMapStringDouble(self, out values, out length).AsMap<double>(values, (int)length);
+                    return WebRTC.Context.StatsMemberGetMapStringDouble(self);
                 default:
                     throw new ArgumentException();
             }
@@ -231,7 +232,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string Id
         {
-            get { return NativeMethods.StatsGetId(self).AsAnsiStringWithFreeMem(); }
+            get { return WebRTC.Context.StatsGetId(self); }
         }
 
         /// <summary>
@@ -333,7 +334,7 @@ namespace Unity.WebRTC
                 return default;
             }
 
-            return NativeMethods.StatsMemberGetString(m_members[key].self).AsAnsiStringWithFreeMem();
+            return WebRTC.Context.StatsMemberGetString(m_members[key].self);
         }
 
         internal bool[] GetBoolArray(string key)
@@ -409,8 +410,7 @@ namespace Unity.WebRTC
                 return default;
             }
 
-            return NativeMethods.StatsMemberGetStringArray(m_members[key].self, out ulong length)
-                .AsArray<string>((int)length);
+            return WebRTC.Context.StatsMemberGetStringArray(m_members[key].self);
         }
 
         internal Dictionary<string, double> GetMapStringDouble(string key)
@@ -420,8 +420,7 @@ namespace Unity.WebRTC
                 return default;
             }
 
-            return NativeMethods.StatsMemberGetMapStringDouble(m_members[key].self, out IntPtr values, out ulong length)
-                .AsMap<double>(values, (int)length);
+            return WebRTC.Context.StatsMemberGetMapStringDouble(m_members[key].self);
         }
 
         internal RTCStats(IntPtr ptr)
@@ -1696,6 +1695,568 @@ namespace Unity.WebRTC
         }
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct StatsSnapshotHeader
+    {
+        public uint magic;
+        public uint version;
+        public uint size;
+        public uint statsCount;
+        public uint memberCount;
+        public uint stringCount;
+        public uint valueCount;
+        public uint statsOffset;
+        public uint membersOffset;
+        public uint stringsOffset;
+        public uint valuesOffset;
+        public uint charsOffset;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct StatsSnapshotStats
+    {
+        public uint id;
+        public uint type;
+        public long timestampUs;
+        public uint firstMember;
+        public uint memberCount;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct StatsSnapshotMember
+    {
+        public uint name;
+        public byte type;
+        public byte defined;
+        public ushort reserved;
+        public uint count;
+        public uint reserved2;
+        public ulong value;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct StatsSnapshotString
+    {
+        public uint offset;
+        public uint length;
+    }
+
+    /// <summary>
+    /// Flat binary form of <see cref="RTCStatsReport"/> which is read without calling the native code.
+    /// </summary>
+    /// <remarks>
+    /// The snapshot is taken with a single native call and is valid until the report is disposed.
+    /// Reading numeric members does not allocate, which suits polling the stats of many peer connections.
+    /// </remarks>
+    /// <example>
+    ///     <code lang="cs"><![CDATA[
+    ///         RTCStatsSnapshot snapshot = report.GetSnapshot();
+    ///         for (int i = 0; i < snapshot.Count; i++)
+    ///         {
+    ///             RTCStatsSnapshotEntry stats = snapshot[i];
+    ///             if (stats.Type == RTCStatsType.InboundRtp && stats.TryGetMember("packetsLost", out var member))
+    ///                 packetsLost += member.GetLong();
+    ///         }
+    ///     ]]></code>
+    /// </example>
+    public readonly struct RTCStatsSnapshot
+    {
+        internal const uint Magic = 0x53435452;
+        internal const uint Version = 1;
+
+        private readonly IntPtr data;
+        private readonly int length;
+        private readonly StatsSnapshotHeader header;
+
+        internal RTCStatsSnapshot(IntPtr data, int length)
+        {
+            this.data = data;
+            this.length = length;
+            header = default;
+            if (length < Marshal.SizeOf<StatsSnapshotHeader>())
+                throw new ArgumentException("The snapshot is truncated.", nameof(length));
+            header = Read<StatsSnapshotHeader>(0);
+            if (header.magic != Magic || header.version != Version || header.size > length)
+                throw new InvalidOperationException($"Unsupported stats snapshot version {header.version}.");
+        }
+
+        /// <summary>
+        /// The number of stats objects in the snapshot.
+        /// </summary>
+        public int Count => (int)header.statsCount;
+
+        /// <summary>
+        /// Gets the stats object at the index.
+        /// </summary>
+        /// <param name="index">The index of the stats object.</param>
+        public RTCStatsSnapshotEntry this[int index]
+        {
+            get
+            {
+                if ((uint)index >= header.statsCount)
+                    throw new ArgumentOutOfRangeException(nameof(index));
+                return new RTCStatsSnapshotEntry(this, index);
+            }
+        }
+
+        internal unsafe ReadOnlySpan<byte> Span => new ReadOnlySpan<byte>(data.ToPointer(), length);
+
+        internal T Read<T>(long offset) where T : struct
+        {
+            return MemoryMarshal.Read<T>(Span.Slice((int)offset));
+        }
+
+        internal StatsSnapshotStats GetStats(int index)
+        {
+            return Read<StatsSnapshotStats>(header.statsOffset + (long)index * Marshal.SizeOf<StatsSnapshotStats>());
+        }
+
+        internal StatsSnapshotMember GetMember(long index)
+        {
+            return Read<StatsSnapshotMember>(header.membersOffset + index * Marshal.SizeOf<StatsSnapshotMember>());
+        }
+
+        internal ulong GetValue(ulong index)
+        {
+            return Read<ulong>(header.valuesOffset + (long)index * sizeof(ulong));
+        }
+
+        internal ReadOnlySpan<byte> GetUtf8String(ulong index)
+        {
+            var str = Read<StatsSnapshotString>(header.stringsOffset + (long)index * Marshal.SizeOf<StatsSnapshotString>());
+            return Span.Slice((int)(header.charsOffset + str.offset), (int)str.length);
+        }
+
+        internal string GetString(ulong index)
+        {
+            return Encoding.UTF8.GetString(GetUtf8String(index));
+        }
+    }
+
+    /// <summary>
+    /// A stats object in <see cref="RTCStatsSnapshot"/>.
+    /// </summary>
+    public readonly struct RTCStatsSnapshotEntry
+    {
+        private readonly RTCStatsSnapshot snapshot;
+        private readonly StatsSnapshotStats stats;
+
+        internal RTCStatsSnapshotEntry(RTCStatsSnapshot snapshot, int index)
+        {
+            this.snapshot = snapshot;
+            stats = snapshot.GetStats(index);
+        }
+
+        /// <summary>
+        /// The type of the stats object.
+        /// </summary>
+        public RTCStatsType Type => (RTCStatsType)stats.type;
+
+        /// <summary>
+        /// The identifier of the stats object.
+        /// </summary>
+        public string Id => snapshot.GetString(stats.id);
+
+        /// <summary>
+        /// The identifier of the stats object in UTF-8, which is read without allocation.
+        /// </summary>
+        public ReadOnlySpan<byte> IdUtf8 => snapshot.GetUtf8String(stats.id);
+
+        /// <summary>
+        /// The timestamp in microseconds.
+        /// </summary>
+        public long Timestamp => stats.timestampUs;
+
+        /// <summary>
+        /// The number of members of the stats object.
+        /// </summary>
+        public int MemberCount => (int)stats.memberCount;
+
+        /// <summary>
+        /// Gets the member at the index.
+        /// </summary>
+        /// <param name="index">The index of the member.</param>
+        /// <returns>The member.</returns>
+        public RTCStatsSnapshotMember GetMember(int index)
+        {
+            if ((uint)index >= stats.memberCount)
+                throw new ArgumentOutOfRangeException(nameof(index));
+            return new RTCStatsSnapshotMember(snapshot, snapshot.GetMember(stats.firstMember + index));
+        }
+
+        /// <summary>
+        /// Finds the member by the name used in the WebRTC statistics specification, such as "bytesSent".
+        /// </summary>
+        /// <param name="name">The name of the member.</param>
+        /// <param name="member">The member when found.</param>
+        /// <returns>True if found, otherwise false.</returns>
+        public bool TryGetMember(string name, out RTCStatsSnapshotMember member)
+        {
+            for (int i = 0; i < (int)stats.memberCount; i++)
+            {
+                var entry = snapshot.GetMember(stats.firstMember + i);
+                if (EqualsAscii(snapshot.GetUtf8String(entry.name), name))
+                {
+                    member = new RTCStatsSnapshotMember(snapshot, entry);
+                    return true;
+                }
+            }
+            member = default;
+            return false;
+        }
+
+        // Member names are ASCII, so they are compared without decoding.
+        static bool EqualsAscii(ReadOnlySpan<byte> utf8, string str)
+        {
+            if (utf8.Length != str.Length)
+                return false;
+            for (int i = 0; i < utf8.Length; i++)
+            {
+                if (utf8[i] != str[i])
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// A member of a stats object in <see cref="RTCStatsSnapshot"/>.
+    /// </summary>
+    public readonly struct RTCStatsSnapshotMember
+    {
+        private readonly RTCStatsSnapshot snapshot;
+        private readonly StatsSnapshotMember member;
+
+        internal RTCStatsSnapshotMember(RTCStatsSnapshot snapshot, StatsSnapshotMember member)
+        {
+            this.snapshot = snapshot;
+            this.member = member;
+        }
+
+        /// <summary>
+        /// The name of the member.
+        /// </summary>
+        public string Name => snapshot.GetString(member.name);
+
+        /// <summary>
+        /// Whether the member has a value.
+        /// </summary>
+        public bool IsDefined => member.defined != 0;
+
+        /// <summary>
+        /// The number of elements of a sequence, or entries of a map.
+        /// </summary>
+        public int Count => (int)member.count;
+
+        internal StatsMemberType ValueType => (StatsMemberType)member.type;
+
+        /// <summary>
+        /// Gets the value of a bool member.
+        /// </summary>
+        public bool GetBool() => member.value != 0;
+
+        /// <summary>
+        /// Gets the value of a signed or unsigned integer member.
+        /// </summary>
+        public long GetLong() => (long)member.value;
+
+        /// <summary>
+        /// Gets the value of an unsigned integer member.
+        /// </summary>
+        public ulong GetUnsignedLong() => member.value;
+
+        /// <summary>
+        /// Gets the value of a double member.
+        /// </summary>
+        public double GetDouble() => BitConverter.Int64BitsToDouble((long)member.value);
+
+        /// <summary>
+        /// Gets the value of a string member.
+        /// </summary>
+        public string GetString() => snapshot.GetString(member.value);
+
+        /// <summary>
+        /// Gets the value as the type which <see cref="RTCStats.Dict"/> returns.
+        /// </summary>
+        /// <returns>The value, or null if the member is not defined.</returns>
+        public object GetValue()
+        {
+            if (!IsDefined)
+                return null;
+
+            switch (ValueType)
+            {
+                case StatsMemberType.Bool:
+                    return GetBool();
+                case StatsMemberType.Int32:
+                    return (int)GetLong();
+                case StatsMemberType.Uint32:
+                    return (uint)GetUnsignedLong();
+                case StatsMemberType.Int64:
+                    return GetLong();
+                case StatsMemberType.Uint64:
+                    return GetUnsignedLong();
+                case StatsMemberType.Double:
+                    return GetDouble();
+                case StatsMemberType.String:
+                    return GetString();
+                case StatsMemberType.SequenceBool:
+                    return GetSequence(value => value != 0);
+                case StatsMemberType.SequenceInt32:
+                    return GetSequence(value => (int)value);
+                case StatsMemberType.SequenceUint32:
+                    return GetSequence(value => (uint)value);
+                case StatsMemberType.SequenceInt64:
+                    return GetSequence(value => (long)value);
+                case StatsMemberType.SequenceUint64:
+                    return GetSequence(value => value);
+                case StatsMemberType.SequenceDouble:
+                    return GetSequence(value => BitConverter.Int64BitsToDouble((long)value));
+                case StatsMemberType.SequenceString:
+                {
+                    var array = new string[member.count];
+                    for (uint i = 0; i < member.count; i++)
+                        array[i] = snapshot.GetString(snapshot.GetValue(member.value + i));
+                    return array;
+                }
+                case StatsMemberType.MapStringUint64:
+                    return GetMap(value => value);
+                case StatsMemberType.MapStringDouble:
+                    return GetMap(value => BitConverter.Int64BitsToDouble((long)value));
+                default:
+                    throw new ArgumentException("Unknown type: " + ValueType);
+            }
+        }
+
+        T[] GetSequence<T>(Func<ulong, T> convert)
+        {
+            var array = new T[member.count];
+            for (uint i = 0; i < member.count; i++)
+                array[i] = convert(snapshot.GetValue(member.value + i));
+            return array;
+        }
+
+        Dictionary<string, T> GetMap<T>(Func<ulong, T> convert)
+        {
+            var map = new Dictionary<string, T>((int)member.count);
+            for (uint i = 0; i < member.count; i++)
+            {
+                string key = snapshot.GetString(snapshot.GetValue(member.value + i * 2));
+                map[key] = convert(snapshot.GetValue(member.value + i * 2 + 1));
+            }
+            return map;
+        }
+    }
+
+    /// <summary>
+    /// A member value which has changed since the previous report of <see cref="RTCStatsSubscription"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RTCStatsDelta
+    {
+        internal IntPtr id;
+
+        /// <summary>
+        /// The timestamp of the stats object in microseconds.
+        /// </summary>
+        public long timestamp;
+
+        /// <summary>
+        /// The value of the member. Integers and bools are converted to double.
+        /// </summary>
+        public double value;
+
+        /// <summary>
+        /// The change of a cumulative counter per second, valid when <see cref="HasRate"/> is true.
+        /// </summary>
+        public double rate;
+
+        /// <summary>
+        /// The number assigned to the stats object, which is never reused by the subscription.
+        /// A stats object which is missing from a report gets a new number when it is reported again.
+        /// </summary>
+        public uint key;
+
+        internal uint type;
+
+        /// <summary>
+        /// The index of the member name passed to <see cref="RTCPeerConnection.CreateStatsSubscription"/>.
+        /// </summary>
+        public int member;
+
+        internal int hasRate;
+
+        /// <summary>
+        /// The type of the stats object.
+        /// </summary>
+        public RTCStatsType Type => (RTCStatsType)type;
+
+        /// <summary>
+        /// Whether <see cref="rate"/> is computed, which is for counters such as "bytesSent"
+        /// from the second report.
+        /// </summary>
+        public bool HasRate => hasRate != 0;
+    }
+
+    /// <summary>
+    /// Collects only the specified members of the stats, and returns the values which have changed.
+    /// </summary>
+    /// <remarks>
+    /// The report is processed natively, so neither the report nor its members are marshalled.
+    /// This suits monitoring a few members at a high frequency.
+    /// </remarks>
+    /// <example>
+    ///     <code lang="cs"><![CDATA[
+    ///         var subscription = peerConnection.CreateStatsSubscription(
+    ///             new[] { RTCStatsType.OutboundRtp }, new[] { "bytesSent", "framesEncoded" });
+    ///
+    ///         IEnumerator Monitor()
+    ///         {
+    ///             while (true)
+    ///             {
+    ///                 subscription.Request();
+    ///                 yield return new WaitForSeconds(0.25f);
+    ///                 foreach (var delta in subscription.Poll())
+    ///                 {
+    ///                     if (delta.HasRate)
+    ///                         Debug.Log($"{subscription.GetMemberName(delta)}: {delta.rate}/s");
+    ///                 }
+    ///             }
+    ///         }
+    ///     ]]></code>
+    /// </example>
+    /// <seealso cref="RTCPeerConnection.CreateStatsSubscription"/>
+    public class RTCStatsSubscription : IDisposable
+    {
+        private IntPtr self;
+        private readonly RTCPeerConnection connection;
+        private readonly string[] members;
+        private readonly Dictionary<uint, string> ids = new Dictionary<uint, string>();
+        private bool disposed;
+
+        internal RTCStatsSubscription(RTCPeerConnection connection, IntPtr ptr, string[] members)
+        {
+            self = ptr;
+            this.connection = connection;
+            this.members = members;
+        }
+
+        /// <summary>
+        /// Finalizer to ensure resources are released.
+        /// </summary>
+        ~RTCStatsSubscription()
+        {
+            this.Dispose();
+        }
+
+        /// <summary>
+        /// Releases resources held by this subscription.
+        /// </summary>
+        public void Dispose()
+        {
+            if (this.disposed)
+            {
+                return;
+            }
+
+            if (self != IntPtr.Zero && !WebRTC.Context.IsNull)
+            {
+                WebRTC.Context.DeleteRefPtr(self);
+                self = IntPtr.Zero;
+            }
+
+            this.disposed = true;
+            GC.SuppressFinalize(this);
+        }
+
+        /// <summary>
+        /// The member names to collect.
+        /// </summary>
+        public IReadOnlyList<string> Members => members;
+
+        /// <summary>
+        /// Requests the stats of the peer connection. The changed values are returned by <see cref="Poll"/>
+        /// after the stats are collected.
+        /// </summary>
+        public void Request()
+        {
+            NativeMethods.PeerConnectionRequestStatsSubscription(connection.GetSelfOrThrow(), GetSelfOrThrow());
+        }
+
+        /// <summary>
+        /// Returns the values which have changed since the previous call.
+        /// </summary>
+        /// <returns>The changed values, valid until the next call.</returns>
+        public unsafe ReadOnlySpan<RTCStatsDelta> Poll()
+        {
+            int count = NativeMethods.StatsSubscriptionPoll(
+                GetSelfOrThrow(), out IntPtr deltas, out IntPtr removedKeys, out int removedCount);
+            // The stats objects missing from the report are not reported again.
+            uint* keys = (uint*)removedKeys.ToPointer();
+            for (int i = 0; i < removedCount; i++)
+                ids.Remove(keys[i]);
+            return new ReadOnlySpan<RTCStatsDelta>(deltas.ToPointer(), count);
+        }
+
+        /// <summary>
+        /// Gets the id of the stats object of the value.
+        /// </summary>
+        /// <param name="delta">The value returned by <see cref="Poll"/>.</param>
+        /// <returns>The id of the stats object.</returns>
+        public string GetId(in RTCStatsDelta delta)
+        {
+            if (!ids.TryGetValue(delta.key, out string id))
+            {
+                id = Marshal.PtrToStringAnsi(delta.id);
+                ids.Add(delta.key, id);
+            }
+            return id;
+        }
+
+        /// <summary>
+        /// Gets the member name of the value.
+        /// </summary>
+        /// <param name="delta">The value returned by <see cref="Poll"/>.</param>
+        /// <returns>The member name.</returns>
+        public string GetMemberName(in RTCStatsDelta delta)
+        {
+            return members[delta.member];
+        }
+
+        private IntPtr GetSelfOrThrow()
+        {
+            if (self == IntPtr.Zero)
+            {
+                throw new ObjectDisposedException(
+                    GetType().FullName, "This instance has been disposed.");
+            }
+            return self;
+        }
+    }
+
+    /// <summary>
+    /// Number and estimated memory of the stats reports kept natively.
+    /// </summary>
+    /// <seealso cref="WebRTC.GetStatsReportUsage"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RTCStatsReportUsage
+    {
+        /// <summary>
+        /// The number of reports which are not disposed.
+        /// </summary>
+        public ulong count;
+
+        /// <summary>
+        /// The estimated memory, in bytes, held by the reports and their snapshots.
+        /// </summary>
+        public ulong bytes;
+
+        /// <summary>
+        /// The number of reports released because they were not accessed for the time to live.
+        /// </summary>
+        public ulong expiredCount;
+    }
+
     /// <summary>
     /// Represents a report containing multiple RTCStats objects.
     /// </summary>
@@ -1789,5 +2350,23 @@ namespace Unity.WebRTC
         {
             get { return m_dictStats; }
         }
+
+        /// <summary>
+        /// Takes the flat binary snapshot of this report.
+        /// </summary>
+        /// <remarks>
+        /// Unlike <see cref="Stats"/>, which calls the native code for each member, the snapshot is
+        /// taken with a single native call. It is valid until this report is disposed.
+        /// </remarks>
+        /// <returns>The snapshot of this report.</returns>
+        public RTCStatsSnapshot GetSnapshot()
+        {
+            if (self == IntPtr.Zero)
+                throw new ObjectDisposedException(nameof(RTCStatsReport));
+            IntPtr data = WebRTC.Context.GetStatsSnapshot(self, out ulong length);
+            if (data == IntPtr.Zero)
+                throw new InvalidOperationException("The report is not found.");
+            return new RTCStatsSnapshot(data, (int)length);
+        }
     }
 }
@@ -539,4 +539,70 @@ namespace Unity.WebRTC
         }
     }
 
+    /// <summary>
+    ///     Represents the settings of the Opus encoder used by an audio sender.
+    /// </summary>
+    /// <remarks>
+    ///     The settings override the parameters negotiated with the remote peer. They are applied
+    ///     to the encoder of the sender and are not written to the session descriptions.
+    /// </remarks>
+    /// <example>
+    ///     <code lang="cs"><![CDATA[
+    ///         RTCRtpSender sender = peerConnection.AddTrack(audioTrack);
+    ///         RTCError error = sender.SetOpusEncoderSettings(new RTCOpusEncoderSettings { complexity = 5, dtx = true });
+    ///     ]]></code>
+    /// </example>
+    /// <seealso cref="RTCRtpSender.SetOpusEncoderSettings"/>
+    public class RTCOpusEncoderSettings
+    {
+        /// <summary>
+        ///     Specifies the computational complexity of the encoder from 0 to 10.
+        /// </summary>
+        /// <remarks>
+        ///     Lower values reduce the CPU usage of the encoder at the cost of quality.
+        /// </remarks>
+        public int? complexity;
+
+        /// <summary>
+        ///     Specifies the duration of audio in a packet in milliseconds, 10, 20, 40 or 60.
+        /// </summary>
+        public int? ptime;
+
+        /// <summary>
+        ///     Specifies whether discontinuous transmission is used during silence.
+        /// </summary>
+        public bool? dtx;
+
+        /// <summary>
+        ///     Specifies whether in-band forward error correction is used.
+        /// </summary>
+        public bool? fec;
+
+        /// <summary>
+        ///     Specifies the maximum average bitrate of the encoder in bits per second.
+        /// </summary>
+        public ulong? maxBitrate;
+
+        internal RTCOpusEncoderSettingsInternal Cast()
+        {
+            return new RTCOpusEncoderSettingsInternal
+            {
+                complexity = complexity,
+                ptime = ptime,
+                dtx = dtx,
+                fec = fec,
+                maxBitrate = maxBitrate
+            };
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct RTCOpusEncoderSettingsInternal
+    {
+        public OptionalInt complexity;
+        public OptionalInt ptime;
+        public OptionalBool dtx;
+        public OptionalBool fec;
+        public OptionalUlong maxBitrate;
+    }
 }
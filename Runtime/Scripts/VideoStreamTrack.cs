@@ -87,6 +87,7 @@ namespace Unity.WebRTC
             public int width;
             public int height;
             public GraphicsFormat format;
+            public ulong sourceHandle;
         }
 
         internal VideoTrackSource m_source;
@@ -181,10 +182,12 @@ namespace Unity.WebRTC
             {
                 m_data.ptrTexture = texturePtr;
                 m_data.ptrSource = IntPtr.Zero;
+                m_data.sourceHandle = 0;
                 m_data.action = VideoStreamTrackAction.Ignore;
                 if (Encoding == true)
                 {
                     m_data.ptrSource = (IntPtr)m_source?.self;
+                    m_data.sourceHandle = m_source?.handle ?? 0;
                     m_data.action = VideoStreamTrackAction.Encode;
                 }
                 else if (Decoding == true && m_renderer?.customTextureUpload == true)
@@ -358,6 +361,8 @@ namespace Unity.WebRTC
         internal RenderTexture destTexture_;
         internal IntPtr destTexturePtr_;
         internal CopyTexture copyTexture_;
+        // Validates the source on the render thread.
+        internal readonly ulong handle;
 
         internal bool SyncApplicationFramerate
         {
@@ -369,6 +374,7 @@ namespace Unity.WebRTC
             : base(WebRTC.Context.CreateVideoTrackSource())
         {
             WebRTC.Table.Add(self, this);
+            handle = WebRTC.Context.GetRefPtrHandle(self);
         }
 
         ~VideoTrackSource()
@@ -1,4 +1,5 @@
 using System;
+using System.Threading;
 using UnityEngine;
 
 namespace Unity.WebRTC
@@ -111,4 +112,64 @@ namespace Unity.WebRTC
             this.Done();
         }
     }
+
+    internal enum ContextAsyncState
+    {
+        Pending = 0,
+        Succeeded = 1,
+        Failed = 2
+    }
+
+    internal class ContextAsyncOperation : AsyncOperationBase
+    {
+        private IntPtr self;
+
+        internal IntPtr context { get; private set; }
+
+        internal ContextAsyncOperation(IntPtr ptr)
+        {
+            self = ptr;
+        }
+
+        public override bool keepWaiting
+        {
+            get
+            {
+                Poll();
+                return !IsDone;
+            }
+        }
+
+        internal void Wait()
+        {
+            Poll();
+            while (!IsDone)
+            {
+                Thread.Sleep(1);
+                Poll();
+            }
+        }
+
+        void Poll()
+        {
+            if (IsDone)
+                return;
+            var state = NativeMethods.ContextAsyncOperationGetState(self, out IntPtr ptr);
+            if (state == ContextAsyncState.Pending)
+                return;
+            NativeMethods.ContextAsyncOperationRelease(self);
+            self = IntPtr.Zero;
+            context = ptr;
+            IsError = state == ContextAsyncState.Failed;
+            if (IsError)
+            {
+                Error = new RTCError()
+                {
+                    errorType = RTCErrorType.InternalError,
+                    message = "Failed to create the context."
+                };
+            }
+            this.Done();
+        }
+    }
 }
@@ -1,6 +1,7 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.Linq;
 using System.Runtime.InteropServices;
 using System.Threading;
 using UnityEngine;
@@ -394,6 +395,57 @@ namespace Unity.WebRTC
         BundlePolicyMaxCompat = 2
     }
 
+    /// <summary>
+    /// Please check the <see cref="RTCConfiguration.rtcpMuxPolicy"/> in the <see cref="RTCConfiguration"/> class.
+    /// </summary>
+    /// <seealso cref="RTCConfiguration.rtcpMuxPolicy"/>
+    public enum RTCRtcpMuxPolicy : int
+    {
+        /// <summary>
+        ///     Gathers ICE candidates for both RTP and RTCP.
+        /// </summary>
+        Negotiate = 0,
+
+        /// <summary>
+        ///     Gathers ICE candidates only for RTP and multiplexes RTCP on top of RTP.
+        /// </summary>
+        Require = 1
+    }
+
+    /// <summary>
+    /// Please check the <see cref="RTCConfiguration.candidateNetworkPolicy"/> in the <see cref="RTCConfiguration"/> class.
+    /// </summary>
+    /// <seealso cref="RTCConfiguration.candidateNetworkPolicy"/>
+    public enum RTCCandidateNetworkPolicy : int
+    {
+        /// <summary>
+        ///     Gathers candidates on all networks.
+        /// </summary>
+        All = 0,
+
+        /// <summary>
+        ///     Ignores costly networks, such as cellular networks, when other networks are available.
+        /// </summary>
+        LowCost = 1
+    }
+
+    /// <summary>
+    /// Please check the <see cref="RTCConfiguration.tcpCandidatePolicy"/> in the <see cref="RTCConfiguration"/> class.
+    /// </summary>
+    /// <seealso cref="RTCConfiguration.tcpCandidatePolicy"/>
+    public enum RTCTcpCandidatePolicy : int
+    {
+        /// <summary>
+        ///     Gathers TCP candidates.
+        /// </summary>
+        Enabled = 0,
+
+        /// <summary>
+        ///     Does not gather TCP candidates.
+        /// </summary>
+        Disabled = 1
+    }
+
     /// <summary>
     /// Please check the <see cref="RTCDataChannel.ReadyState"/> in the <see cref="RTCDataChannel"/> class.
     /// </summary>
@@ -653,35 +705,145 @@ namespace Unity.WebRTC
         /// </summary>
         public int? iceCandidatePoolSize;
 
+        /// <summary>
+        ///     Specifies whether RTCP is multiplexed on top of RTP.
+        /// </summary>
+        public RTCRtcpMuxPolicy? rtcpMuxPolicy;
+
+        /// <summary>
+        ///     Specifies the lowest local port used for ICE candidates.
+        /// </summary>
+        public int? minPort;
+
+        /// <summary>
+        ///     Specifies the highest local port used for ICE candidates.
+        /// </summary>
+        public int? maxPort;
+
+        /// <summary>
+        ///     Specifies which networks are used to gather ICE candidates.
+        /// </summary>
+        public RTCCandidateNetworkPolicy? candidateNetworkPolicy;
+
+        /// <summary>
+        ///     Specifies whether TCP candidates are gathered.
+        /// </summary>
+        public RTCTcpCandidatePolicy? tcpCandidatePolicy;
+
+        /// <summary>
+        ///     Specifies whether link-local networks are ignored when gathering ICE candidates.
+        /// </summary>
+        public bool? disableLinkLocalNetworks;
+
         internal RTCConfiguration(ref RTCConfigurationInternal v)
         {
-            iceServers = v.iceServers;
+            iceServers = v.iceServers.length == 0
+                ? new RTCIceServer[0]
+                : v.iceServers.ptr.AsArray<RTCIceServerInternal>(v.iceServers.length, false)
+                    .Select(_ => _.ToIceServer()).ToArray();
             iceTransportPolicy = v.iceTransportPolicy.AsEnum<RTCIceTransportPolicy>();
             bundlePolicy = v.bundlePolicy.AsEnum<RTCBundlePolicy>();
+            rtcpMuxPolicy = v.rtcpMuxPolicy.AsEnum<RTCRtcpMuxPolicy>();
             iceCandidatePoolSize = v.iceCandidatePoolSize;
+            minPort = v.minPort;
+            maxPort = v.maxPort;
+            candidateNetworkPolicy = v.candidateNetworkPolicy.AsEnum<RTCCandidateNetworkPolicy>();
+            tcpCandidatePolicy = v.tcpCandidatePolicy.AsEnum<RTCTcpCandidatePolicy>();
+            disableLinkLocalNetworks = v.disableLinkLocalNetworks;
         }
 
         internal RTCConfigurationInternal Cast()
         {
             RTCConfigurationInternal instance = new RTCConfigurationInternal
             {
-                iceServers = this.iceServers,
+                iceServers = this.iceServers == null
+                    ? default(MarshallingArray<RTCIceServerInternal>)
+                    : this.iceServers.Select(RTCIceServerInternal.FromIceServer).ToArray(),
                 iceTransportPolicy = OptionalInt.FromEnum(this.iceTransportPolicy),
                 bundlePolicy = OptionalInt.FromEnum(this.bundlePolicy),
+                rtcpMuxPolicy = OptionalInt.FromEnum(this.rtcpMuxPolicy),
                 iceCandidatePoolSize = this.iceCandidatePoolSize,
+                minPort = this.minPort,
+                maxPort = this.maxPort,
+                candidateNetworkPolicy = OptionalInt.FromEnum(this.candidateNetworkPolicy),
+                tcpCandidatePolicy = OptionalInt.FromEnum(this.tcpCandidatePolicy),
+                disableLinkLocalNetworks = this.disableLinkLocalNetworks,
             };
             return instance;
         }
     }
 
-    [Serializable]
-    struct RTCConfigurationInternal
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct RTCIceServerInternal
     {
-        public RTCIceServer[] iceServers;
+        public IntPtr credential;
+        public RTCIceCredentialType credentialType;
+        public MarshallingArray<IntPtr> urls;
+        public IntPtr username;
+
+        public static RTCIceServerInternal FromIceServer(RTCIceServer server)
+        {
+            return new RTCIceServerInternal
+            {
+                credential = server.credential.ToPtrAnsi(),
+                credentialType = server.credentialType,
+                urls = server.urls == null
+                    ? default(MarshallingArray<IntPtr>)
+                    : server.urls.Select(_ => _.ToPtrAnsi()).ToArray(),
+                username = server.username.ToPtrAnsi(),
+            };
+        }
+
+        // The strings are owned by the native code.
+        public RTCIceServer ToIceServer()
+        {
+            return new RTCIceServer
+            {
+                credential = credential.AsAnsiStringWithoutFreeMem(),
+                credentialType = credentialType,
+                urls = urls.length == 0 ? new string[0] : urls.ptr.AsArray<string>(urls.length, false),
+                username = username.AsAnsiStringWithoutFreeMem(),
+            };
+        }
+
+        public void Dispose()
+        {
+            Marshal.FreeCoTaskMem(credential);
+            Marshal.FreeCoTaskMem(username);
+            if (urls.ptr != IntPtr.Zero)
+            {
+                foreach (var url in urls.ptr.AsArray<IntPtr>(urls.length, false))
+                    Marshal.FreeCoTaskMem(url);
+            }
+            urls.Dispose();
+            credential = IntPtr.Zero;
+            username = IntPtr.Zero;
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct RTCConfigurationInternal
+    {
+        public MarshallingArray<RTCIceServerInternal> iceServers;
         public OptionalInt iceTransportPolicy;
         public OptionalInt bundlePolicy;
+        public OptionalInt rtcpMuxPolicy;
         public OptionalInt iceCandidatePoolSize;
-        public OptionalBool enableDtlsSrtp;
+        public OptionalInt minPort;
+        public OptionalInt maxPort;
+        public OptionalInt candidateNetworkPolicy;
+        public OptionalInt tcpCandidatePolicy;
+        public OptionalBool disableLinkLocalNetworks;
+
+        public void Dispose()
+        {
+            if (iceServers.ptr != IntPtr.Zero)
+            {
+                foreach (var server in iceServers.ptr.AsArray<RTCIceServerInternal>(iceServers.length, false))
+                    server.Dispose();
+            }
+            iceServers.Dispose();
+        }
     }
 
     /// <summary>
@@ -715,6 +877,123 @@ namespace Unity.WebRTC
         None,
     };
 
+    /// <summary>
+    /// Represents the scheduling priority requested for a native thread.
+    /// </summary>
+    public enum ThreadPriorityHint
+    {
+        /// <summary>
+        /// Lower than the default priority.
+        /// </summary>
+        Low = -1,
+
+        /// <summary>
+        /// The default priority of the platform.
+        /// </summary>
+        Normal = 0,
+
+        /// <summary>
+        /// Higher than the default priority. Some platforms require a permission for it.
+        /// </summary>
+        High = 1,
+    }
+
+    /// <summary>
+    /// Scheduling hints applied to a native thread when it starts.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ThreadOptions
+    {
+        /// <summary>
+        /// The priority of the thread.
+        /// </summary>
+        public ThreadPriorityHint priority;
+
+        /// <summary>
+        /// The bit mask of the CPUs the thread may run on. Zero leaves the thread on any CPU.
+        /// Apple platforms ignore it.
+        /// </summary>
+        public ulong affinityMask;
+    }
+
+    /// <summary>
+    /// Configures the threads which the native context runs.
+    /// </summary>
+    /// <seealso cref="WebRTC.ConfigureThreads"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ContextThreadOptions
+    {
+        /// <summary>
+        /// Runs socket I/O on a network thread separated from the worker thread, which manages codecs.
+        /// By default the worker thread also runs socket I/O.
+        /// </summary>
+        [MarshalAs(UnmanagedType.U1)]
+        public bool separateNetworkThread;
+
+        /// <summary>
+        /// The options of the network thread, used when <see cref="separateNetworkThread"/> is true.
+        /// </summary>
+        public ThreadOptions network;
+
+        /// <summary>
+        /// The options of the worker thread.
+        /// </summary>
+        public ThreadOptions worker;
+
+        /// <summary>
+        /// The options of the signaling thread.
+        /// </summary>
+        public ThreadOptions signaling;
+
+        /// <summary>
+        /// The number of peer connection factories, each with its own network and worker threads.
+        /// A peer connection is created on the factory with the fewest peer connections.
+        /// Tracks and sources are shared by all factories. Values less than 1 are treated as 1.
+        /// </summary>
+        public int factoryShards;
+    }
+
+    internal enum RTCSessionDescriptionSource : int
+    {
+        Local = 0,
+        Remote = 1,
+        PendingLocal = 2,
+        PendingRemote = 3,
+        CurrentLocal = 4,
+        CurrentRemote = 5,
+    }
+
+    internal enum NativeEventType : int
+    {
+        IceCandidate = 0,
+        IceConnectionChange = 1,
+        ConnectionStateChange = 2,
+        IceGatheringChange = 3,
+        NegotiationNeeded = 4,
+        DataChannel = 5,
+        Track = 6,
+        RemoveTrack = 7,
+        StatsDelivered = 8,
+        DataChannelOpen = 9,
+        DataChannelClose = 10,
+        DataChannelError = 11,
+        DataChannelMessage = 12,
+        DataChannelBufferedAmountLow = 13,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct NativeEventRecord
+    {
+        public NativeEventType type;
+        public int value;
+        public IntPtr sender;
+        public IntPtr obj;
+        public IntPtr obj2;
+        public IntPtr data;
+        public IntPtr text;
+        public int length;
+    }
+
     /// <summary>
     ///     Provides utilities and management functions for integrating WebRTC functionality. 
     /// </summary>
@@ -735,7 +1014,13 @@ namespace Unity.WebRTC
         internal const string Lib = "webrtc";
 #endif
         private static Context s_context = null;
+        // The context is created on a native thread while the scene loads, and
+        // is waited for when it is used first.
+        private static ContextAsyncOperation s_contextCreation = null;
+        private static bool s_limitTextureSize;
+        private static ContextThreadOptions s_threadOptions;
         private static SynchronizationContext s_syncContext;
+        private static bool s_dispatchingEvents;
         private static ILogger s_logger;
 
         [RuntimeInitializeOnLoadMethod]
@@ -748,11 +1033,11 @@ namespace Unity.WebRTC
         internal static void InitializeInternal(bool limitTextureSize = true, bool enableNativeLog = false,
             NativeLoggingSeverity nativeLoggingSeverity = NativeLoggingSeverity.Info)
         {
-            if (s_context != null)
+            if (s_context != null || s_contextCreation != null)
                 throw new InvalidOperationException("Already initialized WebRTC.");
 
             NativeMethods.RegisterDebugLog(DebugLog, enableNativeLog, nativeLoggingSeverity);
-            NativeMethods.StatsCollectorRegisterCallback(OnCollectStatsCallback);
+            NativeMethods.ContextRegisterOnEventsPending(OnEventsPending);
             NativeMethods.CreateSessionDescriptionObserverRegisterCallback(OnCreateSessionDescription);
             NativeMethods.SetLocalDescriptionObserverRegisterCallback(OnSetLocalDescription);
             NativeMethods.SetRemoteDescriptionObserverRegisterCallback(OnSetRemoteDescription);
@@ -760,12 +1045,50 @@ namespace Unity.WebRTC
 #if UNITY_IOS && !UNITY_EDITOR
             NativeMethods.RegisterRenderingWebRTCPlugin();
 #endif
-            s_context = Context.Create();
+            // Probing hardware codecs is slow, so the results are reused by later launches.
+            NativeMethods.SetCodecCapabilityCachePath(
+                System.IO.Path.Combine(Application.temporaryCachePath, "webrtc_codec_capabilities.txt"));
+            s_limitTextureSize = limitTextureSize;
+            s_contextCreation = Context.CreateAsync(0, s_threadOptions);
+            AudioSettings.OnAudioConfigurationChanged += ApplyAudioPlayoutFormat;
+        }
+
+        static Context EnsureContext()
+        {
+            if (s_contextCreation != null)
+            {
+                var operation = s_contextCreation;
+                s_contextCreation = null;
+                SetContext(Context.Create(0, operation), s_limitTextureSize);
+            }
+            return s_context;
+        }
+
+        static void SetContext(Context context, bool limitTextureSize)
+        {
+            s_context = context;
             s_context.limitTextureSize = limitTextureSize;
 
+            ApplyAudioPlayoutFormat(false);
+
             NativeMethods.SetCurrentContext(s_context.self);
         }
 
+        // The audio device pulls the mix of the received streams only to drive
+        // the audio track sinks, and the mix is discarded. The sinks receive
+        // each stream in the format of its decoder, such as 48 kHz for Opus,
+        // whatever the format of the device is. So the mix is pulled at the
+        // mixing rate, which avoids resampling it, and in the channel layout
+        // of the audio output.
+        static void ApplyAudioPlayoutFormat(bool deviceWasChanged)
+        {
+            if (s_context == null)
+                return;
+            const int mixingSampleRate = 48000;
+            int channels = AudioSettings.speakerMode == AudioSpeakerMode.Mono ? 1 : 2;
+            s_context.SetAudioPlayoutFormat(mixingSampleRate, channels);
+        }
+
         /// <summary>
         ///     Updates the texture data for all video tracks at the end of each frame.
         /// </summary>
@@ -848,8 +1171,8 @@ namespace Unity.WebRTC
         /// </summary>
         public static bool enableLimitTextureSize
         {
-            get { return s_context.limitTextureSize; }
-            set { s_context.limitTextureSize = value; }
+            get { return EnsureContext().limitTextureSize; }
+            set { EnsureContext().limitTextureSize = value; }
         }
 
         /// <summary>
@@ -874,6 +1197,53 @@ namespace Unity.WebRTC
             }
         }
 
+        /// <summary>
+        ///     Sets the time after which a stats report which is not accessed is released natively.
+        /// </summary>
+        /// <remarks>
+        ///     By default, reports are kept natively until <see cref="RTCStatsReport.Dispose"/> is called, so that
+        ///     reports which are never disposed accumulate in long sessions. Setting a time releases them instead.
+        ///     A report, its stats and their members must not be used, nor the report disposed, after the time has
+        ///     passed since it was received or its snapshot was taken, since reading a member does not extend it.
+        ///     Zero or a negative time keeps reports until they are disposed.
+        /// </remarks>
+        /// <param name="timeToLive">The time to keep reports which are not accessed.</param>
+        public static void SetStatsReportTimeToLive(TimeSpan timeToLive)
+        {
+            Context.SetStatsReportTimeToLive((long)timeToLive.TotalMilliseconds);
+        }
+
+        /// <summary>
+        ///     Keeps peer connections ready in the background, which new peer connections with an equal configuration use.
+        /// </summary>
+        /// <remarks>
+        ///     A pooled connection has its DTLS certificate generated, and gathers its ports and candidates ahead of time
+        ///     when <see cref="RTCConfiguration.iceCandidatePoolSize"/> is greater than zero, so that the first offer and
+        ///     the connection take less time. The pool is refilled in the background after a connection is taken.
+        ///     Pooled connections hold their ports until they are taken. A size of zero releases the pool.
+        /// </remarks>
+        /// <param name="configuration">The configuration of the pooled connections.</param>
+        /// <param name="size">The number of connections to keep ready.</param>
+        public static void SetPeerConnectionPool(ref RTCConfiguration configuration, int size)
+        {
+            if (size < 0)
+                throw new ArgumentOutOfRangeException(nameof(size), size, "The size must not be negative.");
+            var conf = configuration.Cast();
+            bool result = Context.SetPeerConnectionPool(ref conf, size);
+            conf.Dispose();
+            if (!result)
+                throw new ArgumentException("The configuration is invalid.", nameof(configuration));
+        }
+
+        /// <summary>
+        ///     Gets the number and the estimated memory of the stats reports kept natively.
+        /// </summary>
+        /// <returns>The usage of stats reports.</returns>
+        public static RTCStatsReportUsage GetStatsReportUsage()
+        {
+            return Context.GetStatsReportUsage();
+        }
+
         /// <summary>
         ///     Configures native logging settings for WebRTC.
         /// </summary>
@@ -910,8 +1280,48 @@ namespace Unity.WebRTC
             NativeMethods.SetGraphicsSyncTimeout(nSecTimeout);
         }
 
+        /// <summary>
+        /// Recreates the native context with the given thread configuration.
+        /// </summary>
+        /// <remarks>
+        ///     The threads are named "WebRTC Network", "WebRTC Worker" and "WebRTC Signaling" in the Profiler.
+        ///     The threads of additional factory shards have the index of the shard appended to the name.
+        ///     The configuration is kept when the context is recreated after a domain reload.
+        ///     Call this method before creating any WebRTC objects.
+        /// </remarks>
+        /// <param name="options">The configuration of the native threads.</param>
+        /// <exception cref="InvalidOperationException">WebRTC objects exist.</exception>
+        /// <example>
+        ///     <code lang="cs"><![CDATA[
+        ///         var options = new ContextThreadOptions { separateNetworkThread = true };
+        ///         options.network.priority = ThreadPriorityHint.High;
+        ///         WebRTC.ConfigureThreads(options);
+        ///     ]]></code>
+        /// </example>
+        public static void ConfigureThreads(ContextThreadOptions options)
+        {
+            if (EnsureContext() == null)
+                throw new InvalidOperationException("WebRTC is not initialized.");
+            foreach (var value in s_context.table.CopiedValues)
+            {
+                if (value != null)
+                    throw new InvalidOperationException("Configure threads before creating WebRTC objects.");
+            }
+
+            bool limitTextureSize = s_context.limitTextureSize;
+            s_threadOptions = options;
+            // The native context is destroyed and created again on a native
+            // thread, in this order, without blocking the main thread.
+            s_context.DisposeAsync();
+            s_context = null;
+            s_limitTextureSize = limitTextureSize;
+            s_contextCreation = Context.CreateAsync(0, s_threadOptions);
+        }
+
         internal static void DisposeInternal()
         {
+            AudioSettings.OnAudioConfigurationChanged -= ApplyAudioPlayoutFormat;
+            EnsureContext();
             if (s_context != null)
             {
                 s_context.Dispose();
@@ -922,7 +1332,7 @@ namespace Unity.WebRTC
 
         internal static RTCError ValidateTextureSize(int width, int height, RuntimePlatform platform)
         {
-            if (!s_context.limitTextureSize)
+            if (!EnsureContext().limitTextureSize)
             {
                 return new RTCError { errorType = RTCErrorType.None };
             }
@@ -1162,7 +1572,7 @@ namespace Unity.WebRTC
         static void SendOrPostCallback(object state)
         {
             var obj = state as CallbackObject;
-            if (s_context == null || !Table.ContainsKey(obj.ptr))
+            if (Context == null || !Table.ContainsKey(obj.ptr))
             {
                 return;
             }
@@ -1310,23 +1720,111 @@ namespace Unity.WebRTC
             });
         }
 
+        [AOT.MonoPInvokeCallback(typeof(DelegateNativeEventsPending))]
+        static void OnEventsPending(IntPtr context)
+        {
+            // Called on a native thread for the first event after each drain,
+            // so that all the events queued until the next frame are dispatched at once.
+            s_syncContext.Post(DispatchEvents, context);
+        }
 
-        [AOT.MonoPInvokeCallback(typeof(DelegateCollectStats))]
-        static void OnCollectStatsCallback(IntPtr ptr, IntPtr ptrCallback, IntPtr ptrReport)
+        static unsafe void DispatchEvents(object state)
         {
-            Sync(ptr, () =>
+            var context = s_context;
+            if (context == null || context.self != (IntPtr)state)
+                return;
+
+            // A callback which executes the pending tasks must not drain the records in use.
+            if (s_dispatchingEvents)
             {
-                RTCStatsReport report = WebRTC.FindOrCreate(ptrReport, ptr_ => new RTCStatsReport(ptr_));
-                if (Table[ptr] is RTCPeerConnection connection)
+                s_syncContext.Post(DispatchEvents, state);
+                return;
+            }
+            s_dispatchingEvents = true;
+            try
+            {
+                int count = context.DrainEvents(out IntPtr ptr);
+                var records = (NativeEventRecord*)ptr;
+                for (int i = 0; i < count; i++)
                 {
-                    RTCStatsCollectorCallback callback = connection.FindCollectStatsCallback(ptrCallback);
-                    if (callback == null)
-                        return;
-                    connection.RemoveCollectStatsCallback(callback);
-                    callback.Invoke(report);
-                    callback.Dispose();
+                    if (s_context != context)
+                        break;
+                    if (!context.table.ContainsKey(records[i].sender))
+                        continue;
+                    DispatchEvent(ref records[i]);
                 }
-            });
+            }
+            finally
+            {
+                s_dispatchingEvents = false;
+            }
+        }
+
+        static void DispatchEvent(ref NativeEventRecord record)
+        {
+            switch (record.type)
+            {
+                case NativeEventType.IceCandidate:
+                    RTCPeerConnection.PCOnIceCandidate(record.sender,
+                        Marshal.PtrToStringAnsi(record.data), Marshal.PtrToStringAnsi(record.text), record.value);
+                    break;
+                case NativeEventType.IceConnectionChange:
+                    RTCPeerConnection.PCOnIceConnectionChange(record.sender, (RTCIceConnectionState)record.value);
+                    break;
+                case NativeEventType.ConnectionStateChange:
+                    RTCPeerConnection.PCOnConnectionStateChange(record.sender, (RTCPeerConnectionState)record.value);
+                    break;
+                case NativeEventType.IceGatheringChange:
+                    RTCPeerConnection.PCOnIceGatheringChange(record.sender, (RTCIceGatheringState)record.value);
+                    break;
+                case NativeEventType.NegotiationNeeded:
+                    RTCPeerConnection.PCOnNegotiationNeeded(record.sender);
+                    break;
+                case NativeEventType.DataChannel:
+                    RTCPeerConnection.PCOnDataChannel(record.sender, record.obj);
+                    break;
+                case NativeEventType.Track:
+                    RTCPeerConnection.PCOnTrack(record.sender, record.obj);
+                    break;
+                case NativeEventType.RemoveTrack:
+                    RTCPeerConnection.PCOnRemoveTrack(record.sender, record.obj);
+                    break;
+                case NativeEventType.StatsDelivered:
+                    OnStatsDelivered(record.sender, record.obj, record.obj2);
+                    break;
+                case NativeEventType.DataChannelOpen:
+                    RTCDataChannel.DataChannelNativeOnOpen(record.sender);
+                    break;
+                case NativeEventType.DataChannelClose:
+                    RTCDataChannel.DataChannelNativeOnClose(record.sender);
+                    break;
+                case NativeEventType.DataChannelError:
+                    RTCDataChannel.DataChannelNativeOnError(record.sender,
+                        (RTCErrorType)record.value, Marshal.PtrToStringAnsi(record.data));
+                    break;
+                case NativeEventType.DataChannelMessage:
+                    byte[] message = new byte[record.length];
+                    Marshal.Copy(record.data, message, 0, record.length);
+                    RTCDataChannel.DataChannelNativeOnMessage(record.sender, message);
+                    break;
+                case NativeEventType.DataChannelBufferedAmountLow:
+                    RTCDataChannel.DataChannelNativeOnBufferedAmountLow(record.sender);
+                    break;
+            }
+        }
+
+        static void OnStatsDelivered(IntPtr ptr, IntPtr ptrCallback, IntPtr ptrReport)
+        {
+            RTCStatsReport report = WebRTC.FindOrCreate(ptrReport, ptr_ => new RTCStatsReport(ptr_));
+            if (Table[ptr] is RTCPeerConnection connection)
+            {
+                RTCStatsCollectorCallback callback = connection.FindCollectStatsCallback(ptrCallback);
+                if (callback == null)
+                    return;
+                connection.RemoveCollectStatsCallback(callback);
+                callback.Invoke(report);
+                callback.Dispose();
+            }
         }
 
         [AOT.MonoPInvokeCallback(typeof(DelegateTransformedFrame))]
@@ -1348,8 +1846,8 @@ namespace Unity.WebRTC
         }
 
 
-        internal static Context Context { get { return s_context; } }
-        internal static WeakReferenceTable Table { get { return s_context?.table; } }
+        internal static Context Context { get { return EnsureContext(); } }
+        internal static WeakReferenceTable Table { get { return EnsureContext()?.table; } }
 
         internal static IReadOnlyList<WeakReference<RTCPeerConnection>> PeerList
         {
@@ -1374,9 +1872,11 @@ namespace Unity.WebRTC
     }
 
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateDebugLog([MarshalAs(UnmanagedType.LPStr)] string str, NativeLoggingSeverity severity);
+    internal delegate void DelegateNativeContextAsyncCompleted(IntPtr operation, ContextAsyncState state);
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void DelegateNativeEventsPending(IntPtr context);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateCollectStats(IntPtr ptr, IntPtr ptrCallback, IntPtr reportPtr);
+    internal delegate void DelegateDebugLog([MarshalAs(UnmanagedType.LPStr)] string str, NativeLoggingSeverity severity);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateCreateGetStats(IntPtr ptr, RTCSdpType type, [MarshalAs(UnmanagedType.LPStr)] string sdp);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
@@ -1386,31 +1886,6 @@ namespace Unity.WebRTC
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateSetRemoteDescription(IntPtr ptr, IntPtr ptrObserver, RTCErrorType type, [MarshalAs(UnmanagedType.LPStr)] string message);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnIceConnectionChange(IntPtr ptr, RTCIceConnectionState state);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnConnectionStateChange(IntPtr ptr, RTCPeerConnectionState state);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnIceGatheringChange(IntPtr ptr, RTCIceGatheringState state);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnIceCandidate(IntPtr ptr, [MarshalAs(UnmanagedType.LPStr)] string candidate, [MarshalAs(UnmanagedType.LPStr)] string sdpMid, int sdpMlineIndex);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    //according to JS API naming, use OnNegotiationNeeded instead of OnRenegotiationNeeded
-    internal delegate void DelegateNativeOnNegotiationNeeded(IntPtr ptr);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnTrack(IntPtr ptr, IntPtr transceiver);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnRemoveTrack(IntPtr ptr, IntPtr receiver);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnDataChannel(IntPtr ptr, IntPtr ptrChannel);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnMessage(IntPtr ptr, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)] byte[] bytes, int size);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnOpen(IntPtr ptr);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnClose(IntPtr ptr);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    internal delegate void DelegateNativeOnError(IntPtr ptr, RTCErrorType errorType, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3)] byte[] message, int size);
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateNativeMediaStreamOnAddTrack(IntPtr stream, IntPtr track);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateNativeMediaStreamOnRemoveTrack(IntPtr stream, IntPtr track);
@@ -1431,14 +1906,35 @@ namespace Unity.WebRTC
         public static extern void RegisterDebugLog(DelegateDebugLog func, [MarshalAs(UnmanagedType.U1)] bool enableNativeLog,
             NativeLoggingSeverity nativeLoggingSeverity);
         [DllImport(WebRTC.Lib)]
+        public static extern void SetCodecCapabilityCachePath(string path);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreate(int uid);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextCreateWithThreadOptions(int uid, ref ContextThreadOptions options);
+        [DllImport(WebRTC.Lib)]
         public static extern void ContextDestroy(int uid);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextCreateAsync(int uid, ref ContextThreadOptions options, DelegateNativeContextAsyncCompleted callback);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextDestroyAsync(int uid, DelegateNativeContextAsyncCompleted callback);
+        [DllImport(WebRTC.Lib)]
+        public static extern ContextAsyncState ContextAsyncOperationGetState(IntPtr operation, out IntPtr context);
+        [DllImport(WebRTC.Lib)]
+        public static extern void ContextAsyncOperationRelease(IntPtr operation);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreatePeerConnection(IntPtr ptr);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreatePeerConnectionWithConfig(IntPtr ptr, string conf);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextCreatePeerConnectionWithRTCConfiguration(IntPtr ptr, ref RTCConfigurationInternal configuration);
+        [DllImport(WebRTC.Lib)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool ContextSetPeerConnectionPool(IntPtr ptr, ref RTCConfigurationInternal configuration, int size);
+        [DllImport(WebRTC.Lib)]
+        public static extern int ContextGetPooledPeerConnectionCount(IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
+        public static extern ulong ContextGetPooledPeerConnectionClaimCount(IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
         public static extern void ContextDeletePeerConnection(IntPtr ptr, IntPtr ptrPeerConnection);
         [DllImport(WebRTC.Lib)]
         public static extern void PeerConnectionClose(IntPtr ptr);
@@ -1451,6 +1947,10 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void ContextDeleteDataChannel(IntPtr ptr, IntPtr ptrChannel);
         [DllImport(WebRTC.Lib)]
+        public static extern void ContextRegisterOnEventsPending(DelegateNativeEventsPending callback);
+        [DllImport(WebRTC.Lib)]
+        public static extern int ContextDrainEvents(IntPtr context, out IntPtr records);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateAudioTrackSource(IntPtr ptr);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateVideoTrackSource(IntPtr ptr);
@@ -1463,22 +1963,38 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextGetStatsList(IntPtr context, IntPtr report, out ulong length, ref IntPtr types);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextGetStatsSnapshot(IntPtr context, IntPtr report, out ulong length);
+        [DllImport(WebRTC.Lib)]
+        public static extern void ContextSetStatsReportTimeToLive(IntPtr context, long timeToLiveMs);
+        [DllImport(WebRTC.Lib)]
+        public static extern void ContextGetStatsReportUsage(IntPtr context, out RTCStatsReportUsage usage);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextCreateStatsSubscription(IntPtr context, uint[] types, int typeCount, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] string[] members, int memberCount);
+        [DllImport(WebRTC.Lib)]
+        public static extern void PeerConnectionRequestStatsSubscription(IntPtr ptr, IntPtr subscription);
+        [DllImport(WebRTC.Lib)]
+        public static extern int StatsSubscriptionPoll(IntPtr subscription, out IntPtr deltas, out IntPtr removedKeys, out int removedCount);
+        [DllImport(WebRTC.Lib)]
         public static extern void ContextDeleteStatsReport(IntPtr context, IntPtr report);
         [DllImport(WebRTC.Lib)]
         public static extern void ContextAddRefPtr(IntPtr context, IntPtr ptr);
         [DllImport(WebRTC.Lib)]
         public static extern void ContextDeleteRefPtr(IntPtr context, IntPtr ptr);
         [DllImport(WebRTC.Lib)]
+        public static extern ulong ContextGetRefPtrHandle(IntPtr context, IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateFrameTransformer(IntPtr context);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr PeerConnectionGetConfiguration(IntPtr ptr);
         [DllImport(WebRTC.Lib)]
+        public static extern RTCErrorType PeerConnectionSetRTCConfiguration(IntPtr ptr, ref RTCConfigurationInternal configuration);
+        [DllImport(WebRTC.Lib)]
+        public static extern void ContextPeerConnectionGetRTCConfiguration(IntPtr context, IntPtr ptr, out RTCConfigurationInternal configuration);
+        [DllImport(WebRTC.Lib)]
         public static extern CreateSessionDescriptionObserver PeerConnectionCreateOffer(IntPtr context, IntPtr ptr, ref RTCOfferAnswerOptions options);
         [DllImport(WebRTC.Lib)]
         public static extern CreateSessionDescriptionObserver PeerConnectionCreateAnswer(IntPtr context, IntPtr ptr, ref RTCOfferAnswerOptions options);
         [DllImport(WebRTC.Lib)]
-        public static extern void StatsCollectorRegisterCallback(DelegateCollectStats onCollectStats);
-        [DllImport(WebRTC.Lib)]
         public static extern void CreateSessionDescriptionObserverRegisterCallback(DelegateNativeCreateSessionDesc callback);
         [DllImport(WebRTC.Lib)]
         public static extern void SetLocalDescriptionObserverRegisterCallback(DelegateSetLocalDescription callback);
@@ -1487,14 +2003,6 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void SetTransformedFrameRegisterCallback(DelegateTransformedFrame callback);
         [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterIceConnectionChange(IntPtr ptr, DelegateNativeOnIceConnectionChange callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterConnectionStateChange(IntPtr ptr, DelegateNativeOnConnectionStateChange callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterIceGatheringChange(IntPtr ptr, DelegateNativeOnIceGatheringChange callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterOnIceCandidate(IntPtr ptr, DelegateNativeOnIceCandidate callback);
-        [DllImport(WebRTC.Lib)]
         public static extern SetSessionDescriptionObserver PeerConnectionSetLocalDescription(IntPtr ptr, ref RTCSessionDescription desc, out RTCErrorType errorType, ref IntPtr error);
         [DllImport(WebRTC.Lib)]
         public static extern SetSessionDescriptionObserver PeerConnectionSetLocalDescriptionWithoutDescription(IntPtr ptr, out RTCErrorType errorType, ref IntPtr error);
@@ -1515,22 +2023,7 @@ namespace Unity.WebRTC
         public static extern bool PeerConnectionCanTrickleIceCandidates(IntPtr ptr, [MarshalAs(UnmanagedType.U1)] out bool value);
         [DllImport(WebRTC.Lib)]
         [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetLocalDescription(IntPtr ptr, ref RTCSessionDescription desc);
-        [DllImport(WebRTC.Lib)]
-        [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetRemoteDescription(IntPtr ptr, ref RTCSessionDescription desc);
-        [DllImport(WebRTC.Lib)]
-        [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetPendingLocalDescription(IntPtr ptr, ref RTCSessionDescription desc);
-        [DllImport(WebRTC.Lib)]
-        [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetPendingRemoteDescription(IntPtr ptr, ref RTCSessionDescription desc);
-        [DllImport(WebRTC.Lib)]
-        [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetCurrentLocalDescription(IntPtr ptr, ref RTCSessionDescription desc);
-        [DllImport(WebRTC.Lib)]
-        [return: MarshalAs(UnmanagedType.U1)]
-        public static extern bool PeerConnectionGetCurrentRemoteDescription(IntPtr ptr, ref RTCSessionDescription desc);
+        public static extern bool PeerConnectionGetSessionDescription(IntPtr ptr, RTCSessionDescriptionSource source, ref ulong handle, ref RTCSessionDescription desc);
         [DllImport(WebRTC.Lib)]
         public static extern RTCErrorType PeerConnectionAddTrack(IntPtr pc, IntPtr track, [MarshalAs(UnmanagedType.LPStr, SizeConst = 256)] string streamId, out IntPtr sender);
         [DllImport(WebRTC.Lib)]
@@ -1575,20 +2068,12 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern RTCIceGatheringState PeerConnectionIceGatheringState(IntPtr ptr);
         [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterOnDataChannel(IntPtr ptr, DelegateNativeOnDataChannel callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterOnRenegotiationNeeded(IntPtr ptr, DelegateNativeOnNegotiationNeeded callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterOnTrack(IntPtr ptr, DelegateNativeOnTrack callback);
-        [DllImport(WebRTC.Lib)]
-        public static extern void PeerConnectionRegisterOnRemoveTrack(IntPtr ptr, DelegateNativeOnRemoveTrack callback);
-        [DllImport(WebRTC.Lib)]
         [return: MarshalAs(UnmanagedType.U1)]
         public static extern bool TransceiverGetCurrentDirection(IntPtr transceiver, out RTCRtpTransceiverDirection direction);
         [DllImport(WebRTC.Lib)]
         public static extern RTCErrorType TransceiverStop(IntPtr transceiver);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr TransceiverGetMid(IntPtr transceiver);
+        public static extern IntPtr ContextTransceiverGetMid(IntPtr context, IntPtr transceiver);
         [DllImport(WebRTC.Lib)]
         public static extern RTCRtpTransceiverDirection TransceiverGetDirection(IntPtr transceiver);
         [DllImport(WebRTC.Lib)]
@@ -1606,6 +2091,9 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void SenderGetParameters(IntPtr sender, out IntPtr parameters);
         [DllImport(WebRTC.Lib)]
+        public static extern RTCErrorType ContextRtpSenderSetOpusEncoderSettings(
+            IntPtr context, IntPtr peer, IntPtr sender, IntPtr source, ref RTCOpusEncoderSettingsInternal settings);
+        [DllImport(WebRTC.Lib)]
         public static extern RTCErrorType SenderSetParameters(IntPtr sender, IntPtr parameters);
         [DllImport(WebRTC.Lib)]
         [return: MarshalAs(UnmanagedType.U1)]
@@ -1647,13 +2135,35 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void DataChannelClose(IntPtr ptr);
         [DllImport(WebRTC.Lib)]
-        public static extern void DataChannelRegisterOnMessage(IntPtr ctx, IntPtr ptr, DelegateNativeOnMessage callback);
+        public static extern int DataChannelSendBatch(IntPtr context, IntPtr ptr, byte[] data, RTCDataChannelMessageIndex[] index, int count);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSetChunking(IntPtr context, IntPtr ptr, [MarshalAs(UnmanagedType.U1)] bool enabled, int chunkSize);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSetBatchedReceive(IntPtr context, IntPtr ptr, [MarshalAs(UnmanagedType.U1)] bool enabled);
+        [DllImport(WebRTC.Lib)]
+        public static extern int DataChannelReceiveBatch(IntPtr context, IntPtr ptr, out IntPtr data, out IntPtr index);
         [DllImport(WebRTC.Lib)]
-        public static extern void DataChannelRegisterOnOpen(IntPtr ctx, IntPtr ptr, DelegateNativeOnOpen callback);
+        public static extern void DataChannelSetReceiveQueueCapacity(IntPtr context, IntPtr ptr, ulong capacity);
         [DllImport(WebRTC.Lib)]
-        public static extern void DataChannelRegisterOnClose(IntPtr ctx, IntPtr ptr, DelegateNativeOnClose callback);
+        public static extern ulong DataChannelGetReceiveQueueDroppedCount(IntPtr context, IntPtr ptr);
         [DllImport(WebRTC.Lib)]
-        public static extern void DataChannelRegisterOnError(IntPtr ctx, IntPtr ptr, DelegateNativeOnError callback);
+        public static extern IntPtr DataChannelLeaseSendBuffer(IntPtr context, IntPtr ptr, int capacity, out IntPtr lease);
+        [DllImport(WebRTC.Lib)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool DataChannelCommitSendBuffer(IntPtr context, IntPtr ptr, IntPtr lease, int length);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelCancelSendBuffer(IntPtr context, IntPtr ptr, IntPtr lease);
+        [DllImport(WebRTC.Lib)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool DataChannelSendWithFlowControl(IntPtr ctx, IntPtr ptr, IntPtr data, int length, [MarshalAs(UnmanagedType.U1)] bool binary);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSetBufferedAmountLowThreshold(IntPtr ctx, IntPtr ptr, ulong threshold);
+        [DllImport(WebRTC.Lib)]
+        public static extern ulong DataChannelGetBufferedAmountLowThreshold(IntPtr ctx, IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSetSendQueueLimit(IntPtr ctx, IntPtr ptr, ulong limit);
+        [DllImport(WebRTC.Lib)]
+        public static extern ulong DataChannelGetQueuedAmount(IntPtr ctx, IntPtr ptr);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateMediaStream(IntPtr ctx, [MarshalAs(UnmanagedType.LPStr, SizeConst = 256)] string label);
         [DllImport(WebRTC.Lib)]
@@ -1663,6 +2173,8 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateAudioTrackSink(IntPtr context);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextCreateAudioTrackSinkWithOptions(IntPtr context, ref AudioTrackSinkOptions options);
+        [DllImport(WebRTC.Lib)]
         public static extern void ContextDeleteAudioTrackSink(IntPtr context, IntPtr sink);
         [DllImport(WebRTC.Lib)]
         public static extern void AudioTrackAddSink(IntPtr track, IntPtr sink);
@@ -1672,6 +2184,20 @@ namespace Unity.WebRTC
         public static extern void AudioTrackSinkProcessAudio(
             IntPtr sink, float[] data, int length, int channels, int sampleRate);
         [DllImport(WebRTC.Lib)]
+        public static extern void AudioTrackSinkGetResampleStats(
+            IntPtr sink, out ulong bypassedSamples, out ulong resampledSamples);
+        [DllImport(WebRTC.Lib)]
+        public static extern void AudioTrackSinkGetDebugCounters(IntPtr sink, out AudioTrackSinkCounters counters);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr AudioTrackSinkGetLevelMeter(IntPtr sink);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr AudioSourceGetLevelMeter(IntPtr source);
+        [DllImport(WebRTC.Lib)]
+        public static extern void AudioLevelMeterGetLevels(
+            IntPtr[] meters, int length, [In, Out] AudioLevel[] levels);
+        [DllImport(WebRTC.Lib)]
+        public static extern void ContextSetAudioPlayoutFormat(IntPtr context, int sampleRate, int channels);
+        [DllImport(WebRTC.Lib)]
         [return: MarshalAs(UnmanagedType.U1)]
         public static extern bool MediaStreamAddTrack(IntPtr stream, IntPtr track);
         [DllImport(WebRTC.Lib)]
@@ -1692,7 +2218,7 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern TrackState MediaStreamTrackGetReadyState(IntPtr track);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr MediaStreamTrackGetID(IntPtr track);
+        public static extern IntPtr ContextMediaStreamTrackGetID(IntPtr context, IntPtr track);
         [DllImport(WebRTC.Lib)]
         [return: MarshalAs(UnmanagedType.U1)]
         public static extern bool MediaStreamTrackGetEnabled(IntPtr track);
@@ -1716,6 +2242,8 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern int GetBatchUpdateEventID();
         [DllImport(WebRTC.Lib)]
+        public static extern ulong ContextGetSkippedRenderEventCount(IntPtr context);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr GetUpdateTextureFunc(IntPtr context);
         [DllImport(WebRTC.Lib)]
         public static extern void AudioSourceProcessLocalAudio(IntPtr source, IntPtr array, int sampleRate, int channels, int frames);
@@ -1727,7 +2255,7 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsGetJson(IntPtr stats);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsGetId(IntPtr stats);
+        public static extern IntPtr ContextStatsGetId(IntPtr context, IntPtr stats);
         [DllImport(WebRTC.Lib)]
         public static extern RTCStatsType StatsGetType(IntPtr stats);
         [DllImport(WebRTC.Lib)]
@@ -1735,7 +2263,7 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsGetMembers(IntPtr stats, out ulong length);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsMemberGetName(IntPtr member);
+        public static extern IntPtr ContextStatsMemberGetName(IntPtr context, IntPtr member);
         [DllImport(WebRTC.Lib)]
         public static extern StatsMemberType StatsMemberGetType(IntPtr member);
         [DllImport(WebRTC.Lib)]
@@ -1755,7 +2283,7 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern double StatsMemberGetDouble(IntPtr member);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsMemberGetString(IntPtr member);
+        public static extern IntPtr ContextStatsMemberGetString(IntPtr context, IntPtr member);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsMemberGetBoolArray(IntPtr member, out ulong length);
         [DllImport(WebRTC.Lib)]
@@ -1769,11 +2297,11 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsMemberGetDoubleArray(IntPtr member, out ulong length);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsMemberGetStringArray(IntPtr member, out ulong length);
+        public static extern IntPtr ContextStatsMemberGetStringArray(IntPtr context, IntPtr member, out ulong length);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsMemberGetMapStringUint64(IntPtr member, out IntPtr values, out ulong length);
+        public static extern IntPtr ContextStatsMemberGetMapStringUint64(IntPtr context, IntPtr member, out IntPtr values, out ulong length);
         [DllImport(WebRTC.Lib)]
-        public static extern IntPtr StatsMemberGetMapStringDouble(IntPtr member, out IntPtr values, out ulong length);
+        public static extern IntPtr ContextStatsMemberGetMapStringDouble(IntPtr context, IntPtr member, out IntPtr values, out ulong length);
         [DllImport(WebRTC.Lib)]
         public static extern uint FrameGetTimestamp(IntPtr frame);
         [DllImport(WebRTC.Lib)]
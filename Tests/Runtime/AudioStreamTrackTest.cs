@@ -244,5 +244,28 @@ namespace Unity.WebRTC.RuntimeTest
             renderer.Dispose();
             UnityEngine.Object.DestroyImmediate(obj);
         }
+
+        [Test]
+        public void AudioStreamRendererResampleInBackground()
+        {
+            Assert.That(() => AudioStreamTrack.ResampleBatchFrames = 0, Throws.TypeOf<ArgumentOutOfRangeException>());
+
+            AudioStreamTrack.ResampleInBackground = true;
+            AudioStreamTrack.ResampleBatchFrames = 4;
+            try
+            {
+                var renderer = new AudioStreamTrack.AudioStreamRenderer(null);
+                var data = new float[480 * 2];
+                renderer.SetData(data, 2, 48000);
+                NativeMethods.AudioTrackSinkGetDebugCounters(renderer.self, out var counters);
+                Assert.That(counters.pooledFrames, Is.GreaterThan(0));
+                renderer.Dispose();
+            }
+            finally
+            {
+                AudioStreamTrack.ResampleInBackground = false;
+                AudioStreamTrack.ResampleBatchFrames = 1;
+            }
+        }
     }
 }
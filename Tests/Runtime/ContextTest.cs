@@ -57,6 +57,21 @@ namespace Unity.WebRTC.RuntimeTest
             UnityEngine.TestTools.LogAssert.ignoreFailingMessages = false;
         }
 
+        [Test]
+        public void CreateFromFailedOperationThrowsException()
+        {
+            UnityEngine.TestTools.LogAssert.ignoreFailingMessages = true;
+
+            // WebRTC.Context has already been created with the ID 0.
+            Assert.That(WebRTC.Context, Is.Not.Null);
+            var operation = Context.CreateAsync(0, new ContextThreadOptions());
+            Assert.That(() => Context.Create(0, operation), Throws.InvalidOperationException);
+            Assert.That(operation.IsError, Is.True);
+            Assert.That(operation.Error.errorType, Is.EqualTo(RTCErrorType.InternalError));
+
+            UnityEngine.TestTools.LogAssert.ignoreFailingMessages = false;
+        }
+
         [Test]
         public void CreateAndDeletePeerConnection()
         {
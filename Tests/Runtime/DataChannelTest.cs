@@ -1,5 +1,6 @@
 using System;
 using System.Collections;
+using System.Collections.Generic;
 using System.Diagnostics;
 using NUnit.Framework;
 using Unity.Collections;
@@ -343,6 +344,44 @@ namespace Unity.WebRTC.RuntimeTest
             Object.DestroyImmediate(test.gameObject);
         }
 
+        [UnityTest]
+        [Timeout(5000)]
+        [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
+        public IEnumerator SendBatchWithChunking()
+        {
+            var test = new MonoBehaviourTest<SignalingPeers>();
+
+            RTCDataChannel channel1 = test.component.CreateDataChannel(0, "test");
+            Assert.That(channel1, Is.Not.Null);
+            yield return test;
+
+            var op1 = new WaitUntilWithTimeout(() => test.component.GetDataChannelList(1).Count > 0, 5000);
+            yield return op1;
+            RTCDataChannel channel2 = test.component.GetDataChannelList(1)[0];
+            Assert.That(channel2, Is.Not.Null);
+
+            // The batch is chunked natively like the other sends.
+            channel1.ChunkSize = 1024;
+            channel2.ChunkSize = 1024;
+            var received = new List<byte[]>();
+            channel2.OnMessage = bytes => { received.Add(bytes); };
+
+            byte[] large = new byte[4096];
+            for (int i = 0; i < large.Length; i++)
+                large[i] = (byte)i;
+            byte[] small = { 1, 2, 3 };
+            Assert.That(channel1.SendBatch(new[] { large, small }), Is.EqualTo(2));
+
+            var op2 = new WaitUntilWithTimeout(() => received.Count == 2, 5000);
+            yield return op2;
+            Assert.That(op2.IsCompleted, Is.True);
+            Assert.That(received, Has.Member(large));
+            Assert.That(received, Has.Member(small));
+
+            test.component.Dispose();
+            Object.DestroyImmediate(test.gameObject);
+        }
+
         static void ExecutePendingTasksWithTimeout(ref string message, int timeoutInMilliseconds)
         {
             Stopwatch watchdog = Stopwatch.StartNew();
@@ -50,6 +50,8 @@ namespace Unity.WebRTC.RuntimeTest
             var track = new AudioStreamTrack(WebRTC.Context.CreateAudioTrack(guid, source.self));
             Assert.That(track, Is.Not.Null);
             Assert.That(track.Id, Is.EqualTo(guid));
+            // The ID is read from the native track only once.
+            Assert.That(track.Id, Is.SameAs(track.Id));
             track.Dispose();
             source.Dispose();
         }
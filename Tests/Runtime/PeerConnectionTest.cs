@@ -105,6 +105,80 @@ namespace Unity.WebRTC.RuntimeTest
             peer.Dispose();
         }
 
+        [Test]
+        public void GetConfigurationWithNetworkSettings()
+        {
+            var config = GetDefaultConfiguration();
+            config.rtcpMuxPolicy = RTCRtcpMuxPolicy.Require;
+            config.minPort = 50000;
+            config.maxPort = 50100;
+            config.candidateNetworkPolicy = RTCCandidateNetworkPolicy.LowCost;
+            config.tcpCandidatePolicy = RTCTcpCandidatePolicy.Disabled;
+            config.disableLinkLocalNetworks = true;
+            var peer = new RTCPeerConnection(ref config);
+
+            var config2 = peer.GetConfiguration();
+            Assert.That(config2.rtcpMuxPolicy, Is.EqualTo(config.rtcpMuxPolicy));
+            Assert.That(config2.minPort, Is.EqualTo(config.minPort));
+            Assert.That(config2.maxPort, Is.EqualTo(config.maxPort));
+            Assert.That(config2.candidateNetworkPolicy, Is.EqualTo(config.candidateNetworkPolicy));
+            Assert.That(config2.tcpCandidatePolicy, Is.EqualTo(config.tcpCandidatePolicy));
+            Assert.That(config2.disableLinkLocalNetworks, Is.EqualTo(config.disableLinkLocalNetworks));
+
+            // Values which are not set keep the current ones.
+            var config3 = new RTCConfiguration { iceServers = config.iceServers };
+            Assert.That(peer.SetConfiguration(ref config3), Is.EqualTo(RTCErrorType.None));
+            Assert.That(peer.GetConfiguration().maxPort, Is.EqualTo(config.maxPort));
+
+            peer.Close();
+            peer.Dispose();
+        }
+
+        [Test]
+        public void ConstructWithInvalidPortRangeThrowException()
+        {
+            var config = GetDefaultConfiguration();
+            config.minPort = 50100;
+            config.maxPort = 50000;
+            Assert.That(() => { new RTCPeerConnection(ref config); }, Throws.ArgumentException);
+        }
+
+        [UnityTest]
+        [Timeout(10000)]
+        public IEnumerator ConstructWithPeerConnectionPool()
+        {
+            var config = GetDefaultConfiguration();
+            config.iceCandidatePoolSize = 1;
+            WebRTC.SetPeerConnectionPool(ref config, 2);
+            var op = new WaitUntilWithTimeout(() => WebRTC.Context.GetPooledPeerConnectionCount() == 2, 5000);
+            yield return op;
+            Assert.That(op.IsCompleted, Is.True);
+
+            // Only connections taken from the pool count as claimed.
+            ulong claimed = WebRTC.Context.GetPooledPeerConnectionClaimCount();
+            var peer1 = new RTCPeerConnection(ref config);
+            var peer2 = new RTCPeerConnection(ref config);
+            Assert.That(WebRTC.Context.GetPooledPeerConnectionClaimCount(), Is.EqualTo(claimed + 2));
+            Assert.That(peer1.GetConfiguration().iceCandidatePoolSize, Is.EqualTo(1));
+            Assert.That(peer2.GetConfiguration().iceCandidatePoolSize, Is.EqualTo(1));
+
+            // A different configuration creates a connection without the pool.
+            var other = GetDefaultConfiguration();
+            var peer3 = new RTCPeerConnection(ref other);
+            Assert.That(WebRTC.Context.GetPooledPeerConnectionClaimCount(), Is.EqualTo(claimed + 2));
+
+            WebRTC.SetPeerConnectionPool(ref config, 0);
+            Assert.That(WebRTC.Context.GetPooledPeerConnectionCount(), Is.EqualTo(0));
+            peer1.Close();
+            peer2.Close();
+            peer3.Close();
+            peer1.Dispose();
+            peer2.Dispose();
+            peer3.Dispose();
+
+            Assert.That(() => WebRTC.SetPeerConnectionPool(ref config, -1), Throws.TypeOf<ArgumentOutOfRangeException>());
+        }
+
         [Test]
         [ConditionalIgnore(ConditionalIgnore.UnsupportedPlatformOpenGL, "Not support VideoStreamTrack for OpenGL")]
         public void AddTrack()
@@ -1090,6 +1164,22 @@ namespace Unity.WebRTC.RuntimeTest
                 Assert.That(op.IsDone, Is.True);
                 Assert.That(op.Value, Is.Not.Null);
                 Assert.That(op.Value.Stats, Is.Not.Null);
+
+                var snapshot = op.Value.GetSnapshot();
+                for (int i = 0; i < snapshot.Count; i++)
+                {
+                    var entry = snapshot[i];
+                    if (!op.Value.TryGetValue(entry.Id, out var stats))
+                        continue;
+                    Assert.That(entry.Type, Is.EqualTo(stats.Type));
+                    Assert.That(entry.Timestamp, Is.EqualTo(stats.Timestamp));
+                    Assert.That(entry.MemberCount, Is.EqualTo(stats.Dict.Count));
+                    for (int j = 0; j < entry.MemberCount; j++)
+                    {
+                        var member = entry.GetMember(j);
+                        Assert.That(member.GetValue(), Is.EqualTo(stats.Dict[member.Name]));
+                    }
+                }
                 op.Value.Dispose();
             }
             test.component.Dispose();